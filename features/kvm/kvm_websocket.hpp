@@ -1,9 +1,13 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #pragma once
+#include "bmcweb_config.h"
+
 #include "app.hpp"
 #include "io_context_singleton.hpp"
 #include "logging.hpp"
+#include "relay_buffer.hpp"
+#include "rfb_stream.hpp"
 #include "websocket.hpp"
 
 #include <sys/types.h>
@@ -15,9 +19,18 @@
 #include <boost/beast/core/flat_static_buffer.hpp>
 #include <boost/container/flat_map.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace crow
 {
@@ -26,14 +39,41 @@ namespace obmc_kvm
 
 static constexpr const uint maxSessions = 4;
 
+static constexpr const uint16_t kvmPort = 5900;
+
+// Data from the VNC server is read into one of two buffers of this size and
+// written to the websocket from there.  Once both buffers fill up, reads from
+// the VNC server are paused until the viewer catches up, so a slow viewer
+// backs up the VNC server instead of bmcweb memory.
+static constexpr const size_t kvmRelayBufferSize = 1024UL * 50UL;
+
+// How far a read only viewer of a shared session can fall behind before its
+// backlog is dropped
+static constexpr const size_t kvmViewerMaxQueued = 1024UL * 1024UL * 4UL;
+
+// Most input from a viewer that can wait to be written to the VNC server.  A
+// viewer that sends more than this is disconnected.
+static constexpr const size_t kvmHostMaxQueued = 1024UL;
+
+struct KvmRelayStats
+{
+    // Bytes read from the VNC server and written to the websocket
+    uint64_t bytesRelayed = 0;
+    // Websocket messages sent
+    uint64_t messagesSent = 0;
+    // Times reads from the VNC server were paused waiting on the viewer
+    uint64_t readsPaused = 0;
+    // Most bytes that were waiting to be written to the websocket
+    size_t maxQueuedBytes = 0;
+};
+
 class KvmSession : public std::enable_shared_from_this<KvmSession>
 {
   public:
-    explicit KvmSession(crow::websocket::Connection& connIn) :
+    KvmSession(crow::websocket::Connection& connIn,
+               const boost::asio::ip::tcp::endpoint& endpoint) :
         conn(connIn), hostSocket(getIoContext())
     {
-        boost::asio::ip::tcp::endpoint endpoint(
-            boost::asio::ip::make_address("127.0.0.1"), 5900);
         hostSocket.async_connect(
             // ast-grep-ignore: long-lambda
             endpoint, [this, &connIn](const boost::system::error_code& ec) {
@@ -53,6 +93,27 @@ class KvmSession : public std::enable_shared_from_this<KvmSession>
             });
     }
 
+    ~KvmSession()
+    {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - startTime;
+        BMCWEB_LOG_INFO(
+            "conn:{}, KVM relayed {} bytes in {} messages over {:.1f}s, "
+            "reads paused {} times, max queued {} bytes",
+            logPtr(&conn), stats.bytesRelayed, stats.messagesSent,
+            elapsed.count(), stats.readsPaused, stats.maxQueuedBytes);
+    }
+
+    KvmSession(const KvmSession&) = delete;
+    KvmSession(KvmSession&&) = delete;
+    KvmSession& operator=(const KvmSession&) = delete;
+    KvmSession& operator=(KvmSession&&) = delete;
+
+    const KvmRelayStats& getStats() const
+    {
+        return stats;
+    }
+
     void onMessage(const std::string& data)
     {
         if (data.length() > inputBuffer.capacity())
@@ -79,43 +140,109 @@ class KvmSession : public std::enable_shared_from_this<KvmSession>
   protected:
     void doRead()
     {
-        std::size_t bytes = outputBuffer.capacity() - outputBuffer.size();
+        if (doingRead)
+        {
+            return;
+        }
+        if (outputBuffers[fillIndex].size() == 0)
+        {
+            outputBuffers[fillIndex].reset();
+        }
+        if (outputBuffers[fillIndex].full())
+        {
+            // Only move on to the other buffer once all of it has been sent,
+            // so the data in it is always older
+            size_t other = 1 - fillIndex;
+            if (outputBuffers[other].size() != 0)
+            {
+                BMCWEB_LOG_DEBUG("conn:{}, Viewer is behind, pausing KVM reads",
+                                 logPtr(&conn));
+                stats.readsPaused++;
+                return;
+            }
+            outputBuffers[other].reset();
+            fillIndex = other;
+        }
+        size_t index = fillIndex;
+        boost::asio::mutable_buffer buffer = outputBuffers[index].prepare();
         BMCWEB_LOG_DEBUG("conn:{}, Reading {} from kvm socket", logPtr(&conn),
-                         bytes);
+                         buffer.size());
+        doingRead = true;
         hostSocket.async_read_some(
-            outputBuffer.prepare(outputBuffer.capacity() - outputBuffer.size()),
-            [this, weak(weak_from_this())](const boost::system::error_code& ec,
-                                           std::size_t bytesRead) {
-                auto self = weak.lock();
-                if (self == nullptr)
-                {
-                    return;
-                }
-                BMCWEB_LOG_DEBUG("conn:{}, read done.  Read {} bytes",
-                                 logPtr(&conn), bytesRead);
-                if (ec)
-                {
-                    BMCWEB_LOG_ERROR(
-                        "conn:{}, Couldn't read from KVM socket port: {}",
-                        logPtr(&conn), ec);
-                    if (ec != boost::asio::error::operation_aborted)
-                    {
-                        conn.close("Error in connecting to KVM port");
-                    }
-                    return;
-                }
+            buffer,
+            std::bind_front(&KvmSession::afterRead, this, weak_from_this(),
+                            index));
+    }
 
-                outputBuffer.commit(bytesRead);
-                std::string_view payload(
-                    static_cast<const char*>(outputBuffer.data().data()),
-                    bytesRead);
-                BMCWEB_LOG_DEBUG("conn:{}, Sending payload size {}",
-                                 logPtr(&conn), payload.size());
-                conn.sendBinary(payload);
-                outputBuffer.consume(bytesRead);
+    void afterRead(const std::weak_ptr<KvmSession>& weak, size_t index,
+                   const boost::system::error_code& ec, std::size_t bytesRead)
+    {
+        auto self = weak.lock();
+        if (self == nullptr)
+        {
+            return;
+        }
+        BMCWEB_LOG_DEBUG("conn:{}, read done.  Read {} bytes", logPtr(&conn),
+                         bytesRead);
+        doingRead = false;
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR("conn:{}, Couldn't read from KVM socket port: {}",
+                             logPtr(&conn), ec);
+            if (ec != boost::asio::error::operation_aborted)
+            {
+                conn.close("Error in connecting to KVM port");
+            }
+            return;
+        }
 
-                doRead();
-            });
+        outputBuffers[index].commit(bytesRead);
+        stats.maxQueuedBytes =
+            std::max(stats.maxQueuedBytes,
+                     outputBuffers[0].size() + outputBuffers[1].size());
+
+        doSend();
+        doRead();
+    }
+
+    void doSend()
+    {
+        if (doingSend)
+        {
+            return;
+        }
+        // Send the older data first.  The buffer being read into can be sent
+        // while the read is in flight, as the read only appends to it.
+        size_t index = 1 - fillIndex;
+        if (outputBuffers[index].size() == 0)
+        {
+            index = fillIndex;
+        }
+        std::string_view payload = outputBuffers[index].data();
+        if (payload.empty())
+        {
+            return;
+        }
+        BMCWEB_LOG_DEBUG("conn:{}, Sending payload size {}", logPtr(&conn),
+                         payload.size());
+        doingSend = true;
+        stats.messagesSent++;
+        stats.bytesRelayed += payload.size();
+        // The websocket writes straight from the buffer, so keep the session
+        // alive until it's done
+        conn.sendEx(crow::websocket::MessageType::Binary, payload,
+                    std::bind_front(&KvmSession::afterSend, this,
+                                    shared_from_this(), index, payload.size()));
+    }
+
+    void afterSend(const std::shared_ptr<KvmSession>& /*self*/, size_t index,
+                   size_t bytesSent)
+    {
+        doingSend = false;
+        outputBuffers[index].consume(bytesSent);
+        doSend();
+        // Resume reading if it was paused on a full buffer
+        doRead();
     }
 
     void doWrite()
@@ -170,9 +297,562 @@ class KvmSession : public std::enable_shared_from_this<KvmSession>
 
     crow::websocket::Connection& conn;
     boost::asio::ip::tcp::socket hostSocket;
-    boost::beast::flat_static_buffer<1024UL * 50UL> outputBuffer;
-    boost::beast::flat_static_buffer<1024UL> inputBuffer;
+    std::array<RelayBuffer<kvmRelayBufferSize>, 2> outputBuffers;
+    // Index of the output buffer that reads from the VNC server go into
+    size_t fillIndex = 0;
+    bool doingRead{false};
+    bool doingSend{false};
+    boost::beast::flat_static_buffer<kvmHostMaxQueued> inputBuffer;
     bool doingWrite{false};
+    KvmRelayStats stats;
+    std::chrono::steady_clock::time_point startTime =
+        std::chrono::steady_clock::now();
+};
+
+// Upstream VNC connection shared by every viewer of the host.  The first
+// viewer controls the host and drives the RFB session; the others are sent
+// the same framebuffer updates read only, joining at the next message from
+// the server and asking for a full screen update.  Reads from the VNC server
+// follow the controlling viewer, like KvmSession.  A read only viewer that
+// falls more than kvmViewerMaxQueued bytes behind has its backlog dropped at
+// a message boundary and rejoins like a new viewer once it has caught up, so
+// it can't stall the others.
+class KvmSharedHost : public std::enable_shared_from_this<KvmSharedHost>
+{
+  public:
+    KvmSharedHost() : hostSocket(getIoContext()) {}
+
+    ~KvmSharedHost()
+    {
+        BMCWEB_LOG_INFO(
+            "Shared KVM read {} bytes, sent {} messages, paused {} times, "
+            "{} viewer resyncs",
+            stats.bytesRelayed, stats.messagesSent, stats.readsPaused,
+            resyncs);
+    }
+
+    KvmSharedHost(const KvmSharedHost&) = delete;
+    KvmSharedHost(KvmSharedHost&&) = delete;
+    KvmSharedHost& operator=(const KvmSharedHost&) = delete;
+    KvmSharedHost& operator=(KvmSharedHost&&) = delete;
+
+    void connect(const boost::asio::ip::tcp::endpoint& endpoint)
+    {
+        hostSocket.async_connect(
+            endpoint, std::bind_front(&KvmSharedHost::afterConnect, this,
+                                      weak_from_this()));
+    }
+
+    void addViewer(crow::websocket::Connection& conn)
+    {
+        if (viewers.size() >= maxSessions)
+        {
+            conn.close("Max sessions are already connected");
+            return;
+        }
+        if (!viewers.empty() && (serverStream.failed() || sharingFailed))
+        {
+            conn.close("KVM session can't be shared");
+            return;
+        }
+        std::shared_ptr<Viewer> viewer = std::make_shared<Viewer>(conn);
+        if (viewers.empty())
+        {
+            // The controlling viewer does the handshake with the server
+            viewer->state = ViewerState::Streaming;
+        }
+        viewers.emplace_back(viewer);
+        if (viewer->state == ViewerState::Handshake && serverStream.inSync())
+        {
+            startHandshake(viewer);
+        }
+    }
+
+    void removeViewer(crow::websocket::Connection& conn)
+    {
+        auto viewer = std::ranges::find(viewers, &conn, &Viewer::conn);
+        if (viewer == viewers.end())
+        {
+            return;
+        }
+        bool wasController = viewer == viewers.begin();
+        viewers.erase(viewer);
+        if (!wasController || viewers.empty())
+        {
+            return;
+        }
+
+        // Hand control to the longest connected viewer that is streaming
+        auto next = std::ranges::find(viewers, ViewerState::Streaming,
+                                      &Viewer::state);
+        if (next == viewers.end() ||
+            (*next)->input.getStage() != RfbClientStream::Stage::Messages)
+        {
+            closeAll("KVM controlling session closed");
+            return;
+        }
+        std::rotate(viewers.begin(), next, next + 1);
+        BMCWEB_LOG_INFO("conn:{}, now controls the shared KVM session",
+                        logPtr(viewers.front()->conn));
+        doRead();
+    }
+
+    void onMessage(crow::websocket::Connection& conn, std::string_view data)
+    {
+        auto it = std::ranges::find(viewers, &conn, &Viewer::conn);
+        if (it == viewers.end())
+        {
+            return;
+        }
+        std::shared_ptr<Viewer> viewer = *it;
+        std::string out;
+        viewer->input.parse(data, out);
+        if (it != viewers.begin())
+        {
+            // Read only viewers only get to finish their handshake, and the
+            // pixel format they ask for is never sent to the server
+            viewer->input.pixelFormat.reset();
+            continueHandshake(viewer);
+            return;
+        }
+
+        if (hostBuffer.size() + out.size() > kvmHostMaxQueued)
+        {
+            BMCWEB_LOG_ERROR("conn:{}, Buffer overrun when writing {} bytes",
+                             logPtr(&conn), out.size());
+            conn.close("Buffer overrun");
+            return;
+        }
+        serverStream.followClient(viewer->input);
+        viewer->input.pixelFormat.reset();
+        if (viewer->input.getStage() == RfbClientStream::Stage::Failed &&
+            !sharingFailed)
+        {
+            stopSharing();
+        }
+        writeToHost(out);
+    }
+
+    bool empty() const
+    {
+        return viewers.empty();
+    }
+
+    // True once the connection to the server is gone
+    bool isClosed() const
+    {
+        return closed;
+    }
+
+    const KvmRelayStats& getStats() const
+    {
+        return stats;
+    }
+
+  private:
+    enum class ViewerState
+    {
+        // Waiting for, or in the middle of, the handshake with bmcweb
+        Handshake,
+        // Waiting for its queue to drain and the next server message
+        Waiting,
+        Streaming,
+        // Too far behind, stops at the next server message
+        Draining,
+    };
+
+    // Data read from the server, shared between the viewers
+    struct Chunk
+    {
+        std::string data;
+        std::vector<size_t> messageStarts;
+    };
+
+    struct QueuedChunk
+    {
+        std::shared_ptr<const Chunk> chunk;
+        size_t begin;
+        size_t end;
+    };
+
+    struct Viewer
+    {
+        explicit Viewer(crow::websocket::Connection& connIn) : conn(&connIn) {}
+
+        crow::websocket::Connection* conn;
+        RfbClientStream input;
+        ViewerState state = ViewerState::Handshake;
+        // Handshake messages bmcweb has sent in place of the server
+        size_t handshakeSent = 0;
+        std::deque<QueuedChunk> queue;
+        size_t queuedBytes = 0;
+        bool sending = false;
+    };
+
+    void afterConnect(const std::weak_ptr<KvmSharedHost>& weak,
+                      const boost::system::error_code& ec)
+    {
+        auto self = weak.lock();
+        if (self == nullptr)
+        {
+            return;
+        }
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR("Couldn't connect to KVM socket port: {}", ec);
+            closeAll("Error in connecting to KVM port");
+            return;
+        }
+        connected = true;
+        doRead();
+        doWrite();
+    }
+
+    void closeAll(std::string_view reason)
+    {
+        closed = true;
+        for (const std::shared_ptr<Viewer>& viewer : viewers)
+        {
+            viewer->conn->close(reason);
+        }
+        viewers.clear();
+        hostSocket.close();
+    }
+
+    // The stream from the controlling viewer can't be followed, so no other
+    // messages can be inserted into it
+    void stopSharing()
+    {
+        BMCWEB_LOG_WARNING("KVM session can no longer be shared");
+        sharingFailed = true;
+        for (size_t index = 1; index < viewers.size(); index++)
+        {
+            viewers[index]->conn->close("KVM session can't be shared");
+        }
+    }
+
+    void doRead()
+    {
+        if (!connected || closed || doingRead || viewers.empty())
+        {
+            return;
+        }
+        if (viewers.front()->queuedBytes >= kvmRelayBufferSize * 2)
+        {
+            BMCWEB_LOG_DEBUG("Controlling viewer is behind, pausing KVM reads");
+            stats.readsPaused++;
+            return;
+        }
+        std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>();
+        chunk->data.resize(kvmRelayBufferSize);
+        doingRead = true;
+        hostSocket.async_read_some(
+            boost::asio::buffer(chunk->data),
+            std::bind_front(&KvmSharedHost::afterRead, this, weak_from_this(),
+                            chunk));
+    }
+
+    void afterRead(const std::weak_ptr<KvmSharedHost>& weak,
+                   const std::shared_ptr<Chunk>& chunk,
+                   const boost::system::error_code& ec, std::size_t bytesRead)
+    {
+        auto self = weak.lock();
+        if (self == nullptr)
+        {
+            return;
+        }
+        doingRead = false;
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR("Couldn't read from KVM socket port: {}", ec);
+            if (ec != boost::asio::error::operation_aborted)
+            {
+                closeAll("Error in connecting to KVM port");
+            }
+            return;
+        }
+        chunk->data.resize(bytesRead);
+        stats.bytesRelayed += bytesRead;
+
+        bool wasInSync = serverStream.inSync();
+        serverStream.parse(chunk->data, chunk->messageStarts);
+        if (serverStream.failed() && !sharingFailed)
+        {
+            stopSharing();
+        }
+        if (viewers.empty())
+        {
+            return;
+        }
+
+        for (const std::shared_ptr<Viewer>& viewer : viewers)
+        {
+            distribute(viewer, chunk);
+        }
+        stats.maxQueuedBytes =
+            std::max(stats.maxQueuedBytes, viewers.front()->queuedBytes);
+
+        if (!wasInSync && serverStream.inSync())
+        {
+            for (const std::shared_ptr<Viewer>& viewer : viewers)
+            {
+                if (viewer->state == ViewerState::Handshake)
+                {
+                    startHandshake(viewer);
+                }
+            }
+        }
+        doRead();
+    }
+
+    void distribute(const std::shared_ptr<Viewer>& viewer,
+                    const std::shared_ptr<const Chunk>& chunk)
+    {
+        size_t size = chunk->data.size();
+        auto start = chunk->messageStarts.begin();
+        switch (viewer->state)
+        {
+            case ViewerState::Handshake:
+                return;
+            case ViewerState::Streaming:
+                enqueue(viewer, chunk, 0, size);
+                if (viewer != viewers.front() &&
+                    viewer->queuedBytes > kvmViewerMaxQueued)
+                {
+                    resync(*viewer);
+                }
+                return;
+            case ViewerState::Draining:
+                if (start == chunk->messageStarts.end())
+                {
+                    enqueue(viewer, chunk, 0, size);
+                    return;
+                }
+                enqueue(viewer, chunk, 0, *start);
+                viewer->state = ViewerState::Waiting;
+                return;
+            case ViewerState::Waiting:
+                if (viewer->queuedBytes != 0 ||
+                    start == chunk->messageStarts.end())
+                {
+                    return;
+                }
+                viewer->state = ViewerState::Streaming;
+                enqueue(viewer, chunk, *start, size);
+                writeToHost(serverStream.getFullUpdateRequest());
+                return;
+        }
+    }
+
+    // Drops everything queued for the viewer after the first server message
+    // that starts after the data being sent
+    void resync(Viewer& viewer)
+    {
+        resyncs++;
+        BMCWEB_LOG_WARNING("conn:{}, KVM viewer fell behind by {} bytes",
+                           logPtr(viewer.conn), viewer.queuedBytes);
+        size_t index = viewer.sending ? 1 : 0;
+        for (; index < viewer.queue.size(); index++)
+        {
+            QueuedChunk& queued = viewer.queue[index];
+            const std::vector<size_t>& starts = queued.chunk->messageStarts;
+            auto start = std::ranges::lower_bound(starts, queued.begin);
+            if (start == starts.end() || *start >= queued.end)
+            {
+                continue;
+            }
+            queued.end = *start;
+            if (queued.end == queued.begin)
+            {
+                viewer.queue.erase(viewer.queue.begin() +
+                                       static_cast<std::ptrdiff_t>(index),
+                                   viewer.queue.end());
+            }
+            else
+            {
+                viewer.queue.erase(viewer.queue.begin() +
+                                       static_cast<std::ptrdiff_t>(index) + 1,
+                                   viewer.queue.end());
+            }
+            viewer.queuedBytes = 0;
+            for (const QueuedChunk& kept : viewer.queue)
+            {
+                viewer.queuedBytes += kept.end - kept.begin;
+            }
+            viewer.state = ViewerState::Waiting;
+            return;
+        }
+        viewer.state = ViewerState::Draining;
+    }
+
+    void enqueue(const std::shared_ptr<Viewer>& viewer,
+                 const std::shared_ptr<const Chunk>& chunk, size_t begin,
+                 size_t end)
+    {
+        if (begin == end)
+        {
+            return;
+        }
+        viewer->queue.emplace_back(QueuedChunk{chunk, begin, end});
+        viewer->queuedBytes += end - begin;
+        sendNext(viewer);
+    }
+
+    void sendToViewer(const std::shared_ptr<Viewer>& viewer, std::string data)
+    {
+        std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>();
+        chunk->data = std::move(data);
+        enqueue(viewer, chunk, 0, chunk->data.size());
+    }
+
+    void sendNext(const std::shared_ptr<Viewer>& viewer)
+    {
+        if (viewer->sending || viewer->queue.empty())
+        {
+            return;
+        }
+        const QueuedChunk& queued = viewer->queue.front();
+        std::string_view payload =
+            std::string_view(queued.chunk->data)
+                .substr(queued.begin, queued.end - queued.begin);
+        viewer->sending = true;
+        stats.messagesSent++;
+        // The websocket writes straight from the chunk, which the queue keeps
+        // alive until it's done
+        viewer->conn->sendEx(crow::websocket::MessageType::Binary, payload,
+                             std::bind_front(&KvmSharedHost::afterSend, this,
+                                             shared_from_this(), viewer));
+    }
+
+    void afterSend(const std::shared_ptr<KvmSharedHost>& /*self*/,
+                   const std::shared_ptr<Viewer>& viewer)
+    {
+        viewer->sending = false;
+        if (!viewer->queue.empty())
+        {
+            const QueuedChunk& sent = viewer->queue.front();
+            viewer->queuedBytes -= sent.end - sent.begin;
+            viewer->queue.pop_front();
+        }
+        sendNext(viewer);
+        if (!viewers.empty() && viewer == viewers.front())
+        {
+            // Resume reading if it was paused on the controlling viewer
+            doRead();
+        }
+    }
+
+    // Acts as the server for the handshake of a read only viewer, offering
+    // no security since the websocket is already authenticated
+    void startHandshake(const std::shared_ptr<Viewer>& viewer)
+    {
+        if (viewer->handshakeSent != 0)
+        {
+            return;
+        }
+        viewer->handshakeSent = 1;
+        sendToViewer(viewer, std::string(rfbVersion));
+        continueHandshake(viewer);
+    }
+
+    void continueHandshake(const std::shared_ptr<Viewer>& viewer)
+    {
+        if (viewer->state != ViewerState::Handshake ||
+            viewer->handshakeSent == 0)
+        {
+            return;
+        }
+        RfbClientStream::Stage stage = viewer->input.getStage();
+        if (stage == RfbClientStream::Stage::Failed)
+        {
+            viewer->conn->close("Unsupported RFB client");
+            return;
+        }
+        if (viewer->handshakeSent == 1 &&
+            stage != RfbClientStream::Stage::Version)
+        {
+            viewer->handshakeSent = 2;
+            sendToViewer(viewer, std::string{'\x01', rfbSecurityNone});
+        }
+        if (viewer->handshakeSent == 2 &&
+            stage != RfbClientStream::Stage::Security)
+        {
+            if (viewer->input.securityType != rfbSecurityNone)
+            {
+                viewer->conn->close("Unsupported RFB security type");
+                return;
+            }
+            viewer->handshakeSent = 3;
+            if (viewer->input.minorVersion >= 8)
+            {
+                sendToViewer(viewer, std::string(4, '\0'));
+            }
+        }
+        if (viewer->handshakeSent == 3 &&
+            stage == RfbClientStream::Stage::Messages)
+        {
+            viewer->handshakeSent = 4;
+            sendToViewer(viewer, serverStream.getServerInit());
+            viewer->state = ViewerState::Waiting;
+        }
+    }
+
+    void writeToHost(std::string_view data)
+    {
+        hostBuffer += data;
+        doWrite();
+    }
+
+    void doWrite()
+    {
+        if (!connected || doingWrite || hostBuffer.empty())
+        {
+            return;
+        }
+        doingWrite = true;
+        hostSocket.async_write_some(
+            boost::asio::buffer(hostBuffer),
+            std::bind_front(&KvmSharedHost::afterWrite, this,
+                            weak_from_this()));
+    }
+
+    void afterWrite(const std::weak_ptr<KvmSharedHost>& weak,
+                    const boost::system::error_code& ec,
+                    std::size_t bytesWritten)
+    {
+        auto self = weak.lock();
+        if (self == nullptr)
+        {
+            return;
+        }
+        doingWrite = false;
+        hostBuffer.erase(0, bytesWritten);
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR("Error in KVM socket write {}", ec);
+            if (ec != boost::asio::error::operation_aborted)
+            {
+                closeAll("Error in reading to host port");
+            }
+            return;
+        }
+        doWrite();
+    }
+
+    boost::asio::ip::tcp::socket hostSocket;
+    bool connected = false;
+    bool closed = false;
+    bool doingRead = false;
+    bool doingWrite = false;
+    // Data from the controlling viewer waiting to be written to the server,
+    // which onMessage keeps within kvmHostMaxQueued
+    std::string hostBuffer;
+    RfbServerStream serverStream;
+    bool sharingFailed = false;
+    // The controlling viewer is first
+    std::vector<std::shared_ptr<Viewer>> viewers;
+    KvmRelayStats stats;
+    uint64_t resyncs = 0;
 };
 
 using SessionMap = boost::container::flat_map<crow::websocket::Connection*,
@@ -180,6 +860,14 @@ using SessionMap = boost::container::flat_map<crow::websocket::Connection*,
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 static SessionMap sessions;
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::shared_ptr<KvmSharedHost> sharedHost;
+
+inline boost::asio::ip::tcp::endpoint getKvmEndpoint()
+{
+    return {boost::asio::ip::make_address("127.0.0.1"), kvmPort};
+}
+
 inline void requestRoutes(App& app)
 {
     sessions.reserve(maxSessions);
@@ -191,19 +879,51 @@ inline void requestRoutes(App& app)
         .onopen([](crow::websocket::Connection& conn) {
             BMCWEB_LOG_DEBUG("Connection {} opened", logPtr(&conn));
 
+            if constexpr (BMCWEB_KVM_SHARED_SESSION)
+            {
+                if (sharedHost == nullptr || sharedHost->isClosed())
+                {
+                    sharedHost = std::make_shared<KvmSharedHost>();
+                    sharedHost->connect(getKvmEndpoint());
+                }
+                sharedHost->addViewer(conn);
+                return;
+            }
+
             if (sessions.size() == maxSessions)
             {
                 conn.close("Max sessions are already connected");
                 return;
             }
 
-            sessions[&conn] = std::make_shared<KvmSession>(conn);
+            sessions[&conn] = std::make_shared<KvmSession>(conn,
+                                                           getKvmEndpoint());
         })
         .onclose([](crow::websocket::Connection& conn, const std::string&) {
+            if constexpr (BMCWEB_KVM_SHARED_SESSION)
+            {
+                if (sharedHost != nullptr)
+                {
+                    sharedHost->removeViewer(conn);
+                    if (sharedHost->empty())
+                    {
+                        sharedHost = nullptr;
+                    }
+                }
+                return;
+            }
             sessions.erase(&conn);
         })
         .onmessage([](crow::websocket::Connection& conn,
                       const std::string& data, bool) {
+            if constexpr (BMCWEB_KVM_SHARED_SESSION)
+            {
+                if (sharedHost != nullptr)
+                {
+                    sharedHost->onMessage(conn, data);
+                }
+                return;
+            }
             if (sessions[&conn])
             {
                 sessions[&conn]->onMessage(data);
@@ -0,0 +1,521 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "io_context_singleton.hpp"
+#include "kvm_websocket.hpp"
+#include "rfb_stream.hpp"
+#include "websocket.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/url/url_view.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+namespace crow::obmc_kvm
+{
+namespace
+{
+
+// Websocket that holds on to every sendEx completion until the test releases
+// it, like a viewer that isn't reading, unless autoComplete is set
+class SlowViewer : public crow::websocket::Connection
+{
+  public:
+    void sendBinary(std::string_view msg) override
+    {
+        received += msg;
+    }
+
+    void sendEx(crow::websocket::MessageType /*type*/, std::string_view msg,
+                std::function<void()>&& onDone) override
+    {
+        EXPECT_FALSE(pendingDone) << "sendEx called with a write in flight";
+        received += msg;
+        if (autoComplete)
+        {
+            boost::asio::post(getIoContext(), std::move(onDone));
+            return;
+        }
+        pendingDone = std::move(onDone);
+        sending = msg;
+        sendingCopy = msg;
+    }
+
+    void sendText(std::string_view msg) override
+    {
+        received += msg;
+    }
+
+    void close(std::string_view /*msg*/) override
+    {
+        closed = true;
+    }
+
+    void deferRead() override {}
+
+    void resumeRead() override {}
+
+    boost::urls::url_view url() override
+    {
+        return {};
+    }
+
+    bool completeSend()
+    {
+        if (!pendingDone)
+        {
+            return false;
+        }
+        // The websocket writes from the caller's buffer until it's done
+        EXPECT_EQ(sending, sendingCopy) << "Buffer changed while being sent";
+        std::function<void()> onDone = std::move(pendingDone);
+        pendingDone = nullptr;
+        onDone();
+        return true;
+    }
+
+    std::string received;
+    std::function<void()> pendingDone;
+    std::string_view sending;
+    std::string sendingCopy;
+    bool autoComplete = false;
+    bool closed = false;
+};
+
+void runFor(std::chrono::milliseconds duration)
+{
+    getIoContext().restart();
+    getIoContext().run_for(duration);
+}
+
+// Stands in for the VNC server on a loopback port
+struct LoopbackVnc
+{
+    LoopbackVnc() :
+        acceptor(getIoContext(),
+                 boost::asio::ip::tcp::endpoint(
+                     boost::asio::ip::make_address("127.0.0.1"), 0)),
+        socket(getIoContext())
+    {}
+
+    void accept()
+    {
+        acceptor.accept(socket);
+        // Small writes shouldn't wait on delayed ACKs
+        socket.set_option(boost::asio::ip::tcp::no_delay(true));
+    }
+
+    boost::asio::ip::tcp::acceptor acceptor;
+    boost::asio::ip::tcp::socket socket;
+};
+
+TEST(KvmSession, PausesReadsForSlowViewer)
+{
+    LoopbackVnc vnc;
+    SlowViewer viewer;
+    std::shared_ptr<KvmSession> session = std::make_shared<KvmSession>(
+        viewer, vnc.acceptor.local_endpoint());
+    vnc.accept();
+
+    std::string frames;
+    for (size_t i = 0; i < kvmRelayBufferSize * 4; i++)
+    {
+        frames += static_cast<char>('a' + (i % 26));
+    }
+    bool written = false;
+    boost::asio::async_write(
+        vnc.socket, boost::asio::buffer(frames),
+        [&written](const boost::system::error_code& ec, size_t) {
+            EXPECT_FALSE(ec);
+            written = true;
+        });
+
+    // The viewer never finishes its first message, so once both buffers are
+    // full the session stops reading from the VNC server
+    for (int i = 0; i < 100 && session->getStats().readsPaused == 0; i++)
+    {
+        runFor(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(session->getStats().readsPaused, 1U);
+    EXPECT_EQ(session->getStats().messagesSent, 1U);
+    EXPECT_LE(session->getStats().maxQueuedBytes, kvmRelayBufferSize * 2);
+
+    for (int i = 0; i < 1000 && viewer.received.size() < frames.size(); i++)
+    {
+        viewer.completeSend();
+        runFor(std::chrono::milliseconds(1));
+    }
+    viewer.completeSend();
+    EXPECT_TRUE(written);
+    EXPECT_EQ(viewer.received, frames);
+    EXPECT_EQ(session->getStats().bytesRelayed, frames.size());
+    EXPECT_FALSE(viewer.closed);
+
+    session.reset();
+    runFor(std::chrono::milliseconds(1));
+}
+
+TEST(KvmSession, ForwardsViewerInput)
+{
+    LoopbackVnc vnc;
+    SlowViewer viewer;
+    std::shared_ptr<KvmSession> session = std::make_shared<KvmSession>(
+        viewer, vnc.acceptor.local_endpoint());
+    vnc.accept();
+
+    session->onMessage("keyevent");
+
+    std::string input(8, '\0');
+    bool read = false;
+    boost::asio::async_read(
+        vnc.socket, boost::asio::buffer(input),
+        [&read](const boost::system::error_code& ec, size_t) {
+            EXPECT_FALSE(ec);
+            read = true;
+        });
+    for (int i = 0; i < 100 && !read; i++)
+    {
+        runFor(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(input, "keyevent");
+
+    session.reset();
+    runFor(std::chrono::milliseconds(1));
+}
+
+std::string rfbBytes(std::initializer_list<int> values)
+{
+    std::string out;
+    for (int value : values)
+    {
+        out += static_cast<char>(value);
+    }
+    return out;
+}
+
+// Raw FramebufferUpdate of a width x height rectangle at 32 bits per pixel
+std::string rawUpdate(int width, int height)
+{
+    std::string out = rfbBytes({0, 0, 0, 1, 0, 0, 0, 0, width >> 8,
+                                width & 0xff, height >> 8, height & 0xff, 0,
+                                0, 0, 0});
+    out += std::string(static_cast<size_t>(width * height * 4), 'p');
+    return out;
+}
+
+std::string readFromHost(LoopbackVnc& vnc, size_t size)
+{
+    std::string data(size, '\0');
+    bool read = false;
+    boost::asio::async_read(
+        vnc.socket, boost::asio::buffer(data),
+        [&read](const boost::system::error_code& ec, size_t) {
+            EXPECT_FALSE(ec);
+            read = true;
+        });
+    for (int i = 0; i < 1000 && !read; i++)
+    {
+        runFor(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(read);
+    return data;
+}
+
+void writeToViewers(LoopbackVnc& vnc, std::string_view data)
+{
+    bool written = false;
+    boost::asio::async_write(
+        vnc.socket, boost::asio::buffer(data),
+        [&written](const boost::system::error_code& ec, size_t) {
+            EXPECT_FALSE(ec);
+            written = true;
+        });
+    for (int i = 0; i < 1000 && !written; i++)
+    {
+        runFor(std::chrono::milliseconds(1));
+    }
+    runFor(std::chrono::milliseconds(5));
+}
+
+TEST(KvmSession, SendCompletesBeforeRead)
+{
+    LoopbackVnc vnc;
+    SlowViewer viewer;
+    std::shared_ptr<KvmSession> session = std::make_shared<KvmSession>(
+        viewer, vnc.acceptor.local_endpoint());
+    vnc.accept();
+
+    writeToViewers(vnc, "first");
+    EXPECT_EQ(viewer.received, "first");
+
+    // Read behind the data being sent while the viewer is still busy, and
+    // start the next read behind that
+    writeToViewers(vnc, "second");
+    EXPECT_EQ(viewer.received, "first");
+
+    // What was read is sent as soon as the viewer is ready, without waiting
+    // for the VNC server to send more
+    EXPECT_TRUE(viewer.completeSend());
+    runFor(std::chrono::milliseconds(1));
+    EXPECT_EQ(viewer.received, "firstsecond");
+
+    writeToViewers(vnc, "third");
+    EXPECT_EQ(viewer.received, "firstsecond");
+    EXPECT_TRUE(viewer.completeSend());
+    runFor(std::chrono::milliseconds(1));
+    EXPECT_EQ(viewer.received, "firstsecondthird");
+    EXPECT_TRUE(viewer.completeSend());
+    EXPECT_FALSE(viewer.closed);
+
+    session.reset();
+    runFor(std::chrono::milliseconds(1));
+}
+
+const std::string serverInit = rfbBytes(
+    {2, 0, 2, 0, 32, 24, 0, 1, 0, 255, 0, 255, 0, 255, 16, 8, 0, 0, 0, 0, 0,
+     0, 0, 0});
+
+// Connects the controlling viewer to the stand in VNC server
+void connectController(LoopbackVnc& vnc, KvmSharedHost& host,
+                       SlowViewer& controller)
+{
+    host.addViewer(controller);
+    vnc.accept();
+
+    writeToViewers(vnc, std::string(rfbVersion) + rfbBytes({1, 1}));
+    host.onMessage(controller, rfbVersion);
+    host.onMessage(controller, rfbBytes({rfbSecurityNone}));
+    // ClientInit
+    host.onMessage(controller, rfbBytes({1}));
+    EXPECT_EQ(readFromHost(vnc, rfbVersion.size() + 2),
+              std::string(rfbVersion) + rfbBytes({1, 1}));
+    writeToViewers(vnc, rfbBytes({0, 0, 0, 0}) + serverInit);
+}
+
+// Runs the handshake of a read only viewer with bmcweb
+void connectViewer(KvmSharedHost& host, SlowViewer& viewer)
+{
+    host.addViewer(viewer);
+    host.onMessage(viewer, rfbVersion);
+    host.onMessage(viewer, rfbBytes({rfbSecurityNone}));
+    host.onMessage(viewer, rfbBytes({1}));
+    runFor(std::chrono::milliseconds(5));
+}
+
+TEST(KvmSharedHost, ViewerJoinsAtMessageStart)
+{
+    LoopbackVnc vnc;
+    SlowViewer controller;
+    controller.autoComplete = true;
+    std::shared_ptr<KvmSharedHost> host = std::make_shared<KvmSharedHost>();
+    host->connect(vnc.acceptor.local_endpoint());
+    connectController(vnc, *host, controller);
+
+    // Half of an update is sent before the viewer joins
+    std::string update = rawUpdate(16, 16);
+    writeToViewers(vnc, update.substr(0, 100));
+
+    SlowViewer viewer;
+    viewer.autoComplete = true;
+    connectViewer(*host, viewer);
+    EXPECT_EQ(viewer.received, std::string(rfbVersion) +
+                                   rfbBytes({1, rfbSecurityNone, 0, 0, 0, 0}) +
+                                   serverInit);
+    viewer.received.clear();
+
+    // The viewer starts with the bell after the update, and the server is
+    // asked for the whole screen
+    std::string bell = rfbBytes({2});
+    writeToViewers(vnc, update.substr(100) + bell);
+    EXPECT_EQ(viewer.received, bell);
+    EXPECT_EQ(readFromHost(vnc, 10),
+              rfbBytes({3, 0, 0, 0, 0, 0, 2, 0, 2, 0}));
+
+    std::string expected = std::string(rfbVersion) + rfbBytes({1, 1}) +
+                           rfbBytes({0, 0, 0, 0}) + serverInit + update +
+                           bell;
+    EXPECT_EQ(controller.received, expected);
+
+    // Input from read only viewers isn't sent to the server
+    host->onMessage(viewer, rfbBytes({4, 1, 0, 0, 0, 0, 0, 'a'}));
+    host->onMessage(controller, rfbBytes({4, 1, 0, 0, 0, 0, 0, 'b'}));
+    EXPECT_EQ(readFromHost(vnc, 8), rfbBytes({4, 1, 0, 0, 0, 0, 0, 'b'}));
+
+    host->removeViewer(viewer);
+    host->removeViewer(controller);
+    EXPECT_TRUE(host->empty());
+    host.reset();
+    runFor(std::chrono::milliseconds(1));
+}
+
+TEST(KvmSharedHost, SlowViewerDoesNotStallOthers)
+{
+    LoopbackVnc vnc;
+    SlowViewer controller;
+    controller.autoComplete = true;
+    std::shared_ptr<KvmSharedHost> host = std::make_shared<KvmSharedHost>();
+    host->connect(vnc.acceptor.local_endpoint());
+    connectController(vnc, *host, controller);
+
+    SlowViewer viewer;
+    viewer.autoComplete = true;
+    connectViewer(*host, viewer);
+    writeToViewers(vnc, rfbBytes({2}));
+    EXPECT_EQ(readFromHost(vnc, 10),
+              rfbBytes({3, 0, 0, 0, 0, 0, 2, 0, 2, 0}));
+
+    // The viewer stops reading while the server sends more than it may
+    // queue
+    viewer.autoComplete = false;
+    viewer.received.clear();
+    std::string updates;
+    for (int i = 0; i < 8; i++)
+    {
+        updates += rawUpdate(512, 512);
+    }
+    controller.received.clear();
+    writeToViewers(vnc, updates);
+    for (int i = 0; i < 1000 && controller.received.size() < updates.size();
+         i++)
+    {
+        runFor(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(controller.received == updates);
+    EXPECT_LT(viewer.received.size(), updates.size());
+
+    // Once it catches up it gets what it was sent up to the end of an
+    // update, then rejoins at the next message
+    while (viewer.completeSend())
+    {
+        runFor(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(viewer.received ==
+                updates.substr(0, viewer.received.size()));
+    EXPECT_EQ(viewer.received.size() % rawUpdate(512, 512).size(), 0U);
+    EXPECT_LT(viewer.received.size(), updates.size());
+
+    viewer.autoComplete = true;
+    writeToViewers(vnc, rfbBytes({2}));
+    EXPECT_EQ(viewer.received.back(), 2);
+    EXPECT_EQ(readFromHost(vnc, 10),
+              rfbBytes({3, 0, 0, 0, 0, 0, 2, 0, 2, 0}));
+    EXPECT_FALSE(viewer.closed);
+
+    host->removeViewer(viewer);
+    host->removeViewer(controller);
+    host.reset();
+    runFor(std::chrono::milliseconds(1));
+}
+
+TEST(KvmSharedHost, ControlPassesToViewer)
+{
+    LoopbackVnc vnc;
+    SlowViewer controller;
+    controller.autoComplete = true;
+    std::shared_ptr<KvmSharedHost> host = std::make_shared<KvmSharedHost>();
+    host->connect(vnc.acceptor.local_endpoint());
+    connectController(vnc, *host, controller);
+
+    SlowViewer viewer;
+    viewer.autoComplete = true;
+    connectViewer(*host, viewer);
+    writeToViewers(vnc, rfbBytes({2}));
+    EXPECT_EQ(readFromHost(vnc, 10),
+              rfbBytes({3, 0, 0, 0, 0, 0, 2, 0, 2, 0}));
+
+    host->removeViewer(controller);
+    host->onMessage(viewer, rfbBytes({4, 1, 0, 0, 0, 0, 0, 'c'}));
+    EXPECT_EQ(readFromHost(vnc, 8), rfbBytes({4, 1, 0, 0, 0, 0, 0, 'c'}));
+    EXPECT_FALSE(viewer.closed);
+
+    host->removeViewer(viewer);
+    host.reset();
+    runFor(std::chrono::milliseconds(1));
+}
+
+TEST(KvmSharedHost, ClosesViewerThatOverrunsInput)
+{
+    LoopbackVnc vnc;
+    SlowViewer controller;
+    controller.autoComplete = true;
+    std::shared_ptr<KvmSharedHost> host = std::make_shared<KvmSharedHost>();
+    host->connect(vnc.acceptor.local_endpoint());
+    connectController(vnc, *host, controller);
+
+    std::string keyEvent = rfbBytes({4, 1, 0, 0, 0, 0, 0, 'a'});
+    std::string keyEvents;
+    while (keyEvents.size() <= kvmHostMaxQueued)
+    {
+        keyEvents += keyEvent;
+    }
+    host->onMessage(controller, keyEvent);
+    EXPECT_EQ(readFromHost(vnc, keyEvent.size()), keyEvent);
+    EXPECT_FALSE(controller.closed);
+
+    host->onMessage(controller, keyEvents);
+    EXPECT_TRUE(controller.closed);
+
+    host->removeViewer(controller);
+    host.reset();
+    runFor(std::chrono::milliseconds(1));
+}
+
+// ServerCutText message carrying text
+std::string cutText(std::string_view text)
+{
+    std::string out = rfbBytes({3, 0, 0, 0, 0, 0, 0,
+                                static_cast<int>(text.size())});
+    out += text;
+    return out;
+}
+
+TEST(KvmSharedHost, SendCompletesBeforeRead)
+{
+    LoopbackVnc vnc;
+    SlowViewer controller;
+    controller.autoComplete = true;
+    std::shared_ptr<KvmSharedHost> host = std::make_shared<KvmSharedHost>();
+    host->connect(vnc.acceptor.local_endpoint());
+    connectController(vnc, *host, controller);
+
+    controller.autoComplete = false;
+    controller.received.clear();
+    std::string first = cutText("first");
+    writeToViewers(vnc, first);
+    EXPECT_EQ(controller.received, first);
+
+    // The first message is still being sent when the next read completes,
+    // and finishes while the read after it is outstanding
+    std::string second = cutText("second");
+    writeToViewers(vnc, second);
+    EXPECT_TRUE(controller.completeSend());
+    runFor(std::chrono::milliseconds(1));
+
+    std::string third = cutText("third");
+    writeToViewers(vnc, third);
+    while (controller.completeSend())
+    {
+        runFor(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(controller.received, first + second + third);
+    EXPECT_FALSE(controller.closed);
+
+    host->removeViewer(controller);
+    host.reset();
+    runFor(std::chrono::milliseconds(1));
+}
+
+} // namespace
+} // namespace crow::obmc_kvm
@@ -0,0 +1,699 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "logging.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace crow
+{
+namespace obmc_kvm
+{
+
+// Minimal RFB (RFC 6143) framing, used to find the message boundaries in the
+// stream from the VNC server so that several viewers can share one
+// connection.  Only the parts of the protocol needed to find where each
+// message ends are understood.  Encodings that carry state between updates,
+// like ZRLE and Tight, can't be joined part way through, so SetEncodings from
+// the viewers is limited to the stateless encodings below.
+
+static constexpr const int32_t rfbEncodingRaw = 0;
+static constexpr const int32_t rfbEncodingCopyRect = 1;
+static constexpr const int32_t rfbEncodingHextile = 5;
+static constexpr const int32_t rfbEncodingLastRect = -224;
+static constexpr const int32_t rfbEncodingDesktopSize = -223;
+
+static constexpr const uint8_t rfbSecurityNone = 1;
+static constexpr const uint8_t rfbSecurityVncAuth = 2;
+
+// Version handshake sent by the server
+static constexpr const std::string_view rfbVersion = "RFB 003.008\n";
+
+inline uint16_t rfbRead16(std::string_view data, size_t offset)
+{
+    return static_cast<uint16_t>(
+        (static_cast<uint8_t>(data[offset]) << 8) |
+        static_cast<uint8_t>(data[offset + 1]));
+}
+
+inline uint32_t rfbRead32(std::string_view data, size_t offset)
+{
+    return (static_cast<uint32_t>(rfbRead16(data, offset)) << 16) |
+           rfbRead16(data, offset + 2);
+}
+
+inline void rfbAppend16(std::string& out, uint16_t value)
+{
+    out += static_cast<char>(value >> 8);
+    out += static_cast<char>(value & 0xff);
+}
+
+// Returns the minor version from a ProtocolVersion message, or nullopt if it
+// isn't one
+inline std::optional<int> rfbParseVersion(std::string_view version)
+{
+    if (version.size() != rfbVersion.size() || !version.starts_with("RFB ") ||
+        version[7] != '.' || version.back() != '\n')
+    {
+        return std::nullopt;
+    }
+    int minor = 0;
+    for (char c : version.substr(8, 3))
+    {
+        if (c < '0' || c > '9')
+        {
+            return std::nullopt;
+        }
+        minor = minor * 10 + (c - '0');
+    }
+    return minor;
+}
+
+// Messages from a viewer.  Only whole messages are passed on, so that other
+// messages can be inserted between them.
+class RfbClientStream
+{
+  public:
+    enum class Stage
+    {
+        Version,
+        Security,
+        SecurityResponse,
+        ClientInit,
+        Messages,
+        Failed,
+    };
+
+    // Appends the complete messages in data to out.  SetEncodings is limited
+    // to the encodings RfbServerStream can follow.  Once the stream can't be
+    // followed any more, data is passed through as is.
+    void parse(std::string_view data, std::string& out)
+    {
+        size_t pos = 0;
+        while (pos < data.size())
+        {
+            if (stage == Stage::Failed)
+            {
+                out += data.substr(pos);
+                return;
+            }
+            size_t bytes = std::min(need - message.size(), data.size() - pos);
+            message += data.substr(pos, bytes);
+            pos += bytes;
+            if (message.size() < need)
+            {
+                return;
+            }
+            advance(out);
+        }
+    }
+
+    Stage getStage() const
+    {
+        return stage;
+    }
+
+    int minorVersion = 0;
+    std::optional<uint8_t> securityType;
+    std::optional<std::array<uint8_t, 16>> pixelFormat;
+
+  private:
+    void fail(std::string& out)
+    {
+        BMCWEB_LOG_WARNING("Can't follow RFB client stream");
+        stage = Stage::Failed;
+        out += message;
+        message.clear();
+    }
+
+    void complete(std::string& out, Stage next, size_t nextNeed)
+    {
+        out += message;
+        message.clear();
+        stage = next;
+        need = nextNeed;
+    }
+
+    void advance(std::string& out)
+    {
+        switch (stage)
+        {
+            case Stage::Version:
+            {
+                std::optional<int> minor = rfbParseVersion(message);
+                if (!minor || *minor < 7)
+                {
+                    fail(out);
+                    return;
+                }
+                minorVersion = *minor;
+                complete(out, Stage::Security, 1);
+                return;
+            }
+            case Stage::Security:
+                securityType = static_cast<uint8_t>(message[0]);
+                if (*securityType == rfbSecurityVncAuth)
+                {
+                    complete(out, Stage::SecurityResponse, 16);
+                    return;
+                }
+                complete(out, Stage::ClientInit, 1);
+                return;
+            case Stage::SecurityResponse:
+                complete(out, Stage::ClientInit, 1);
+                return;
+            case Stage::ClientInit:
+                complete(out, Stage::Messages, 1);
+                return;
+            case Stage::Messages:
+                advanceMessage(out);
+                return;
+            case Stage::Failed:
+                return;
+        }
+    }
+
+    void advanceMessage(std::string& out)
+    {
+        switch (static_cast<uint8_t>(message[0]))
+        {
+            // SetPixelFormat
+            case 0:
+                if (need == 1)
+                {
+                    need = 20;
+                    return;
+                }
+                pixelFormat.emplace();
+                std::copy_n(message.begin() + 4, 16, pixelFormat->begin());
+                break;
+            // SetEncodings
+            case 2:
+                if (need == 1)
+                {
+                    need = 4;
+                    return;
+                }
+                if (need == 4)
+                {
+                    need = 4 + 4 * size_t{rfbRead16(message, 2)};
+                    if (need > 4)
+                    {
+                        return;
+                    }
+                }
+                filterEncodings();
+                break;
+            // FramebufferUpdateRequest
+            case 3:
+                if (need == 1)
+                {
+                    need = 10;
+                    return;
+                }
+                break;
+            // KeyEvent
+            case 4:
+                if (need == 1)
+                {
+                    need = 8;
+                    return;
+                }
+                break;
+            // PointerEvent
+            case 5:
+                if (need == 1)
+                {
+                    need = 6;
+                    return;
+                }
+                break;
+            // ClientCutText
+            case 6:
+                if (need == 1)
+                {
+                    need = 8;
+                    return;
+                }
+                if (need == 8)
+                {
+                    need = 8 + size_t{rfbRead32(message, 4)};
+                    if (need > maxCutText)
+                    {
+                        fail(out);
+                        return;
+                    }
+                    if (need > 8)
+                    {
+                        return;
+                    }
+                }
+                break;
+            default:
+                fail(out);
+                return;
+        }
+        complete(out, Stage::Messages, 1);
+    }
+
+    void filterEncodings()
+    {
+        std::string filtered = message.substr(0, 2);
+        std::string encodings;
+        for (size_t offset = 4; offset + 4 <= message.size(); offset += 4)
+        {
+            int32_t encoding = static_cast<int32_t>(rfbRead32(message, offset));
+            if (encoding == rfbEncodingRaw ||
+                encoding == rfbEncodingCopyRect ||
+                encoding == rfbEncodingHextile ||
+                encoding == rfbEncodingLastRect ||
+                encoding == rfbEncodingDesktopSize)
+            {
+                encodings += message.substr(offset, 4);
+            }
+        }
+        rfbAppend16(filtered, static_cast<uint16_t>(encodings.size() / 4));
+        filtered += encodings;
+        message = std::move(filtered);
+    }
+
+    static constexpr size_t maxCutText = 1024UL * 1024UL;
+
+    Stage stage = Stage::Version;
+    size_t need = rfbVersion.size();
+    std::string message;
+};
+
+// Messages from the VNC server.  Follows the handshake and every server
+// message so that it can tell where each one starts.
+class RfbServerStream
+{
+  public:
+    // Appends the offsets in data at which a server message starts, once the
+    // handshake is complete
+    void parse(std::string_view data, std::vector<size_t>& messageStarts)
+    {
+        size_t pos = 0;
+        while (pos < data.size() && state != State::Failed)
+        {
+            if (skip > 0)
+            {
+                size_t bytes = std::min(skip, data.size() - pos);
+                skip -= bytes;
+                pos += bytes;
+                continue;
+            }
+            if (state == State::Security && !startSecurity())
+            {
+                break;
+            }
+            if (state == State::MessageType && header.empty())
+            {
+                messageStarts.emplace_back(pos);
+            }
+            size_t bytes = std::min(need - header.size(), data.size() - pos);
+            header += data.substr(pos, bytes);
+            pos += bytes;
+            if (header.size() < need)
+            {
+                break;
+            }
+            advance();
+        }
+    }
+
+    // Takes the negotiated version, security type and pixel format from the
+    // stream of the client driving the connection
+    void followClient(const RfbClientStream& client)
+    {
+        clientMinorVersion = client.minorVersion;
+        securityType = client.securityType;
+        if (client.pixelFormat && serverInit.size() >= 20)
+        {
+            bytesPerPixel = std::max<size_t>((*client.pixelFormat)[0] / 8, 1);
+            std::ranges::copy(*client.pixelFormat, serverInit.begin() + 4);
+        }
+    }
+
+    // True once the handshake is done and the stream is still understood
+    bool inSync() const
+    {
+        return state != State::Failed && !serverInit.empty();
+    }
+
+    bool failed() const
+    {
+        return state == State::Failed;
+    }
+
+    // ServerInit for a viewer joining now
+    std::string getServerInit() const
+    {
+        std::string out;
+        rfbAppend16(out, width);
+        rfbAppend16(out, height);
+        out += std::string_view(serverInit).substr(4);
+        return out;
+    }
+
+    // Non incremental FramebufferUpdateRequest for the whole screen
+    std::string getFullUpdateRequest() const
+    {
+        std::string out{'\x03', '\x00', '\x00', '\x00', '\x00', '\x00'};
+        rfbAppend16(out, width);
+        rfbAppend16(out, height);
+        return out;
+    }
+
+  private:
+    enum class State
+    {
+        Version,
+        SecurityTypeCount,
+        SecurityTypes,
+        Security,
+        SecurityChallenge,
+        SecurityResult,
+        ServerInit,
+        ServerName,
+        MessageType,
+        UpdateHeader,
+        RectHeader,
+        HextileTile,
+        HextileSubrects,
+        ColourMap,
+        CutText,
+        Failed,
+    };
+
+    void next(State nextState, size_t nextNeed)
+    {
+        header.clear();
+        state = nextState;
+        need = nextNeed;
+    }
+
+    void fail()
+    {
+        BMCWEB_LOG_WARNING("Can't follow RFB server stream");
+        header.clear();
+        state = State::Failed;
+    }
+
+    // The server's reply to the security type depends on what the client
+    // picked, which the client has sent by the time the reply arrives
+    bool startSecurity()
+    {
+        if (clientMinorVersion < 7 || !securityType)
+        {
+            fail();
+            return false;
+        }
+        if (*securityType == rfbSecurityVncAuth)
+        {
+            next(State::SecurityChallenge, 16);
+            return true;
+        }
+        if (*securityType != rfbSecurityNone)
+        {
+            fail();
+            return false;
+        }
+        // Version 3.7 doesn't send a SecurityResult for None
+        if (std::min(clientMinorVersion, serverMinorVersion) < 8)
+        {
+            next(State::ServerInit, 24);
+            return true;
+        }
+        next(State::SecurityResult, 4);
+        return true;
+    }
+
+    void advance()
+    {
+        switch (state)
+        {
+            case State::Version:
+            {
+                std::optional<int> minor = rfbParseVersion(header);
+                if (!minor || *minor < 7)
+                {
+                    fail();
+                    return;
+                }
+                serverMinorVersion = *minor;
+                next(State::SecurityTypeCount, 1);
+                return;
+            }
+            case State::SecurityTypeCount:
+            {
+                size_t count = static_cast<uint8_t>(header[0]);
+                if (count == 0)
+                {
+                    fail();
+                    return;
+                }
+                next(State::SecurityTypes, count);
+                return;
+            }
+            case State::SecurityTypes:
+                next(State::Security, 0);
+                return;
+            case State::SecurityChallenge:
+                next(State::SecurityResult, 4);
+                return;
+            case State::SecurityResult:
+                if (rfbRead32(header, 0) != 0)
+                {
+                    fail();
+                    return;
+                }
+                next(State::ServerInit, 24);
+                return;
+            case State::ServerInit:
+            {
+                width = rfbRead16(header, 0);
+                height = rfbRead16(header, 2);
+                bytesPerPixel =
+                    std::max<size_t>(static_cast<uint8_t>(header[4]) / 8, 1);
+                size_t nameLength = rfbRead32(header, 20);
+                if (nameLength > maxNameLength)
+                {
+                    fail();
+                    return;
+                }
+                pendingServerInit = header;
+                if (nameLength == 0)
+                {
+                    serverInit = std::move(pendingServerInit);
+                    next(State::MessageType, 1);
+                    return;
+                }
+                next(State::ServerName, nameLength);
+                return;
+            }
+            case State::ServerName:
+                serverInit = pendingServerInit + header;
+                next(State::MessageType, 1);
+                return;
+            case State::MessageType:
+                advanceMessageType();
+                return;
+            case State::UpdateHeader:
+                rectsLeft = rfbRead16(header, 1);
+                if (rectsLeft == 0)
+                {
+                    next(State::MessageType, 1);
+                    return;
+                }
+                next(State::RectHeader, 12);
+                return;
+            case State::RectHeader:
+                advanceRect();
+                return;
+            case State::HextileTile:
+                advanceTile();
+                return;
+            case State::HextileSubrects:
+            {
+                size_t count = static_cast<uint8_t>(header.back());
+                size_t coloured = (tileFlags & 0x10) != 0 ? bytesPerPixel : 0;
+                skip = count * (coloured + 2);
+                tileDone();
+                return;
+            }
+            case State::ColourMap:
+                skip = size_t{rfbRead16(header, 3)} * 6;
+                next(State::MessageType, 1);
+                return;
+            case State::CutText:
+                skip = rfbRead32(header, 3);
+                next(State::MessageType, 1);
+                return;
+            case State::Security:
+            case State::Failed:
+                return;
+        }
+    }
+
+    void advanceMessageType()
+    {
+        switch (static_cast<uint8_t>(header[0]))
+        {
+            // FramebufferUpdate
+            case 0:
+                next(State::UpdateHeader, 3);
+                return;
+            // SetColourMapEntries
+            case 1:
+                next(State::ColourMap, 5);
+                return;
+            // Bell
+            case 2:
+                next(State::MessageType, 1);
+                return;
+            // ServerCutText
+            case 3:
+                next(State::CutText, 7);
+                return;
+            default:
+                fail();
+                return;
+        }
+    }
+
+    void advanceRect()
+    {
+        rectWidth = rfbRead16(header, 4);
+        rectHeight = rfbRead16(header, 6);
+        int32_t encoding = static_cast<int32_t>(rfbRead32(header, 8));
+        switch (encoding)
+        {
+            case rfbEncodingRaw:
+                skip = size_t{rectWidth} * rectHeight * bytesPerPixel;
+                rectDone();
+                return;
+            case rfbEncodingCopyRect:
+                skip = 4;
+                rectDone();
+                return;
+            case rfbEncodingHextile:
+                tile = 0;
+                if (rectWidth == 0 || rectHeight == 0)
+                {
+                    rectDone();
+                    return;
+                }
+                next(State::HextileTile, 1);
+                return;
+            case rfbEncodingDesktopSize:
+                width = rectWidth;
+                height = rectHeight;
+                rectDone();
+                return;
+            case rfbEncodingLastRect:
+                next(State::MessageType, 1);
+                return;
+            default:
+                fail();
+                return;
+        }
+    }
+
+    void rectDone()
+    {
+        // A count of 0xffff means the update ends with a LastRect instead
+        if (rectsLeft != 0xffff)
+        {
+            rectsLeft--;
+        }
+        if (rectsLeft == 0)
+        {
+            next(State::MessageType, 1);
+            return;
+        }
+        next(State::RectHeader, 12);
+    }
+
+    void advanceTile()
+    {
+        size_t tilesPerRow = (size_t{rectWidth} + 15) / 16;
+        size_t column = tile % tilesPerRow;
+        size_t row = tile / tilesPerRow;
+        size_t tileWidth = std::min<size_t>(16, rectWidth - column * 16);
+        size_t tileHeight = std::min<size_t>(16, rectHeight - row * 16);
+
+        tileFlags = static_cast<uint8_t>(header[0]);
+        // Raw tile, the other flags are ignored
+        if ((tileFlags & 0x01) != 0)
+        {
+            skip = tileWidth * tileHeight * bytesPerPixel;
+            tileDone();
+            return;
+        }
+        size_t colours = 0;
+        if ((tileFlags & 0x02) != 0)
+        {
+            colours += bytesPerPixel;
+        }
+        if ((tileFlags & 0x04) != 0)
+        {
+            colours += bytesPerPixel;
+        }
+        if ((tileFlags & 0x08) != 0)
+        {
+            // The subrectangle count follows the colours
+            next(State::HextileSubrects, colours + 1);
+            return;
+        }
+        skip = colours;
+        tileDone();
+    }
+
+    void tileDone()
+    {
+        tile++;
+        size_t tiles = ((size_t{rectWidth} + 15) / 16) *
+                       ((size_t{rectHeight} + 15) / 16);
+        if (tile == tiles)
+        {
+            rectDone();
+            return;
+        }
+        next(State::HextileTile, 1);
+    }
+
+    static constexpr size_t maxNameLength = 4096;
+
+    State state = State::Version;
+    size_t need = rfbVersion.size();
+    std::string header;
+    size_t skip = 0;
+
+    int serverMinorVersion = 0;
+    int clientMinorVersion = 0;
+    std::optional<uint8_t> securityType;
+
+    std::string pendingServerInit;
+    std::string serverInit;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    size_t bytesPerPixel = 4;
+
+    uint16_t rectsLeft = 0;
+    uint16_t rectWidth = 0;
+    uint16_t rectHeight = 0;
+    size_t tile = 0;
+    uint8_t tileFlags = 0;
+};
+
+} // namespace obmc_kvm
+} // namespace crow
@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "rfb_stream.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace crow::obmc_kvm
+{
+namespace
+{
+
+using ::testing::ElementsAre;
+
+std::string bytes(std::initializer_list<int> values)
+{
+    std::string out;
+    for (int value : values)
+    {
+        out += static_cast<char>(value);
+    }
+    return out;
+}
+
+std::string clientHandshake()
+{
+    return std::string(rfbVersion) + bytes({rfbSecurityNone, 1});
+}
+
+std::string serverHandshake()
+{
+    std::string out(rfbVersion);
+    // One security type, None, and a SecurityResult of OK
+    out += bytes({1, rfbSecurityNone, 0, 0, 0, 0});
+    // ServerInit, 32x16, 32 bits per pixel, named "host"
+    out += bytes({0, 32, 0, 16, 32, 24, 0, 1, 0, 255, 0, 255, 0, 255, 16, 8, 0,
+                  0, 0, 0, 0, 0, 0, 4});
+    out += "host";
+    return out;
+}
+
+RfbServerStream connectedServer()
+{
+    RfbClientStream client;
+    std::string out;
+    client.parse(clientHandshake(), out);
+
+    RfbServerStream server;
+    server.followClient(client);
+    std::vector<size_t> starts;
+    server.parse(serverHandshake(), starts);
+    return server;
+}
+
+TEST(RfbClientStream, PassesWholeMessages)
+{
+    RfbClientStream client;
+    std::string out;
+    client.parse(clientHandshake(), out);
+    EXPECT_EQ(out, clientHandshake());
+    EXPECT_EQ(client.getStage(), RfbClientStream::Stage::Messages);
+    EXPECT_EQ(client.minorVersion, 8);
+    EXPECT_EQ(client.securityType, rfbSecurityNone);
+
+    // A KeyEvent split in two is only passed on once it is complete
+    out.clear();
+    std::string keyEvent = bytes({4, 1, 0, 0, 0, 0, 0, 'a'});
+    client.parse(keyEvent.substr(0, 3), out);
+    EXPECT_EQ(out, "");
+    client.parse(keyEvent.substr(3), out);
+    EXPECT_EQ(out, keyEvent);
+}
+
+TEST(RfbClientStream, FiltersEncodings)
+{
+    RfbClientStream client;
+    std::string out;
+    client.parse(clientHandshake(), out);
+    out.clear();
+
+    // ZRLE, Hextile, Raw, Cursor
+    client.parse(bytes({2, 0, 0, 4, 0, 0, 0, 16, 0, 0, 0, 5, 0, 0, 0, 0, 0xff,
+                        0xff, 0xff, 0x11}),
+                 out);
+    EXPECT_EQ(out, bytes({2, 0, 0, 2, 0, 0, 0, 5, 0, 0, 0, 0}));
+}
+
+TEST(RfbClientStream, TracksPixelFormat)
+{
+    RfbClientStream client;
+    std::string out;
+    client.parse(clientHandshake(), out);
+
+    client.parse(bytes({0, 0, 0, 0, 16, 16, 0, 1, 0, 31, 0, 63, 0, 31, 11, 5,
+                        0, 0, 0, 0}),
+                 out);
+    ASSERT_TRUE(client.pixelFormat);
+    EXPECT_EQ((*client.pixelFormat)[0], 16);
+}
+
+TEST(RfbClientStream, UnknownMessagePassesThrough)
+{
+    RfbClientStream client;
+    std::string out;
+    client.parse(clientHandshake(), out);
+    out.clear();
+
+    client.parse(bytes({200, 1, 2}), out);
+    EXPECT_EQ(client.getStage(), RfbClientStream::Stage::Failed);
+    EXPECT_EQ(out, bytes({200, 1, 2}));
+}
+
+TEST(RfbServerStream, Handshake)
+{
+    RfbServerStream server = connectedServer();
+    EXPECT_TRUE(server.inSync());
+    EXPECT_EQ(server.getServerInit(), serverHandshake().substr(18));
+    EXPECT_EQ(server.getFullUpdateRequest(),
+              bytes({3, 0, 0, 0, 0, 0, 0, 32, 0, 16}));
+}
+
+TEST(RfbServerStream, FindsMessageStarts)
+{
+    std::string messages;
+    // FramebufferUpdate with two rectangles
+    messages += bytes({0, 0, 0, 2});
+    // 2x2 Raw
+    messages += bytes({0, 0, 0, 0, 0, 2, 0, 2, 0, 0, 0, 0});
+    messages += std::string(2 * 2 * 4, 'r');
+    // 32x16 Hextile, two tiles
+    messages += bytes({0, 0, 0, 0, 0, 32, 0, 16, 0, 0, 0, 5});
+    // Raw tile
+    messages += bytes({1});
+    messages += std::string(16 * 16 * 4, 't');
+    // Background, and two coloured subrectangles
+    messages += bytes({0x1a, 1, 2, 3, 4, 2});
+    messages += bytes({1, 2, 3, 4, 0x00, 0x11, 1, 2, 3, 4, 0x22, 0x33});
+    size_t bell = messages.size();
+    messages += bytes({2});
+    size_t cutText = messages.size();
+    messages += bytes({3, 0, 0, 0, 0, 0, 0, 3});
+    messages += "abc";
+    size_t desktopSize = messages.size();
+    messages += bytes({0, 0, 0, 1, 0, 0, 0, 0, 0, 64, 0, 48, 0xff, 0xff, 0xff,
+                       0x21});
+    size_t last = messages.size();
+    messages += bytes({2});
+
+    // All at once
+    RfbServerStream server = connectedServer();
+    std::vector<size_t> starts;
+    server.parse(messages, starts);
+    EXPECT_TRUE(server.inSync());
+    EXPECT_THAT(starts, ElementsAre(0, bell, cutText, desktopSize, last));
+    EXPECT_EQ(server.getFullUpdateRequest(),
+              bytes({3, 0, 0, 0, 0, 0, 0, 64, 0, 48}));
+
+    // A byte at a time
+    RfbServerStream split = connectedServer();
+    std::vector<size_t> splitStarts;
+    for (size_t i = 0; i < messages.size(); i++)
+    {
+        std::vector<size_t> byteStarts;
+        split.parse(messages.substr(i, 1), byteStarts);
+        if (!byteStarts.empty())
+        {
+            splitStarts.emplace_back(i);
+        }
+    }
+    EXPECT_TRUE(split.inSync());
+    EXPECT_EQ(splitStarts, starts);
+}
+
+TEST(RfbServerStream, UnknownEncodingFails)
+{
+    RfbServerStream server = connectedServer();
+    std::vector<size_t> starts;
+    // One ZRLE rectangle
+    server.parse(bytes({0, 0, 0, 1, 0, 0, 0, 0, 0, 2, 0, 2, 0, 0, 0, 16}),
+                 starts);
+    EXPECT_TRUE(server.failed());
+    EXPECT_FALSE(server.inSync());
+}
+
+} // namespace
+} // namespace crow::obmc_kvm
@@ -0,0 +1,311 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "io_context_singleton.hpp"
+#include "logging.hpp"
+#include "websocket.hpp"
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/system/error_code.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+namespace dbus_monitor
+{
+
+struct DbusEventBatchOptions
+{
+    // How long events are held so that changes to the same property are
+    // merged.  Zero sends each event as it arrives.
+    std::chrono::milliseconds coalesceWindow{0};
+    // Most websocket messages sent per second, or zero for no limit
+    uint32_t maxMessageRate = 0;
+    // Send CBOR binary messages instead of JSON text
+    bool cbor = false;
+
+    // Events are batched into arrays if either limit is set
+    bool batching() const
+    {
+        return coalesceWindow.count() > 0 || maxMessageRate > 0;
+    }
+};
+
+struct DbusEventBatchStats
+{
+    uint64_t eventsReceived = 0;
+    // Events merged into an earlier PropertiesChanged for the same interface
+    uint64_t eventsCoalesced = 0;
+    uint64_t messagesSent = 0;
+};
+
+// Reads the optional batching fields of a /subscribe request:
+//   "coalesce_ms": milliseconds to hold events, up to 60000
+//   "max_rate": most messages per second, up to 1000
+//   "encoding": "json" (the default) or "cbor"
+// Returns false if any of them are invalid.
+inline bool parseBatchOptions(const nlohmann::json::object_t& request,
+                              DbusEventBatchOptions& options)
+{
+    auto coalesce = request.find("coalesce_ms");
+    if (coalesce != request.end())
+    {
+        const uint64_t* coalesceMs =
+            coalesce->second.get_ptr<const uint64_t*>();
+        if (coalesceMs == nullptr || *coalesceMs > 60000)
+        {
+            return false;
+        }
+        options.coalesceWindow = std::chrono::milliseconds(*coalesceMs);
+    }
+    auto rate = request.find("max_rate");
+    if (rate != request.end())
+    {
+        const uint64_t* maxRate = rate->second.get_ptr<const uint64_t*>();
+        if (maxRate == nullptr || *maxRate > 1000)
+        {
+            return false;
+        }
+        options.maxMessageRate = static_cast<uint32_t>(*maxRate);
+    }
+    auto encoding = request.find("encoding");
+    if (encoding != request.end())
+    {
+        const std::string* name =
+            encoding->second.get_ptr<const std::string*>();
+        if (name == nullptr || (*name != "json" && *name != "cbor"))
+        {
+            return false;
+        }
+        options.cbor = *name == "cbor";
+    }
+    return true;
+}
+
+// Sends the D-Bus events of a /subscribe websocket.  When batching, events
+// wait until the coalesce window after the first one has passed, and until the
+// message rate allows another message, then all of them are sent as one JSON
+// array.  PropertiesChanged events for a path and interface that is already
+// waiting are merged into it, keeping the latest value of each property.  A
+// subscriber that can't keep up with the other events is closed once
+// maxPendingEvents are waiting.
+class DbusEventBatcher : public std::enable_shared_from_this<DbusEventBatcher>
+{
+  public:
+    DbusEventBatcher(crow::websocket::Connection& connIn,
+                     const DbusEventBatchOptions& optionsIn) :
+        conn(connIn), options(optionsIn), timer(getIoContext())
+    {}
+
+    ~DbusEventBatcher()
+    {
+        BMCWEB_LOG_DEBUG(
+            "conn:{}, D-Bus monitor got {} events, coalesced {}, sent {} "
+            "messages",
+            logPtr(&conn), stats.eventsReceived, stats.eventsCoalesced,
+            stats.messagesSent);
+    }
+
+    DbusEventBatcher(const DbusEventBatcher&) = delete;
+    DbusEventBatcher(DbusEventBatcher&&) = delete;
+    DbusEventBatcher& operator=(const DbusEventBatcher&) = delete;
+    DbusEventBatcher& operator=(DbusEventBatcher&&) = delete;
+
+    // Most events waiting to be sent before the subscriber is closed
+    static constexpr size_t maxPendingEvents = 1000;
+
+    void addEvent(nlohmann::json::object_t&& event)
+    {
+        if (closed)
+        {
+            return;
+        }
+        stats.eventsReceived++;
+        if (!options.batching())
+        {
+            send(nlohmann::json(std::move(event)));
+            return;
+        }
+
+        if (!mergeEvent(event))
+        {
+            if (pending.size() >= maxPendingEvents)
+            {
+                BMCWEB_LOG_WARNING(
+                    "conn:{}, {} D-Bus events waiting, closing the monitor",
+                    logPtr(&conn), pending.size());
+                closeMonitor();
+                return;
+            }
+            pending.emplace_back(std::move(event));
+        }
+        if (!timerRunning)
+        {
+            startTimer();
+        }
+    }
+
+    const DbusEventBatchStats& getStats() const
+    {
+        return stats;
+    }
+
+  private:
+    void closeMonitor()
+    {
+        closed = true;
+        timer.cancel();
+        pending.clear();
+        propertyEvents.clear();
+        conn.close("Too many events waiting to be sent");
+    }
+
+    // Merges a PropertiesChanged event into a waiting one for the same path
+    // and interface.  Returns false if there was none.
+    bool mergeEvent(nlohmann::json::object_t& event)
+    {
+        const std::string* member = getString(event, "event");
+        const std::string* path = getString(event, "path");
+        const std::string* interface = getString(event, "interface");
+        if (member == nullptr || *member != "PropertiesChanged" ||
+            path == nullptr || interface == nullptr)
+        {
+            return false;
+        }
+        auto propertiesIt = event.find("properties");
+        if (propertiesIt == event.end())
+        {
+            return false;
+        }
+        nlohmann::json::object_t* properties =
+            propertiesIt->second.get_ptr<nlohmann::json::object_t*>();
+        if (properties == nullptr)
+        {
+            return false;
+        }
+
+        auto [it, inserted] =
+            propertyEvents.try_emplace(*path + '\0' + *interface, 0);
+        if (inserted)
+        {
+            it->second = pending.size();
+            return false;
+        }
+        nlohmann::json& waiting = pending[it->second]["properties"];
+        for (auto& [name, value] : *properties)
+        {
+            waiting[name] = std::move(value);
+        }
+        stats.eventsCoalesced++;
+        return true;
+    }
+
+    static const std::string* getString(const nlohmann::json::object_t& event,
+                                        const char* key)
+    {
+        auto it = event.find(key);
+        if (it == event.end())
+        {
+            return nullptr;
+        }
+        return it->second.get_ptr<const std::string*>();
+    }
+
+    void startTimer()
+    {
+        std::chrono::steady_clock::time_point sendTime =
+            std::chrono::steady_clock::now() + options.coalesceWindow;
+        if (options.maxMessageRate > 0 && stats.messagesSent > 0)
+        {
+            std::chrono::steady_clock::time_point allowed =
+                lastSend + std::chrono::microseconds(1000000) /
+                               options.maxMessageRate;
+            sendTime = std::max(sendTime, allowed);
+        }
+        timerRunning = true;
+        timer.expires_at(sendTime);
+        timer.async_wait(std::bind_front(&DbusEventBatcher::onTimer,
+                                         weak_from_this()));
+    }
+
+    static void onTimer(const std::weak_ptr<DbusEventBatcher>& weak,
+                        const boost::system::error_code& ec)
+    {
+        if (ec == boost::asio::error::operation_aborted)
+        {
+            return;
+        }
+        std::shared_ptr<DbusEventBatcher> self = weak.lock();
+        if (self == nullptr)
+        {
+            return;
+        }
+        self->timerRunning = false;
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR("D-Bus monitor timer failed: {}", ec.message());
+        }
+        self->flush();
+    }
+
+    void flush()
+    {
+        if (pending.empty())
+        {
+            return;
+        }
+        nlohmann::json::array_t events;
+        events.reserve(pending.size());
+        for (nlohmann::json::object_t& event : pending)
+        {
+            events.emplace_back(std::move(event));
+        }
+        pending.clear();
+        propertyEvents.clear();
+        lastSend = std::chrono::steady_clock::now();
+        send(nlohmann::json(std::move(events)));
+    }
+
+    void send(const nlohmann::json& message)
+    {
+        stats.messagesSent++;
+        if (options.cbor)
+        {
+            std::string out;
+            nlohmann::json::to_cbor(message, out);
+            conn.sendBinary(out);
+            return;
+        }
+        conn.sendText(message.dump(2, ' ', true,
+                                   nlohmann::json::error_handler_t::replace));
+    }
+
+    crow::websocket::Connection& conn;
+    DbusEventBatchOptions options;
+    boost::asio::steady_timer timer;
+    bool timerRunning = false;
+    bool closed = false;
+    std::chrono::steady_clock::time_point lastSend;
+
+    std::vector<nlohmann::json::object_t> pending;
+    // Index in pending of the PropertiesChanged event for a path and interface
+    boost::container::flat_map<std::string, size_t> propertyEvents;
+
+    DbusEventBatchStats stats;
+};
+
+} // namespace dbus_monitor
+} // namespace crow
@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "dbus_event_batcher.hpp"
+#include "io_context_singleton.hpp"
+#include "websocket.hpp"
+
+#include <boost/url/url_view.hpp>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace crow::dbus_monitor
+{
+namespace
+{
+
+class MonitorClient : public crow::websocket::Connection
+{
+  public:
+    void sendBinary(std::string_view msg) override
+    {
+        messages.emplace_back(nlohmann::json::from_cbor(msg));
+    }
+
+    void sendEx(crow::websocket::MessageType /*type*/,
+                std::string_view /*msg*/,
+                std::function<void()>&& onDone) override
+    {
+        ADD_FAILURE() << "sendEx used by the monitor";
+        onDone();
+    }
+
+    void sendText(std::string_view msg) override
+    {
+        messages.emplace_back(nlohmann::json::parse(msg));
+    }
+
+    void close(std::string_view msg) override
+    {
+        closeReason = msg;
+    }
+
+    void deferRead() override {}
+
+    void resumeRead() override {}
+
+    boost::urls::url_view url() override
+    {
+        return {};
+    }
+
+    std::vector<nlohmann::json> messages;
+    std::string closeReason;
+};
+
+nlohmann::json::object_t propertiesChanged(const std::string& path,
+                                           const std::string& property,
+                                           double value)
+{
+    nlohmann::json::object_t event;
+    event["event"] = "PropertiesChanged";
+    event["path"] = path;
+    event["interface"] = "xyz.openbmc_project.Sensor.Value";
+    event["properties"][property] = value;
+    return event;
+}
+
+nlohmann::json::object_t parseRequest(std::string_view request)
+{
+    return nlohmann::json::parse(request).get<nlohmann::json::object_t>();
+}
+
+void runFor(std::chrono::milliseconds duration)
+{
+    getIoContext().restart();
+    getIoContext().run_for(duration);
+}
+
+TEST(DbusEventBatcher, SendsEachEventWithoutBatching)
+{
+    MonitorClient client;
+    auto batcher =
+        std::make_shared<DbusEventBatcher>(client, DbusEventBatchOptions{});
+    batcher->addEvent(propertiesChanged("/fan0", "Value", 1000.0));
+    batcher->addEvent(propertiesChanged("/fan0", "Value", 2000.0));
+
+    ASSERT_EQ(client.messages.size(), 2U);
+    EXPECT_EQ(client.messages[0]["path"], "/fan0");
+    EXPECT_EQ(client.messages[1]["properties"]["Value"], 2000.0);
+}
+
+TEST(DbusEventBatcher, CoalescesLatestValues)
+{
+    MonitorClient client;
+    DbusEventBatchOptions options;
+    options.coalesceWindow = std::chrono::milliseconds(10);
+    auto batcher = std::make_shared<DbusEventBatcher>(client, options);
+
+    batcher->addEvent(propertiesChanged("/fan0", "Value", 1000.0));
+    batcher->addEvent(propertiesChanged("/fan1", "Value", 500.0));
+    batcher->addEvent(propertiesChanged("/fan0", "MaxValue", 9000.0));
+    batcher->addEvent(propertiesChanged("/fan0", "Value", 3000.0));
+    nlohmann::json::object_t added;
+    added["event"] = "InterfacesAdded";
+    added["path"] = "/fan2";
+    batcher->addEvent(std::move(added));
+    EXPECT_TRUE(client.messages.empty());
+
+    runFor(std::chrono::milliseconds(100));
+    ASSERT_EQ(client.messages.size(), 1U);
+    const nlohmann::json& events = client.messages[0];
+    ASSERT_EQ(events.size(), 3U);
+    EXPECT_EQ(events[0]["path"], "/fan0");
+    EXPECT_EQ(events[0]["properties"]["Value"], 3000.0);
+    EXPECT_EQ(events[0]["properties"]["MaxValue"], 9000.0);
+    EXPECT_EQ(events[1]["path"], "/fan1");
+    EXPECT_EQ(events[2]["event"], "InterfacesAdded");
+
+    const DbusEventBatchStats& stats = batcher->getStats();
+    EXPECT_EQ(stats.eventsReceived, 5U);
+    EXPECT_EQ(stats.eventsCoalesced, 2U);
+    EXPECT_EQ(stats.messagesSent, 1U);
+}
+
+TEST(DbusEventBatcher, LimitsMessageRate)
+{
+    MonitorClient client;
+    DbusEventBatchOptions options;
+    options.maxMessageRate = 5;
+    auto batcher = std::make_shared<DbusEventBatcher>(client, options);
+
+    batcher->addEvent(propertiesChanged("/fan0", "Value", 1.0));
+    runFor(std::chrono::milliseconds(20));
+    ASSERT_EQ(client.messages.size(), 1U);
+
+    // The next message has to wait 200ms after the first
+    batcher->addEvent(propertiesChanged("/fan0", "Value", 2.0));
+    batcher->addEvent(propertiesChanged("/fan1", "Value", 3.0));
+    runFor(std::chrono::milliseconds(100));
+    EXPECT_EQ(client.messages.size(), 1U);
+    runFor(std::chrono::milliseconds(200));
+    ASSERT_EQ(client.messages.size(), 2U);
+    EXPECT_EQ(client.messages[1].size(), 2U);
+}
+
+TEST(DbusEventBatcher, SendsCbor)
+{
+    MonitorClient client;
+    DbusEventBatchOptions options;
+    options.cbor = true;
+    auto batcher = std::make_shared<DbusEventBatcher>(client, options);
+
+    batcher->addEvent(propertiesChanged("/fan0", "Value", 1000.0));
+    ASSERT_EQ(client.messages.size(), 1U);
+    EXPECT_EQ(client.messages[0],
+              nlohmann::json(propertiesChanged("/fan0", "Value", 1000.0)));
+}
+
+TEST(DbusEventBatcher, ParseBatchOptions)
+{
+    DbusEventBatchOptions options;
+    nlohmann::json::object_t request =
+        parseRequest(R"({"paths": ["/"], "coalesce_ms": 250, "max_rate": 4,
+                         "encoding": "cbor"})");
+    ASSERT_TRUE(parseBatchOptions(request, options));
+    EXPECT_EQ(options.coalesceWindow, std::chrono::milliseconds(250));
+    EXPECT_EQ(options.maxMessageRate, 4U);
+    EXPECT_TRUE(options.cbor);
+    EXPECT_TRUE(options.batching());
+
+    DbusEventBatchOptions defaults;
+    ASSERT_TRUE(parseBatchOptions(parseRequest(R"({"paths": []})"), defaults));
+    EXPECT_FALSE(defaults.batching());
+    EXPECT_FALSE(defaults.cbor);
+
+    EXPECT_FALSE(
+        parseBatchOptions(parseRequest(R"({"coalesce_ms": -1})"), defaults));
+    EXPECT_FALSE(parseBatchOptions(parseRequest(R"({"coalesce_ms": 60001})"),
+                                   defaults));
+    EXPECT_FALSE(
+        parseBatchOptions(parseRequest(R"({"max_rate": "fast"})"), defaults));
+    EXPECT_FALSE(
+        parseBatchOptions(parseRequest(R"({"encoding": "xml"})"), defaults));
+}
+
+TEST(DbusEventBatcher, SensorChurn)
+{
+    // Synthetic fan and sensor churn: 100 sensors changing 200 times each
+    constexpr size_t sensors = 100;
+    constexpr size_t rounds = 200;
+    MonitorClient client;
+    DbusEventBatchOptions options;
+    options.coalesceWindow = std::chrono::milliseconds(50);
+    auto batcher = std::make_shared<DbusEventBatcher>(client, options);
+
+    for (size_t round = 0; round < rounds; round++)
+    {
+        for (size_t sensor = 0; sensor < sensors; sensor++)
+        {
+            batcher->addEvent(
+                propertiesChanged(std::format("/sensor{}", sensor), "Value",
+                                  static_cast<double>(round)));
+        }
+    }
+    runFor(std::chrono::milliseconds(200));
+
+    ASSERT_EQ(client.messages.size(), 1U);
+    ASSERT_EQ(client.messages[0].size(), sensors);
+    EXPECT_EQ(client.messages[0][0]["properties"]["Value"],
+              static_cast<double>(rounds - 1));
+    EXPECT_EQ(batcher->getStats().eventsCoalesced, sensors * (rounds - 1));
+}
+
+TEST(DbusEventBatcher, ClosesWhenTooManyEventsWait)
+{
+    MonitorClient client;
+    DbusEventBatchOptions options;
+    options.maxMessageRate = 1;
+    auto batcher = std::make_shared<DbusEventBatcher>(client, options);
+
+    // Rate limited, so events other than PropertiesChanged pile up
+    for (size_t index = 0; index < DbusEventBatcher::maxPendingEvents; index++)
+    {
+        nlohmann::json::object_t added;
+        added["event"] = "InterfacesAdded";
+        added["path"] = std::format("/object{}", index);
+        batcher->addEvent(std::move(added));
+    }
+    EXPECT_TRUE(client.closeReason.empty());
+
+    nlohmann::json::object_t added;
+    added["event"] = "InterfacesAdded";
+    added["path"] = "/one_too_many";
+    batcher->addEvent(std::move(added));
+    EXPECT_EQ(client.closeReason, "Too many events waiting to be sent");
+
+    // Nothing more is sent once closed
+    batcher->addEvent(propertiesChanged("/fan0", "Value", 1.0));
+    runFor(std::chrono::milliseconds(100));
+    EXPECT_TRUE(client.messages.empty());
+}
+
+} // namespace
+} // namespace crow::dbus_monitor
@@ -0,0 +1,379 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include <tinyxml2.h>
+
+#include <boost/container/flat_map.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+namespace openbmc_mapper
+{
+
+// Attributes missing from the introspection XML are left empty
+struct IntrospectedArg
+{
+    std::string name;
+    std::string direction;
+    std::string type;
+};
+
+struct IntrospectedMethod
+{
+    std::string name;
+    std::vector<IntrospectedArg> args;
+    // Types of the arguments with direction "in", in call order
+    std::vector<std::string> inputTypes;
+    // Type of the first argument with direction "out", or empty
+    std::string returnType;
+};
+
+struct IntrospectedSignal
+{
+    std::string name;
+    std::vector<IntrospectedArg> args;
+};
+
+struct IntrospectedProperty
+{
+    std::string name;
+    std::string type;
+};
+
+struct IntrospectedInterface
+{
+    std::string name;
+    std::vector<IntrospectedMethod> methods;
+    std::vector<IntrospectedSignal> signals;
+    std::vector<IntrospectedProperty> properties;
+
+    const IntrospectedMethod* findMethod(std::string_view methodName) const
+    {
+        for (const IntrospectedMethod& method : methods)
+        {
+            if (method.name == methodName)
+            {
+                return &method;
+            }
+        }
+        return nullptr;
+    }
+
+    const IntrospectedProperty* findProperty(
+        std::string_view propertyName) const
+    {
+        for (const IntrospectedProperty& property : properties)
+        {
+            if (property.name == propertyName)
+            {
+                return &property;
+            }
+        }
+        return nullptr;
+    }
+};
+
+// The result of org.freedesktop.DBus.Introspectable.Introspect on one object
+struct IntrospectedObject
+{
+    std::vector<IntrospectedInterface> interfaces;
+    // Names of the child nodes, relative to the object
+    std::vector<std::string> children;
+
+    const IntrospectedInterface* findInterface(
+        std::string_view interfaceName) const
+    {
+        for (const IntrospectedInterface& interface : interfaces)
+        {
+            if (interface.name == interfaceName)
+            {
+                return &interface;
+            }
+        }
+        return nullptr;
+    }
+};
+
+inline std::string getIntrospectionAttribute(
+    const tinyxml2::XMLElement& element, const char* name)
+{
+    const char* value = element.Attribute(name);
+    if (value == nullptr)
+    {
+        return {};
+    }
+    return value;
+}
+
+inline std::vector<IntrospectedArg> parseIntrospectedArgs(
+    const tinyxml2::XMLElement& parent)
+{
+    std::vector<IntrospectedArg> args;
+    const tinyxml2::XMLElement* arg = parent.FirstChildElement("arg");
+    while (arg != nullptr)
+    {
+        IntrospectedArg& parsed = args.emplace_back();
+        parsed.name = getIntrospectionAttribute(*arg, "name");
+        parsed.direction = getIntrospectionAttribute(*arg, "direction");
+        parsed.type = getIntrospectionAttribute(*arg, "type");
+        arg = arg->NextSiblingElement("arg");
+    }
+    return args;
+}
+
+inline IntrospectedInterface parseIntrospectedInterface(
+    const tinyxml2::XMLElement& element, std::string&& name)
+{
+    IntrospectedInterface interface;
+    interface.name = std::move(name);
+
+    const tinyxml2::XMLElement* method = element.FirstChildElement("method");
+    while (method != nullptr)
+    {
+        std::string methodName = getIntrospectionAttribute(*method, "name");
+        if (!methodName.empty())
+        {
+            IntrospectedMethod& parsed = interface.methods.emplace_back();
+            parsed.name = std::move(methodName);
+            parsed.args = parseIntrospectedArgs(*method);
+            for (const IntrospectedArg& arg : parsed.args)
+            {
+                if (arg.type.empty())
+                {
+                    continue;
+                }
+                if (arg.direction == "in")
+                {
+                    parsed.inputTypes.emplace_back(arg.type);
+                }
+                else if (arg.direction == "out" && parsed.returnType.empty())
+                {
+                    parsed.returnType = arg.type;
+                }
+            }
+        }
+        method = method->NextSiblingElement("method");
+    }
+
+    const tinyxml2::XMLElement* signal = element.FirstChildElement("signal");
+    while (signal != nullptr)
+    {
+        std::string signalName = getIntrospectionAttribute(*signal, "name");
+        if (!signalName.empty())
+        {
+            IntrospectedSignal& parsed = interface.signals.emplace_back();
+            parsed.name = std::move(signalName);
+            parsed.args = parseIntrospectedArgs(*signal);
+        }
+        signal = signal->NextSiblingElement("signal");
+    }
+
+    const tinyxml2::XMLElement* property =
+        element.FirstChildElement("property");
+    while (property != nullptr)
+    {
+        std::string propertyName = getIntrospectionAttribute(*property, "name");
+        std::string type = getIntrospectionAttribute(*property, "type");
+        if (!propertyName.empty() && !type.empty())
+        {
+            IntrospectedProperty& parsed = interface.properties.emplace_back();
+            parsed.name = std::move(propertyName);
+            parsed.type = std::move(type);
+        }
+        property = property->NextSiblingElement("property");
+    }
+    return interface;
+}
+
+// Parses the XML returned by Introspect once, so requests can look up
+// interfaces, method signatures and property types without touching XML.
+// Returns nullptr if the document has no root node.
+inline std::shared_ptr<IntrospectedObject> parseIntrospection(
+    std::string_view introspectXml)
+{
+    tinyxml2::XMLDocument doc;
+    doc.Parse(introspectXml.data(), introspectXml.size());
+    const tinyxml2::XMLElement* root = doc.FirstChildElement("node");
+    if (root == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto object = std::make_shared<IntrospectedObject>();
+    const tinyxml2::XMLElement* interface =
+        root->FirstChildElement("interface");
+    while (interface != nullptr)
+    {
+        std::string name = getIntrospectionAttribute(*interface, "name");
+        if (!name.empty())
+        {
+            object->interfaces.emplace_back(
+                parseIntrospectedInterface(*interface, std::move(name)));
+        }
+        interface = interface->NextSiblingElement("interface");
+    }
+
+    const tinyxml2::XMLElement* node = root->FirstChildElement("node");
+    while (node != nullptr)
+    {
+        std::string name = getIntrospectionAttribute(*node, "name");
+        if (!name.empty())
+        {
+            object->children.emplace_back(std::move(name));
+        }
+        node = node->NextSiblingElement("node");
+    }
+    return object;
+}
+
+// Parsed introspection data keyed by object path and service.  Entries are
+// immutable and shared, so a request keeps using the data it looked up even
+// if the entry is dropped meanwhile.
+//
+// An object's data goes stale when its service restarts, or when objects are
+// added or removed at or below it, which changes its interfaces or children.
+// The owner drops entries on those signals, which arrive for every object and
+// client on the bus, so both are looked up directly instead of scanning the
+// cache.  When the cache is full it is emptied, which only costs a fresh
+// Introspect of each object.
+class IntrospectionCache
+{
+  public:
+    explicit IntrospectionCache(size_t maxEntriesIn) : maxEntries(maxEntriesIn)
+    {}
+
+    std::shared_ptr<const IntrospectedObject> find(std::string_view service,
+                                                   std::string_view path) const
+    {
+        auto pathIt = entries.find(path);
+        if (pathIt == entries.end())
+        {
+            return nullptr;
+        }
+        auto it = pathIt->second.find(service);
+        if (it == pathIt->second.end())
+        {
+            return nullptr;
+        }
+        return it->second;
+    }
+
+    void insert(std::string_view service, std::string_view path,
+                std::shared_ptr<const IntrospectedObject> object)
+    {
+        if (entryCount >= maxEntries)
+        {
+            entries.clear();
+            serviceEntries.clear();
+            entryCount = 0;
+        }
+        auto pathIt = entries.find(path);
+        if (pathIt == entries.end())
+        {
+            pathIt = entries.try_emplace(std::string(path)).first;
+        }
+        auto [it, inserted] =
+            pathIt->second.insert_or_assign(std::string(service),
+                                            std::move(object));
+        if (inserted)
+        {
+            serviceEntries[it->first]++;
+            entryCount++;
+        }
+    }
+
+    // The service started, stopped or changed owner
+    void invalidateService(std::string_view service)
+    {
+        auto serviceIt = serviceEntries.find(service);
+        if (serviceIt == serviceEntries.end())
+        {
+            return;
+        }
+        serviceEntries.erase(serviceIt);
+        auto pathIt = entries.begin();
+        while (pathIt != entries.end())
+        {
+            auto it = pathIt->second.find(service);
+            if (it != pathIt->second.end())
+            {
+                pathIt->second.erase(it);
+                entryCount--;
+            }
+            if (pathIt->second.empty())
+            {
+                pathIt = entries.erase(pathIt);
+                continue;
+            }
+            pathIt++;
+        }
+    }
+
+    // Objects were added or removed at path.  Any service may have changed,
+    // and the parents of path may have gained or lost a child node.
+    void invalidatePath(std::string_view path)
+    {
+        while (true)
+        {
+            erasePath(path);
+            size_t slash = path.rfind('/');
+            if (path.size() <= 1 || slash == std::string_view::npos)
+            {
+                return;
+            }
+            path = path.substr(0, slash == 0 ? 1 : slash);
+        }
+    }
+
+    size_t size() const
+    {
+        return entryCount;
+    }
+
+  private:
+    void erasePath(std::string_view path)
+    {
+        auto pathIt = entries.find(path);
+        if (pathIt == entries.end())
+        {
+            return;
+        }
+        for (const auto& [service, object] : pathIt->second)
+        {
+            auto serviceIt = serviceEntries.find(service);
+            if (serviceIt != serviceEntries.end() && --serviceIt->second == 0)
+            {
+                serviceEntries.erase(serviceIt);
+            }
+        }
+        entryCount -= pathIt->second.size();
+        entries.erase(pathIt);
+    }
+
+    size_t maxEntries;
+    size_t entryCount = 0;
+    // Object path, then service
+    boost::container::flat_map<
+        std::string,
+        boost::container::flat_map<
+            std::string, std::shared_ptr<const IntrospectedObject>,
+            std::less<>>,
+        std::less<>>
+        entries;
+    // Number of entries of each service, so that services with nothing cached
+    // are skipped
+    boost::container::flat_map<std::string, size_t, std::less<>>
+        serviceEntries;
+};
+
+} // namespace openbmc_mapper
+} // namespace crow
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "dbus_introspection.hpp"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace crow::openbmc_mapper
+{
+namespace
+{
+
+constexpr std::string_view fanXml = R"(
+<!DOCTYPE node PUBLIC "-//freedesktop//DTD D-BUS Object Introspection 1.0//EN"
+"http://www.freedesktop.org/standards/dbus/1.0/introspect.dtd">
+<node>
+ <interface name="xyz.openbmc_project.Control.FanPwm">
+  <method name="Calibrate">
+   <arg name="speed" type="t" direction="in"/>
+   <arg name="curve" type="ad" direction="in"/>
+   <arg name="result" type="s" direction="out"/>
+   <arg name="extra" type="u" direction="out"/>
+  </method>
+  <method name="Reset"/>
+  <signal name="Stalled">
+   <arg name="rpm" type="t"/>
+   <arg type="s"/>
+  </signal>
+  <property name="Target" type="t" access="readwrite"/>
+  <property name="NoType" access="read"/>
+ </interface>
+ <interface name="org.freedesktop.DBus.Properties">
+ </interface>
+ <node name="fan0"/>
+ <node name="fan1"/>
+</node>
+)";
+
+std::shared_ptr<const IntrospectedObject> makeObject(const char* child)
+{
+    auto object = std::make_shared<IntrospectedObject>();
+    object->children.emplace_back(child);
+    return object;
+}
+
+TEST(DbusIntrospection, ParsesInterfaces)
+{
+    std::shared_ptr<const IntrospectedObject> object =
+        parseIntrospection(fanXml);
+    ASSERT_NE(object, nullptr);
+    ASSERT_EQ(object->interfaces.size(), 2U);
+    EXPECT_EQ(object->children, (std::vector<std::string>{"fan0", "fan1"}));
+
+    const IntrospectedInterface* fan =
+        object->findInterface("xyz.openbmc_project.Control.FanPwm");
+    ASSERT_NE(fan, nullptr);
+    EXPECT_EQ(object->findInterface("xyz.openbmc_project.Missing"), nullptr);
+
+    const IntrospectedMethod* calibrate = fan->findMethod("Calibrate");
+    ASSERT_NE(calibrate, nullptr);
+    ASSERT_EQ(calibrate->args.size(), 4U);
+    EXPECT_EQ(calibrate->args[0].name, "speed");
+    EXPECT_EQ(calibrate->args[0].direction, "in");
+    EXPECT_EQ(calibrate->inputTypes, (std::vector<std::string>{"t", "ad"}));
+    EXPECT_EQ(calibrate->returnType, "s");
+
+    const IntrospectedMethod* reset = fan->findMethod("Reset");
+    ASSERT_NE(reset, nullptr);
+    EXPECT_TRUE(reset->inputTypes.empty());
+    EXPECT_TRUE(reset->returnType.empty());
+
+    ASSERT_EQ(fan->signals.size(), 1U);
+    ASSERT_EQ(fan->signals[0].args.size(), 2U);
+    EXPECT_TRUE(fan->signals[0].args[1].name.empty());
+
+    // Properties without a type can't be set, so they are left out
+    ASSERT_EQ(fan->properties.size(), 1U);
+    const IntrospectedProperty* target = fan->findProperty("Target");
+    ASSERT_NE(target, nullptr);
+    EXPECT_EQ(target->type, "t");
+}
+
+TEST(DbusIntrospection, RejectsDocumentWithoutNode)
+{
+    EXPECT_EQ(parseIntrospection(""), nullptr);
+    EXPECT_EQ(parseIntrospection("<interface name=\"a.b\"/>"), nullptr);
+}
+
+TEST(IntrospectionCache, InvalidatesService)
+{
+    IntrospectionCache cache(16);
+    cache.insert("xyz.openbmc_project.Fan", "/", makeObject("a"));
+    cache.insert("xyz.openbmc_project.Fan", "/fan0", makeObject("b"));
+    cache.insert("xyz.openbmc_project.FanControl", "/", makeObject("c"));
+    EXPECT_EQ(cache.size(), 3U);
+    ASSERT_NE(cache.find("xyz.openbmc_project.Fan", "/fan0"), nullptr);
+    EXPECT_EQ(cache.find("xyz.openbmc_project.Fan", "/fan1"), nullptr);
+
+    // Services that share a prefix are kept
+    cache.invalidateService("xyz.openbmc_project.Fan");
+    EXPECT_EQ(cache.size(), 1U);
+    EXPECT_EQ(cache.find("xyz.openbmc_project.Fan", "/"), nullptr);
+    EXPECT_NE(cache.find("xyz.openbmc_project.FanControl", "/"), nullptr);
+}
+
+TEST(IntrospectionCache, InvalidatesPathAndParents)
+{
+    IntrospectionCache cache(16);
+    for (const char* path :
+         {"/", "/xyz", "/xyz/fan", "/xyz/fan/fan0", "/xyz/fan/fan01",
+          "/xyz/fan/fan0/pwm", "/xyz/fans"})
+    {
+        cache.insert("a.b", path, makeObject("x"));
+    }
+    cache.insert("c.d", "/xyz/fan/fan0", makeObject("x"));
+
+    cache.invalidatePath("/xyz/fan/fan0");
+    EXPECT_EQ(cache.find("a.b", "/"), nullptr);
+    EXPECT_EQ(cache.find("a.b", "/xyz"), nullptr);
+    EXPECT_EQ(cache.find("a.b", "/xyz/fan"), nullptr);
+    EXPECT_EQ(cache.find("a.b", "/xyz/fan/fan0"), nullptr);
+    EXPECT_EQ(cache.find("c.d", "/xyz/fan/fan0"), nullptr);
+    EXPECT_NE(cache.find("a.b", "/xyz/fan/fan01"), nullptr);
+    EXPECT_NE(cache.find("a.b", "/xyz/fan/fan0/pwm"), nullptr);
+    EXPECT_NE(cache.find("a.b", "/xyz/fans"), nullptr);
+    EXPECT_EQ(cache.size(), 3U);
+
+    // Services with nothing left cached are forgotten
+    cache.invalidateService("c.d");
+    EXPECT_EQ(cache.size(), 3U);
+    cache.invalidateService("a.b");
+    EXPECT_EQ(cache.size(), 0U);
+}
+
+TEST(IntrospectionCache, EmptiesWhenFull)
+{
+    IntrospectionCache cache(2);
+    std::shared_ptr<const IntrospectedObject> first = makeObject("a");
+    cache.insert("a.b", "/a", first);
+    cache.insert("a.b", "/b", makeObject("b"));
+    cache.insert("a.b", "/c", makeObject("c"));
+    EXPECT_EQ(cache.size(), 1U);
+    EXPECT_EQ(cache.find("a.b", "/a"), nullptr);
+    EXPECT_NE(cache.find("a.b", "/c"), nullptr);
+
+    // Data handed out earlier stays valid
+    EXPECT_EQ(first->children[0], "a");
+}
+
+} // namespace
+} // namespace crow::openbmc_mapper
@@ -2,6 +2,7 @@
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #pragma once
 #include "app.hpp"
+#include "dbus_event_batcher.hpp"
 #include "dbus_singleton.hpp"
 #include "logging.hpp"
 #include "openbmc_dbus_rest.hpp"
@@ -21,6 +22,7 @@
 #include <memory>
 #include <regex>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace crow
@@ -34,6 +36,8 @@ struct DbusWebsocketSession
     boost::container::flat_set<std::string, std::less<>,
                                std::vector<std::string>>
         interfaces;
+    // Created with the options of the first subscribe request
+    std::shared_ptr<DbusEventBatcher> batcher;
 };
 
 using SessionMap = boost::container::flat_map<crow::websocket::Connection*,
@@ -126,8 +130,13 @@ inline int onPropertyUpdate(sd_bus_message* m, void* userdata,
         return 0;
     }
 
-    connection->sendText(
-        json.dump(2, ' ', true, nlohmann::json::error_handler_t::replace));
+    nlohmann::json::object_t* event =
+        json.get_ptr<nlohmann::json::object_t*>();
+    if (event == nullptr || thisSession->second.batcher == nullptr)
+    {
+        return 0;
+    }
+    thisSession->second.batcher->addEvent(std::move(*event));
     return 0;
 }
 
@@ -168,6 +177,19 @@ inline void requestRoutes(App& app)
                 conn.close("Unable to parse json request");
                 return;
             }
+            if (thisSession.batcher == nullptr)
+            {
+                DbusEventBatchOptions options;
+                if (!parseBatchOptions(*obj, options))
+                {
+                    BMCWEB_LOG_ERROR("Invalid batching options for monitor");
+                    conn.close("Invalid batching options");
+                    return;
+                }
+                thisSession.batcher =
+                    std::make_shared<DbusEventBatcher>(conn, options);
+            }
+
             nlohmann::json::object_t::iterator interfaces =
                 obj->find("interfaces");
             if (interfaces != obj->end())
@@ -6,6 +6,7 @@
 #include "app.hpp"
 #include "async_resp.hpp"
 #include "boost_formatters.hpp"
+#include "dbus_introspection.hpp"
 #include "dbus_singleton.hpp"
 #include "dbus_utility.hpp"
 #include "http_request.hpp"
@@ -17,7 +18,6 @@
 
 #include <systemd/sd-bus-protocol.h>
 #include <systemd/sd-bus.h>
-#include <tinyxml2.h>
 
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/status.hpp>
@@ -26,12 +26,15 @@
 #include <boost/system/error_code.hpp>
 #include <nlohmann/json.hpp>
 #include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/exception.hpp>
 #include <sdbusplus/message.hpp>
 #include <sdbusplus/message/native_types.hpp>
 
 #include <algorithm>
 #include <array>
 #include <cerrno>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <filesystem>
@@ -92,6 +95,113 @@ inline void setErrorResponse(crow::Response& res,
     res.jsonValue["status"] = "error";
 }
 
+// Most objects whose parsed introspection data is kept
+constexpr size_t introspectionCacheSize = 4096;
+
+inline IntrospectionCache& getIntrospectionCache()
+{
+    static IntrospectionCache cache(introspectionCacheSize);
+    return cache;
+}
+
+inline void onIntrospectedServiceChanged(sdbusplus::message_t& msg)
+{
+    std::string name;
+    try
+    {
+        msg.read(name);
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        BMCWEB_LOG_ERROR("Failed to read NameOwnerChanged signal: {}",
+                         e.what());
+        return;
+    }
+    getIntrospectionCache().invalidateService(name);
+}
+
+inline void onIntrospectedObjectsChanged(sdbusplus::message_t& msg)
+{
+    sdbusplus::message::object_path path;
+    try
+    {
+        msg.read(path);
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        BMCWEB_LOG_ERROR("Failed to read {} signal: {}", msg.get_member(),
+                         e.what());
+        return;
+    }
+    getIntrospectionCache().invalidatePath(path.str);
+}
+
+// Drops cached introspection data when it may have gone stale.  The matches
+// belong to the bus they were added on, so this must not outlive it.
+class IntrospectionCacheMonitor
+{
+  public:
+    explicit IntrospectionCacheMonitor(sdbusplus::bus_t& bus) :
+        nameOwnerChangedMatch(bus, sdbusplus::match_rules::nameOwnerChanged(),
+                              onIntrospectedServiceChanged),
+        interfacesAddedMatch(bus, sdbusplus::match_rules::interfacesAdded(),
+                             onIntrospectedObjectsChanged),
+        interfacesRemovedMatch(bus,
+                               sdbusplus::match_rules::interfacesRemoved(),
+                               onIntrospectedObjectsChanged)
+    {}
+
+  private:
+    sdbusplus::bus::match_t nameOwnerChangedMatch;
+    sdbusplus::bus::match_t interfacesAddedMatch;
+    sdbusplus::bus::match_t interfacesRemovedMatch;
+};
+
+// Introspects an object, or hands back the cached result.  The object is
+// nullptr without an error code if the XML could not be parsed.
+inline void introspect(
+    const std::string& processName, const std::string& objectPath,
+    std::function<void(const boost::system::error_code&,
+                       const std::shared_ptr<const IntrospectedObject>&)>&&
+        callback)
+{
+    std::shared_ptr<const IntrospectedObject> cached =
+        getIntrospectionCache().find(processName, objectPath);
+    if (cached != nullptr)
+    {
+        callback(boost::system::error_code(), cached);
+        return;
+    }
+
+    dbus::utility::async_method_call(
+        [processName, objectPath, callback{std::move(callback)}](
+            const boost::system::error_code& ec,
+            const std::string& introspectXml) {
+            if (ec)
+            {
+                BMCWEB_LOG_ERROR(
+                    "Introspect call failed with error: {} on process: {} path: {}",
+                    ec.message(), processName, objectPath);
+                callback(ec, nullptr);
+                return;
+            }
+            BMCWEB_LOG_DEBUG("got xml:\n {}", introspectXml);
+            std::shared_ptr<const IntrospectedObject> object =
+                parseIntrospection(introspectXml);
+            if (object == nullptr)
+            {
+                BMCWEB_LOG_ERROR("XML document failed to parse {} {}",
+                                 processName, objectPath);
+                callback(ec, nullptr);
+                return;
+            }
+            getIntrospectionCache().insert(processName, objectPath, object);
+            callback(ec, object);
+        },
+        processName, objectPath, "org.freedesktop.DBus.Introspectable",
+        "Introspect");
+}
+
 inline void introspectObjects(
     const std::string& processName, const std::string& objectPath,
     const std::shared_ptr<bmcweb::AsyncResp>& transaction)
@@ -103,57 +213,38 @@ inline void introspectObjects(
         transaction->res.jsonValue["objects"] = nlohmann::json::array();
     }
 
-    dbus::utility::async_method_call(
-        [transaction, processName{std::string(processName)},
-         objectPath{std::string(objectPath)}](
+    introspect(
+        processName, objectPath,
+        [transaction, processName, objectPath](
             const boost::system::error_code& ec,
-            const std::string& introspectXml) {
+            const std::shared_ptr<const IntrospectedObject>& object) {
             if (ec)
             {
-                BMCWEB_LOG_ERROR(
-                    "Introspect call failed with error: {} on process: {} path: {}",
-                    ec.message(), processName, objectPath);
                 return;
             }
-            nlohmann::json::object_t object;
-            object["path"] = objectPath;
+            nlohmann::json::object_t objectJson;
+            objectJson["path"] = objectPath;
 
             transaction->res.jsonValue["objects"].emplace_back(
-                std::move(object));
-
-            tinyxml2::XMLDocument doc;
+                std::move(objectJson));
 
-            doc.Parse(introspectXml.c_str());
-            tinyxml2::XMLNode* pRoot = doc.FirstChildElement("node");
-            if (pRoot == nullptr)
+            if (object == nullptr)
             {
-                BMCWEB_LOG_ERROR("XML document failed to parse {} {}",
-                                 processName, objectPath);
+                return;
             }
-            else
+            for (const std::string& childPath : object->children)
             {
-                tinyxml2::XMLElement* node = pRoot->FirstChildElement("node");
-                while (node != nullptr)
+                std::string newpath;
+                if (objectPath != "/")
                 {
-                    const char* childPath = node->Attribute("name");
-                    if (childPath != nullptr)
-                    {
-                        std::string newpath;
-                        if (objectPath != "/")
-                        {
-                            newpath += objectPath;
-                        }
-                        newpath += std::string("/") + childPath;
-                        // introspect the subobjects as well
-                        introspectObjects(processName, newpath, transaction);
-                    }
-
-                    node = node->NextSiblingElement("node");
+                    newpath += objectPath;
                 }
+                newpath += "/";
+                newpath += childPath;
+                // introspect the subobjects as well
+                introspectObjects(processName, newpath, transaction);
             }
-        },
-        processName, objectPath, "org.freedesktop.DBus.Introspectable",
-        "Introspect");
+        });
 }
 
 inline void getPropertiesForEnumerate(
@@ -1381,171 +1472,94 @@ inline void handleMethodResponse(
     }
 }
 
-inline void findActionOnInterface(
+// Returns false if the arguments don't match the method signature
+inline bool callMethodOnInterface(
     const std::shared_ptr<InProgressActionData>& transaction,
-    const std::string& connectionName)
+    const std::string& connectionName, const std::string& interfaceName,
+    const IntrospectedMethod& method)
 {
-    BMCWEB_LOG_DEBUG("findActionOnInterface for connection {}", connectionName);
-    dbus::utility::async_method_call(
-        [transaction, connectionName{std::string(connectionName)}](
-            const boost::system::error_code& ec,
-            const std::string& introspectXml) {
-            BMCWEB_LOG_DEBUG("got xml:\n {}", introspectXml);
-            if (ec)
+    BMCWEB_LOG_DEBUG("Found method named {} on interface {}", method.name,
+                     interfaceName);
+    sdbusplus::message_t m = crow::connections::systemBus->new_method_call(
+        connectionName.c_str(), transaction->path.c_str(),
+        interfaceName.c_str(), transaction->methodName.c_str());
+
+    auto argIt = transaction->arguments.begin();
+    for (const std::string& argType : method.inputTypes)
+    {
+        if (argIt == transaction->arguments.end())
+        {
+            transaction->setErrorStatus("Invalid method args");
+            return false;
+        }
+        if (convertJsonToDbus(m.get(), argType, *argIt) < 0)
+        {
+            transaction->setErrorStatus("Invalid method arg type");
+            return false;
+        }
+        argIt++;
+    }
+
+    crow::connections::systemBus->async_send(
+        m, [transaction, returnType{method.returnType}](
+               const boost::system::error_code& ec2, sdbusplus::message_t& m2) {
+            if (ec2)
             {
-                BMCWEB_LOG_ERROR(
-                    "Introspect call failed with error: {} on process: {}",
-                    ec.message(), connectionName);
+                transaction->methodFailed = true;
+                const sd_bus_error* e = m2.get_error();
+
+                if (e != nullptr)
+                {
+                    setErrorResponse(transaction->asyncResp->res,
+                                     boost::beast::http::status::bad_request,
+                                     e->name, e->message);
+                }
+                else
+                {
+                    setErrorResponse(transaction->asyncResp->res,
+                                     boost::beast::http::status::bad_request,
+                                     "Method call failed", methodFailedMsg);
+                }
                 return;
             }
-            tinyxml2::XMLDocument doc;
+            transaction->methodPassed = true;
 
-            doc.Parse(introspectXml.data(), introspectXml.size());
-            tinyxml2::XMLNode* pRoot = doc.FirstChildElement("node");
-            if (pRoot == nullptr)
+            handleMethodResponse(transaction, m2, returnType);
+        });
+    return true;
+}
+
+inline void findActionOnInterface(
+    const std::shared_ptr<InProgressActionData>& transaction,
+    const std::string& connectionName)
+{
+    BMCWEB_LOG_DEBUG("findActionOnInterface for connection {}", connectionName);
+    introspect(
+        connectionName, transaction->path,
+        [transaction, connectionName](
+            const boost::system::error_code& ec,
+            const std::shared_ptr<const IntrospectedObject>& object) {
+            if (ec || object == nullptr)
             {
-                BMCWEB_LOG_ERROR("XML document failed to parse {}",
-                                 connectionName);
                 return;
             }
-            tinyxml2::XMLElement* interfaceNode =
-                pRoot->FirstChildElement("interface");
-            while (interfaceNode != nullptr)
+            for (const IntrospectedInterface& interface : object->interfaces)
             {
-                const char* thisInterfaceName =
-                    interfaceNode->Attribute("name");
-                if (thisInterfaceName != nullptr)
+                if (!transaction->interfaceName.empty() &&
+                    transaction->interfaceName != interface.name)
                 {
-                    if (!transaction->interfaceName.empty() &&
-                        (transaction->interfaceName != thisInterfaceName))
-                    {
-                        interfaceNode =
-                            interfaceNode->NextSiblingElement("interface");
-                        continue;
-                    }
-
-                    tinyxml2::XMLElement* methodNode =
-                        interfaceNode->FirstChildElement("method");
-                    while (methodNode != nullptr)
-                    {
-                        const char* thisMethodName =
-                            methodNode->Attribute("name");
-                        BMCWEB_LOG_DEBUG("Found method: {}", thisMethodName);
-                        if (thisMethodName != nullptr &&
-                            thisMethodName == transaction->methodName)
-                        {
-                            BMCWEB_LOG_DEBUG(
-                                "Found method named {} on interface {}",
-                                thisMethodName, thisInterfaceName);
-                            sdbusplus::message_t m =
-                                crow::connections::systemBus->new_method_call(
-                                    connectionName.c_str(),
-                                    transaction->path.c_str(),
-                                    thisInterfaceName,
-                                    transaction->methodName.c_str());
-
-                            tinyxml2::XMLElement* argumentNode =
-                                methodNode->FirstChildElement("arg");
-
-                            std::string returnType;
-
-                            // Find the output type
-                            while (argumentNode != nullptr)
-                            {
-                                const char* argDirection =
-                                    argumentNode->Attribute("direction");
-                                const char* argType =
-                                    argumentNode->Attribute("type");
-                                if (argDirection != nullptr &&
-                                    argType != nullptr &&
-                                    std::string(argDirection) == "out")
-                                {
-                                    returnType = argType;
-                                    break;
-                                }
-                                argumentNode =
-                                    argumentNode->NextSiblingElement("arg");
-                            }
-
-                            auto argIt = transaction->arguments.begin();
-
-                            argumentNode = methodNode->FirstChildElement("arg");
-
-                            while (argumentNode != nullptr)
-                            {
-                                const char* argDirection =
-                                    argumentNode->Attribute("direction");
-                                const char* argType =
-                                    argumentNode->Attribute("type");
-                                if (argDirection != nullptr &&
-                                    argType != nullptr &&
-                                    std::string(argDirection) == "in")
-                                {
-                                    if (argIt == transaction->arguments.end())
-                                    {
-                                        transaction->setErrorStatus(
-                                            "Invalid method args");
-                                        return;
-                                    }
-                                    if (convertJsonToDbus(m.get(),
-                                                          std::string(argType),
-                                                          *argIt) < 0)
-                                    {
-                                        transaction->setErrorStatus(
-                                            "Invalid method arg type");
-                                        return;
-                                    }
-
-                                    argIt++;
-                                }
-                                argumentNode =
-                                    argumentNode->NextSiblingElement("arg");
-                            }
-
-                            crow::connections::systemBus->async_send(
-                                // ast-grep-ignore: long-lambda
-                                m, [transaction, returnType](
-                                       const boost::system::error_code& ec2,
-                                       sdbusplus::message_t& m2) {
-                                    if (ec2)
-                                    {
-                                        transaction->methodFailed = true;
-                                        const sd_bus_error* e = m2.get_error();
-
-                                        if (e != nullptr)
-                                        {
-                                            setErrorResponse(
-                                                transaction->asyncResp->res,
-                                                boost::beast::http::status::
-                                                    bad_request,
-                                                e->name, e->message);
-                                        }
-                                        else
-                                        {
-                                            setErrorResponse(
-                                                transaction->asyncResp->res,
-                                                boost::beast::http::status::
-                                                    bad_request,
-                                                "Method call failed",
-                                                methodFailedMsg);
-                                        }
-                                        return;
-                                    }
-                                    transaction->methodPassed = true;
-
-                                    handleMethodResponse(transaction, m2,
-                                                         returnType);
-                                });
-                            break;
-                        }
-                        methodNode = methodNode->NextSiblingElement("method");
-                    }
+                    continue;
+                }
+                const IntrospectedMethod* method =
+                    interface.findMethod(transaction->methodName);
+                if (method != nullptr &&
+                    !callMethodOnInterface(transaction, connectionName,
+                                           interface.name, *method))
+                {
+                    return;
                 }
-                interfaceNode = interfaceNode->NextSiblingElement("interface");
             }
-        },
-        connectionName, transaction->path,
-        "org.freedesktop.DBus.Introspectable", "Introspect");
+        });
 }
 
 inline void handleAction(const crow::Request& req,
@@ -1875,6 +1889,69 @@ struct AsyncPutRequest
     nlohmann::json propertyValue;
 };
 
+// Returns false if the value doesn't match the property type
+inline bool setPropertyOnInterface(
+    const std::shared_ptr<AsyncPutRequest>& transaction,
+    const std::string& connectionName, const std::string& interfaceName,
+    const std::string& argType)
+{
+    BMCWEB_LOG_DEBUG("Found property {} on interface {}",
+                     transaction->propertyName, interfaceName);
+    sdbusplus::message_t m = crow::connections::systemBus->new_method_call(
+        connectionName.c_str(), transaction->objectPath.c_str(),
+        "org.freedesktop.DBus.Properties", "Set");
+    m.append(interfaceName, transaction->propertyName);
+    int r = sd_bus_message_open_container(m.get(), SD_BUS_TYPE_VARIANT,
+                                          argType.c_str());
+    if (r < 0)
+    {
+        transaction->setErrorStatus("Unexpected Error");
+        return false;
+    }
+    r = convertJsonToDbus(m.get(), argType, transaction->propertyValue);
+    if (r < 0)
+    {
+        if (r == -ERANGE)
+        {
+            transaction->setErrorStatus(
+                "Provided property value is out of range for the property "
+                "type");
+        }
+        else
+        {
+            transaction->setErrorStatus("Invalid arg type");
+        }
+        return false;
+    }
+    r = sd_bus_message_close_container(m.get());
+    if (r < 0)
+    {
+        transaction->setErrorStatus("Unexpected Error");
+        return false;
+    }
+    crow::connections::systemBus->async_send(
+        m, [transaction](const boost::system::error_code& ec,
+                         sdbusplus::message_t& m2) {
+            BMCWEB_LOG_DEBUG("sent");
+            if (ec)
+            {
+                const sd_bus_error* e = m2.get_error();
+                setErrorResponse(
+                    transaction->asyncResp->res,
+                    boost::beast::http::status::forbidden,
+                    (e) != nullptr ? e->name : ec.category().name(),
+                    (e) != nullptr ? e->message : ec.message());
+            }
+            else
+            {
+                transaction->asyncResp->res.jsonValue["status"] = "ok";
+                transaction->asyncResp->res.jsonValue["message"] = "200 OK";
+                transaction->asyncResp->res.jsonValue["data"] = nullptr;
+            }
+        });
+    return true;
+}
+
 inline void handlePut(const crow::Request& req,
                       const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                       const std::string& objectPath,
@@ -1946,160 +2023,32 @@ inline void handlePut(const crow::Request& req,
             {
                 const std::string& connectionName = connection.first;
 
-                dbus::utility::async_method_call(
-                    [connectionName{std::string(connectionName)},
-                     transaction](const boost::system::error_code& ec3,
-                                  const std::string& introspectXml) {
-                        if (ec3)
-                        {
-                            BMCWEB_LOG_ERROR(
-                                "Introspect call failed with error: {} on process: {}",
-                                ec3.message(), connectionName);
-                            transaction->setErrorStatus("Unexpected Error");
-                            return;
-                        }
-                        tinyxml2::XMLDocument doc;
-
-                        doc.Parse(introspectXml.c_str());
-                        tinyxml2::XMLNode* pRoot =
-                            doc.FirstChildElement("node");
-                        if (pRoot == nullptr)
+                introspect(
+                    connectionName, transaction->objectPath,
+                    [connectionName, transaction](
+                        const boost::system::error_code& ec3,
+                        const std::shared_ptr<const IntrospectedObject>&
+                            object) {
+                        if (ec3 || object == nullptr)
                         {
-                            BMCWEB_LOG_ERROR("XML document failed to parse: {}",
-                                             introspectXml);
                             transaction->setErrorStatus("Unexpected Error");
                             return;
                         }
-                        tinyxml2::XMLElement* ifaceNode =
-                            pRoot->FirstChildElement("interface");
-                        while (ifaceNode != nullptr)
+                        for (const IntrospectedInterface& interface :
+                             object->interfaces)
                         {
-                            const char* interfaceName =
-                                ifaceNode->Attribute("name");
-                            BMCWEB_LOG_DEBUG("found interface {}",
-                                             interfaceName);
-                            tinyxml2::XMLElement* propNode =
-                                ifaceNode->FirstChildElement("property");
-                            while (propNode != nullptr)
+                            const IntrospectedProperty* property =
+                                interface.findProperty(
+                                    transaction->propertyName);
+                            if (property != nullptr &&
+                                !setPropertyOnInterface(
+                                    transaction, connectionName,
+                                    interface.name, property->type))
                             {
-                                const char* propertyName =
-                                    propNode->Attribute("name");
-                                if (propertyName == nullptr)
-                                {
-                                    BMCWEB_LOG_DEBUG(
-                                        "Couldn't find name property");
-                                    continue;
-                                }
-                                BMCWEB_LOG_DEBUG("Found property {}",
-                                                 propertyName);
-                                if (propertyName == transaction->propertyName)
-                                {
-                                    const char* argType =
-                                        propNode->Attribute("type");
-                                    if (argType != nullptr)
-                                    {
-                                        sdbusplus::message_t m =
-                                            crow::connections::systemBus
-                                                ->new_method_call(
-                                                    connectionName.c_str(),
-                                                    transaction->objectPath
-                                                        .c_str(),
-                                                    "org.freedesktop.DBus."
-                                                    "Properties",
-                                                    "Set");
-                                        m.append(interfaceName,
-                                                 transaction->propertyName);
-                                        int r = sd_bus_message_open_container(
-                                            m.get(), SD_BUS_TYPE_VARIANT,
-                                            argType);
-                                        if (r < 0)
-                                        {
-                                            transaction->setErrorStatus(
-                                                "Unexpected Error");
-                                            return;
-                                        }
-                                        r = convertJsonToDbus(
-                                            m.get(), argType,
-                                            transaction->propertyValue);
-                                        if (r < 0)
-                                        {
-                                            if (r == -ERANGE)
-                                            {
-                                                transaction->setErrorStatus(
-                                                    "Provided property value "
-                                                    "is out of range for the "
-                                                    "property type");
-                                            }
-                                            else
-                                            {
-                                                transaction->setErrorStatus(
-                                                    "Invalid arg type");
-                                            }
-                                            return;
-                                        }
-                                        r = sd_bus_message_close_container(
-                                            m.get());
-                                        if (r < 0)
-                                        {
-                                            transaction->setErrorStatus(
-                                                "Unexpected Error");
-                                            return;
-                                        }
-                                        crow::connections::systemBus
-                                            ->async_send(
-                                                m,
-                                                // ast-grep-ignore: long-lambda
-                                                [transaction](
-                                                    const boost::system::
-                                                        error_code& ec,
-                                                    sdbusplus::message_t& m2) {
-                                                    BMCWEB_LOG_DEBUG("sent");
-                                                    if (ec)
-                                                    {
-                                                        const sd_bus_error* e =
-                                                            m2.get_error();
-                                                        setErrorResponse(
-                                                            transaction
-                                                                ->asyncResp
-                                                                ->res,
-                                                            boost::beast::http::
-                                                                status::
-                                                                    forbidden,
-                                                            (e) != nullptr
-                                                                ? e->name
-                                                                : ec.category()
-                                                                      .name(),
-                                                            (e) != nullptr
-                                                                ? e->message
-                                                                : ec.message());
-                                                    }
-                                                    else
-                                                    {
-                                                        transaction->asyncResp
-                                                            ->res.jsonValue
-                                                                ["status"] =
-                                                            "ok";
-                                                        transaction->asyncResp
-                                                            ->res.jsonValue
-                                                                ["message"] =
-                                                            "200 OK";
-                                                        transaction->asyncResp
-                                                            ->res
-                                                            .jsonValue["data"] =
-                                                            nullptr;
-                                                    }
-                                                });
-                                    }
-                                }
-                                propNode =
-                                    propNode->NextSiblingElement("property");
+                                return;
                             }
-                            ifaceNode =
-                                ifaceNode->NextSiblingElement("interface");
                         }
-                    },
-                    connectionName, transaction->objectPath,
-                    "org.freedesktop.DBus.Introspectable", "Introspect");
+                    });
             }
         });
 }
@@ -2234,81 +2183,53 @@ inline void handleBusSystemPost(
     }
     if (interfaceName.empty())
     {
-        dbus::utility::async_method_call(
-            // ast-grep-ignore: long-lambda
-            [asyncResp, processName,
-             objectPath](const boost::system::error_code& ec,
-                         const std::string& introspectXml) {
+        introspect(
+            processName, objectPath,
+            [asyncResp, processName, objectPath](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const IntrospectedObject>& object) {
                 if (ec)
                 {
-                    BMCWEB_LOG_ERROR(
-                        "Introspect call failed with error: {} on process: {} path: {}",
-                        ec.message(), processName, objectPath);
                     return;
                 }
-                tinyxml2::XMLDocument doc;
-
-                doc.Parse(introspectXml.c_str());
-                tinyxml2::XMLNode* pRoot = doc.FirstChildElement("node");
-                if (pRoot == nullptr)
+                if (object == nullptr)
                 {
-                    BMCWEB_LOG_ERROR("XML document failed to parse {} {}",
-                                     processName, objectPath);
                     asyncResp->res.jsonValue["status"] = "XML parse error";
                     asyncResp->res.result(
                         boost::beast::http::status::internal_server_error);
                     return;
                 }
 
-                BMCWEB_LOG_DEBUG("{}", introspectXml);
                 asyncResp->res.jsonValue["status"] = "ok";
                 asyncResp->res.jsonValue["bus_name"] = processName;
                 asyncResp->res.jsonValue["object_path"] = objectPath;
 
-                nlohmann::json& interfacesArray =
-                    asyncResp->res.jsonValue["interfaces"];
-                interfacesArray = nlohmann::json::array();
-                tinyxml2::XMLElement* interface =
-                    pRoot->FirstChildElement("interface");
-
-                while (interface != nullptr)
+                nlohmann::json::array_t interfacesArray;
+                for (const IntrospectedInterface& interface :
+                     object->interfaces)
                 {
-                    const char* ifaceName = interface->Attribute("name");
-                    if (ifaceName != nullptr)
-                    {
-                        nlohmann::json::object_t interfaceObj;
-                        interfaceObj["name"] = ifaceName;
-                        interfacesArray.emplace_back(std::move(interfaceObj));
-                    }
-
-                    interface = interface->NextSiblingElement("interface");
+                    nlohmann::json::object_t interfaceObj;
+                    interfaceObj["name"] = interface.name;
+                    interfacesArray.emplace_back(std::move(interfaceObj));
                 }
-            },
-            processName, objectPath, "org.freedesktop.DBus.Introspectable",
-            "Introspect");
+                asyncResp->res.jsonValue["interfaces"] =
+                    std::move(interfacesArray);
+            });
     }
     else if (methodName.empty())
     {
-        dbus::utility::async_method_call(
+        introspect(
+            processName, objectPath,
             // ast-grep-ignore: long-lambda
-            [asyncResp, processName, objectPath,
-             interfaceName](const boost::system::error_code& ec,
-                            const std::string& introspectXml) {
+            [asyncResp, processName, objectPath, interfaceName](
+                const boost::system::error_code& ec,
+                const std::shared_ptr<const IntrospectedObject>& object) {
                 if (ec)
                 {
-                    BMCWEB_LOG_ERROR(
-                        "Introspect call failed with error: {} on process: {} path: {}",
-                        ec.message(), processName, objectPath);
                     return;
                 }
-                tinyxml2::XMLDocument doc;
-
-                doc.Parse(introspectXml.data(), introspectXml.size());
-                tinyxml2::XMLNode* pRoot = doc.FirstChildElement("node");
-                if (pRoot == nullptr)
+                if (object == nullptr)
                 {
-                    BMCWEB_LOG_ERROR("XML document failed to parse {} {}",
-                                     processName, objectPath);
                     asyncResp->res.result(
                         boost::beast::http::status::internal_server_error);
                     return;
@@ -2331,21 +2252,8 @@ inline void handleBusSystemPost(
                     asyncResp->res.jsonValue["properties"];
                 propertiesObj = nlohmann::json::object();
 
-                // if we know we're the only call, build the
-                // json directly
-                tinyxml2::XMLElement* interface =
-                    pRoot->FirstChildElement("interface");
-                while (interface != nullptr)
-                {
-                    const char* ifaceName = interface->Attribute("name");
-
-                    if (ifaceName != nullptr && ifaceName == interfaceName)
-                    {
-                        break;
-                    }
-
-                    interface = interface->NextSiblingElement("interface");
-                }
+                const IntrospectedInterface* interface =
+                    object->findInterface(interfaceName);
                 if (interface == nullptr)
                 {
                     // if we got to the end of the list and
@@ -2355,127 +2263,94 @@ inline void handleBusSystemPost(
                     return;
                 }
 
-                tinyxml2::XMLElement* methods =
-                    interface->FirstChildElement("method");
-                while (methods != nullptr)
+                for (const IntrospectedMethod& method : interface->methods)
                 {
-                    nlohmann::json argsArray = nlohmann::json::array();
-                    tinyxml2::XMLElement* arg =
-                        methods->FirstChildElement("arg");
-                    while (arg != nullptr)
+                    nlohmann::json::array_t argsArray;
+                    for (const IntrospectedArg& arg : method.args)
                     {
                         nlohmann::json thisArg;
-                        for (const char* fieldName : std::array<const char*, 3>{
-                                 "name", "direction", "type"})
+                        if (!arg.name.empty())
                         {
-                            const char* fieldValue = arg->Attribute(fieldName);
-                            if (fieldValue != nullptr)
-                            {
-                                thisArg[fieldName] = fieldValue;
-                            }
+                            thisArg["name"] = arg.name;
+                        }
+                        if (!arg.direction.empty())
+                        {
+                            thisArg["direction"] = arg.direction;
+                        }
+                        if (!arg.type.empty())
+                        {
+                            thisArg["type"] = arg.type;
                         }
                         argsArray.emplace_back(std::move(thisArg));
-                        arg = arg->NextSiblingElement("arg");
                     }
 
-                    const char* name = methods->Attribute("name");
-                    if (name != nullptr)
-                    {
-                        std::string uri;
-                        uri.reserve(14 + processName.size() +
-                                    objectPath.size() + interfaceName.size() +
-                                    strlen(name));
-                        uri += "/bus/system/";
-                        uri += processName;
-                        uri += objectPath;
-                        uri += "/";
-                        uri += interfaceName;
-                        uri += "/";
-                        uri += name;
-
-                        nlohmann::json::object_t object;
-                        object["name"] = name;
-                        object["uri"] = std::move(uri);
-                        object["args"] = argsArray;
-
-                        methodsArray.emplace_back(std::move(object));
-                    }
-                    methods = methods->NextSiblingElement("method");
+                    std::string uri;
+                    uri.reserve(14 + processName.size() + objectPath.size() +
+                                interfaceName.size() + method.name.size());
+                    uri += "/bus/system/";
+                    uri += processName;
+                    uri += objectPath;
+                    uri += "/";
+                    uri += interfaceName;
+                    uri += "/";
+                    uri += method.name;
+
+                    nlohmann::json::object_t methodObj;
+                    methodObj["name"] = method.name;
+                    methodObj["uri"] = std::move(uri);
+                    methodObj["args"] = std::move(argsArray);
+
+                    methodsArray.emplace_back(std::move(methodObj));
                 }
-                tinyxml2::XMLElement* signals =
-                    interface->FirstChildElement("signal");
-                while (signals != nullptr)
+                for (const IntrospectedSignal& signal : interface->signals)
                 {
-                    nlohmann::json argsArray = nlohmann::json::array();
-
-                    tinyxml2::XMLElement* arg =
-                        signals->FirstChildElement("arg");
-                    while (arg != nullptr)
+                    nlohmann::json::array_t argsArray;
+                    for (const IntrospectedArg& arg : signal.args)
                     {
-                        const char* name = arg->Attribute("name");
-                        const char* type = arg->Attribute("type");
-                        if (name != nullptr && type != nullptr)
+                        if (!arg.name.empty() && !arg.type.empty())
                         {
                             nlohmann::json::object_t params;
-                            params["name"] = name;
-                            params["type"] = type;
-                            argsArray.push_back(std::move(params));
+                            params["name"] = arg.name;
+                            params["type"] = arg.type;
+                            argsArray.emplace_back(std::move(params));
                         }
-                        arg = arg->NextSiblingElement("arg");
                     }
-                    const char* name = signals->Attribute("name");
-                    if (name != nullptr)
-                    {
-                        nlohmann::json::object_t object;
-                        object["name"] = name;
-                        object["args"] = argsArray;
-                        signalsArray.emplace_back(std::move(object));
-                    }
-
-                    signals = signals->NextSiblingElement("signal");
+                    nlohmann::json::object_t signalObj;
+                    signalObj["name"] = signal.name;
+                    signalObj["args"] = std::move(argsArray);
+                    signalsArray.emplace_back(std::move(signalObj));
                 }
 
-                tinyxml2::XMLElement* property =
-                    interface->FirstChildElement("property");
-                while (property != nullptr)
+                for (const IntrospectedProperty& property :
+                     interface->properties)
                 {
-                    const char* name = property->Attribute("name");
-                    const char* type = property->Attribute("type");
-                    if (type != nullptr && name != nullptr)
-                    {
-                        sdbusplus::message_t m =
-                            crow::connections::systemBus->new_method_call(
-                                processName.c_str(), objectPath.c_str(),
-                                "org.freedesktop."
-                                "DBus."
-                                "Properties",
-                                "Get");
-                        m.append(interfaceName, name);
-                        nlohmann::json& propertyItem = propertiesObj[name];
-                        crow::connections::systemBus->async_send(
-                            // ast-grep-ignore: long-lambda
-                            m, [&propertyItem,
-                                asyncResp](const boost::system::error_code& ec2,
-                                           sdbusplus::message_t& msg) {
-                                if (ec2)
-                                {
-                                    return;
-                                }
+                    sdbusplus::message_t m =
+                        crow::connections::systemBus->new_method_call(
+                            processName.c_str(), objectPath.c_str(),
+                            "org.freedesktop."
+                            "DBus."
+                            "Properties",
+                            "Get");
+                    m.append(interfaceName, property.name);
+                    nlohmann::json& propertyItem = propertiesObj[property.name];
+                    crow::connections::systemBus->async_send(
+                        m, [&propertyItem,
+                            asyncResp](const boost::system::error_code& ec2,
+                                       sdbusplus::message_t& msg) {
+                            if (ec2)
+                            {
+                                return;
+                            }
 
-                                int r =
-                                    convertDBusToJSON("v", msg, propertyItem);
-                                if (r < 0)
-                                {
-                                    BMCWEB_LOG_ERROR(
-                                        "Couldn't convert vector to json");
-                                }
-                            });
-                    }
-                    property = property->NextSiblingElement("property");
+                            int r = convertDBusToJSON("v", msg, propertyItem);
+                            if (r < 0)
+                            {
+                                BMCWEB_LOG_ERROR(
+                                    "Couldn't convert vector to json");
+                            }
+                        });
                 }
-            },
-            processName, objectPath, "org.freedesktop.DBus.Introspectable",
-            "Introspect");
+            });
     }
     else
     {
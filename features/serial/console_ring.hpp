@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace crow
+{
+namespace obmc_console
+{
+
+// Fixed size ring holding the most recent output of a console.  Positions are
+// offsets into the whole output stream, so each reader keeps its own offset
+// and can tell when it has fallen so far behind that its data was overwritten.
+//
+// The console is read straight into the ring with prepare() and commit().
+// Bytes that a pending read may overwrite are no longer readable, so readers
+// never see partially written data.
+class ConsoleRing
+{
+  public:
+    explicit ConsoleRing(size_t capacity) : buffer(capacity) {}
+
+    // Oldest offset that can still be read
+    uint64_t begin() const
+    {
+        uint64_t used = written + reserved;
+        if (used < buffer.size())
+        {
+            return 0;
+        }
+        return used - buffer.size();
+    }
+
+    // Offset of the next byte of output
+    uint64_t end() const
+    {
+        return written;
+    }
+
+    size_t capacity() const
+    {
+        return buffer.size();
+    }
+
+    // Contiguous space for up to maxBytes of new output, which overwrites the
+    // oldest output once the ring is full
+    std::span<char> prepare(size_t maxBytes)
+    {
+        size_t pos = static_cast<size_t>(written % buffer.size());
+        reserved = std::min(maxBytes, buffer.size() - pos);
+        return {&buffer[pos], reserved};
+    }
+
+    void commit(size_t bytes)
+    {
+        written += std::min(bytes, reserved);
+        reserved = 0;
+    }
+
+    // Appends up to maxBytes of output from offset onwards to out.  Returns
+    // the offset after the last byte appended.  Offsets older than begin()
+    // start from begin() instead.
+    uint64_t read(uint64_t offset, size_t maxBytes, std::string& out) const
+    {
+        offset = std::clamp(offset, begin(), end());
+        uint64_t last = offset + std::min<uint64_t>(maxBytes, end() - offset);
+        while (offset < last)
+        {
+            size_t pos = static_cast<size_t>(offset % buffer.size());
+            size_t bytes = static_cast<size_t>(
+                std::min<uint64_t>(last - offset, buffer.size() - pos));
+            out.append(&buffer[pos], bytes);
+            offset += bytes;
+        }
+        return offset;
+    }
+
+  private:
+    std::vector<char> buffer;
+    // Total bytes of output committed
+    uint64_t written = 0;
+    // Bytes handed out by prepare() and not yet committed
+    size_t reserved = 0;
+};
+
+} // namespace obmc_console
+} // namespace crow
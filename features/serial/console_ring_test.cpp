@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "console_ring.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+namespace crow::obmc_console
+{
+namespace
+{
+
+size_t write(ConsoleRing& ring, std::string_view data)
+{
+    std::span<char> space = ring.prepare(data.size());
+    data.copy(space.data(), space.size());
+    ring.commit(space.size());
+    return space.size();
+}
+
+TEST(ConsoleRing, ReadsFromOffset)
+{
+    ConsoleRing ring(16);
+    EXPECT_EQ(ring.begin(), 0U);
+    EXPECT_EQ(ring.end(), 0U);
+
+    EXPECT_EQ(write(ring, "hello "), 6U);
+    EXPECT_EQ(write(ring, "world"), 5U);
+    EXPECT_EQ(ring.begin(), 0U);
+    EXPECT_EQ(ring.end(), 11U);
+
+    std::string out;
+    EXPECT_EQ(ring.read(0, 5, out), 5U);
+    EXPECT_EQ(out, "hello");
+    EXPECT_EQ(ring.read(5, 100, out), 11U);
+    EXPECT_EQ(out, "hello world");
+    EXPECT_EQ(ring.read(11, 100, out), 11U);
+    EXPECT_EQ(out, "hello world");
+}
+
+TEST(ConsoleRing, WrapsAround)
+{
+    ConsoleRing ring(16);
+    write(ring, "0123456789abcdef");
+    EXPECT_EQ(ring.begin(), 0U);
+
+    // Writes stop at the end of the buffer so they stay contiguous
+    EXPECT_EQ(write(ring, "ghij"), 4U);
+    EXPECT_EQ(ring.begin(), 4U);
+    EXPECT_EQ(ring.end(), 20U);
+
+    std::string out;
+    EXPECT_EQ(ring.read(10, 100, out), 20U);
+    EXPECT_EQ(out, "abcdefghij");
+
+    // Overwritten output is skipped
+    out.clear();
+    EXPECT_EQ(ring.read(0, 6, out), 10U);
+    EXPECT_EQ(out, "456789");
+}
+
+TEST(ConsoleRing, PendingReadIsNotReadable)
+{
+    ConsoleRing ring(8);
+    write(ring, "abcdefgh");
+    EXPECT_EQ(ring.begin(), 0U);
+
+    std::span<char> space = ring.prepare(4);
+    EXPECT_EQ(space.size(), 4U);
+    EXPECT_EQ(ring.begin(), 4U);
+    std::string out;
+    EXPECT_EQ(ring.read(0, 100, out), 8U);
+    EXPECT_EQ(out, "efgh");
+
+    // Nothing read, the oldest output is readable again
+    ring.commit(0);
+    EXPECT_EQ(ring.begin(), 0U);
+    EXPECT_EQ(ring.end(), 8U);
+}
+
+} // namespace
+} // namespace crow::obmc_console
@@ -1,7 +1,10 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #pragma once
+#include "bmcweb_config.h"
+
 #include "app.hpp"
+#include "console_ring.hpp"
 #include "dbus_utility.hpp"
 #include "io_context_singleton.hpp"
 #include "logging.hpp"
@@ -19,10 +22,13 @@
 #include <boost/system/error_code.hpp>
 #include <sdbusplus/message/native_types.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -36,12 +42,30 @@ namespace obmc_console
 // Update this value each time we add new console route.
 static constexpr const uint maxSessions = 32;
 
+// Most console output read at once
+static constexpr size_t consoleReadSize = 4096;
+
+// Most console output sent in one websocket message.  Output that arrives
+// while a message is being sent goes out together in the next one.
+static constexpr size_t consoleMaxFrameSize = 16384;
+
+// Console output replayed to a new connection
+static constexpr size_t consoleScrollback =
+    static_cast<size_t>(BMCWEB_HOST_SERIAL_SCROLLBACK) * 1024UL;
+
+// How far a connection can fall behind the console before output is dropped
+// for it
+static constexpr size_t consoleMaxLag = 65536;
+
+// One obmc-console connection shared by every websocket open on a console.
+// Output is read into a ring that keeps the scrollback, and each websocket
+// is sent the output from its own offset in the ring.  Input from any of the
+// websockets is written to the console.
 class ConsoleHandler : public std::enable_shared_from_this<ConsoleHandler>
 {
   public:
-    ConsoleHandler(boost::asio::io_context& ioc,
-                   crow::websocket::Connection& connIn) :
-        hostSocket(ioc), conn(connIn)
+    ConsoleHandler(boost::asio::io_context& ioc, const std::string& pathIn) :
+        path(pathIn), hostSocket(ioc), ring(consoleScrollback + consoleMaxLag)
     {}
 
     ~ConsoleHandler() = default;
@@ -51,6 +75,54 @@ class ConsoleHandler : public std::enable_shared_from_this<ConsoleHandler>
     ConsoleHandler& operator=(const ConsoleHandler&) = delete;
     ConsoleHandler& operator=(ConsoleHandler&&) = delete;
 
+    const std::string& getPath() const
+    {
+        return path;
+    }
+
+    bool isClosing() const
+    {
+        return closing;
+    }
+
+    size_t connectionCount() const
+    {
+        return viewers.size();
+    }
+
+    void addConnection(crow::websocket::Connection& conn)
+    {
+        Viewer& viewer = viewers[&conn];
+        uint64_t kept = ring.end() - ring.begin();
+        viewer.offset =
+            ring.end() - std::min<uint64_t>(kept, consoleScrollback);
+        if (hostSocket.is_open())
+        {
+            conn.resumeRead();
+            doSend(conn, viewer);
+        }
+    }
+
+    void removeConnection(crow::websocket::Connection& conn)
+    {
+        viewers.erase(&conn);
+    }
+
+    void closeAll(std::string_view reason)
+    {
+        closing = true;
+        for (auto& [conn, viewer] : viewers)
+        {
+            conn->close(reason);
+        }
+    }
+
+    void writeInput(std::string_view data)
+    {
+        inputBuffer += data;
+        doWrite();
+    }
+
     void doWrite()
     {
         if (doingWrite)
@@ -81,7 +153,7 @@ class ConsoleHandler : public std::enable_shared_from_this<ConsoleHandler>
 
                 if (ec == boost::asio::error::eof)
                 {
-                    self->conn.close("Error in reading to host port");
+                    self->closeAll("Error in reading to host port");
                     return;
                 }
                 if (ec)
@@ -94,41 +166,14 @@ class ConsoleHandler : public std::enable_shared_from_this<ConsoleHandler>
             });
     }
 
-    static void afterSendEx(const std::weak_ptr<ConsoleHandler>& weak)
-    {
-        std::shared_ptr<ConsoleHandler> self = weak.lock();
-        if (self == nullptr)
-        {
-            return;
-        }
-        self->doRead();
-    }
-
     void doRead()
     {
         BMCWEB_LOG_DEBUG("Reading from socket");
+        std::span<char> space = ring.prepare(consoleReadSize);
         hostSocket.async_read_some(
-            boost::asio::buffer(outputBuffer),
-            [this, weakSelf(weak_from_this())](
-                const boost::system::error_code& ec, std::size_t bytesRead) {
-                BMCWEB_LOG_DEBUG("read done.  Read {} bytes", bytesRead);
-                std::shared_ptr<ConsoleHandler> self = weakSelf.lock();
-                if (self == nullptr)
-                {
-                    return;
-                }
-                if (ec)
-                {
-                    BMCWEB_LOG_ERROR("Couldn't read from host serial port: {}",
-                                     ec.message());
-                    conn.close("Error connecting to host port");
-                    return;
-                }
-                std::string_view payload(outputBuffer.data(), bytesRead);
-                self->conn.sendEx(
-                    crow::websocket::MessageType::Binary, payload,
-                    std::bind_front(afterSendEx, weak_from_this()));
-            });
+            boost::asio::buffer(space.data(), space.size()),
+            std::bind_front(&ConsoleHandler::afterRead, this,
+                            weak_from_this()));
     }
 
     bool connect(int fd)
@@ -146,19 +191,96 @@ class ConsoleHandler : public std::enable_shared_from_this<ConsoleHandler>
             return false;
         }
 
-        conn.resumeRead();
+        for (auto& [conn, viewer] : viewers)
+        {
+            conn->resumeRead();
+        }
         doWrite();
         doRead();
         return true;
     }
 
-    boost::asio::local::stream_protocol::socket hostSocket;
+  private:
+    struct Viewer
+    {
+        // Offset in the console output of the next byte to send
+        uint64_t offset = 0;
+        // Shared with the websocket while a send is in flight
+        std::shared_ptr<std::string> frame = std::make_shared<std::string>();
+        bool doingSend = false;
+    };
+
+    void afterRead(const std::weak_ptr<ConsoleHandler>& weak,
+                   const boost::system::error_code& ec, std::size_t bytesRead)
+    {
+        BMCWEB_LOG_DEBUG("read done.  Read {} bytes", bytesRead);
+        std::shared_ptr<ConsoleHandler> self = weak.lock();
+        if (self == nullptr)
+        {
+            return;
+        }
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR("Couldn't read from host serial port: {}",
+                             ec.message());
+            ring.commit(0);
+            closeAll("Error connecting to host port");
+            return;
+        }
+        ring.commit(bytesRead);
+        for (auto& [conn, viewer] : viewers)
+        {
+            doSend(*conn, viewer);
+        }
+        doRead();
+    }
+
+    void doSend(crow::websocket::Connection& conn, Viewer& viewer)
+    {
+        if (viewer.doingSend || viewer.offset == ring.end())
+        {
+            return;
+        }
+        if (viewer.offset < ring.begin())
+        {
+            BMCWEB_LOG_WARNING("Connection {} fell behind, dropped {} bytes",
+                               logPtr(&conn), ring.begin() - viewer.offset);
+        }
+        viewer.frame->clear();
+        viewer.offset =
+            ring.read(viewer.offset, consoleMaxFrameSize, *viewer.frame);
+        viewer.doingSend = true;
+        conn.sendEx(crow::websocket::MessageType::Binary, *viewer.frame,
+                    std::bind_front(&ConsoleHandler::afterSend,
+                                    weak_from_this(), &conn, viewer.frame));
+    }
 
-    std::array<char, 4096> outputBuffer{};
+    static void afterSend(const std::weak_ptr<ConsoleHandler>& weak,
+                          crow::websocket::Connection* conn,
+                          const std::shared_ptr<std::string>& /*frame*/)
+    {
+        std::shared_ptr<ConsoleHandler> self = weak.lock();
+        if (self == nullptr)
+        {
+            return;
+        }
+        auto viewer = self->viewers.find(conn);
+        if (viewer == self->viewers.end())
+        {
+            return;
+        }
+        viewer->second.doingSend = false;
+        self->doSend(*conn, viewer->second);
+    }
+
+    const std::string path;
+    boost::asio::local::stream_protocol::socket hostSocket;
+    ConsoleRing ring;
+    boost::container::flat_map<crow::websocket::Connection*, Viewer> viewers;
+    bool closing = false;
 
     std::string inputBuffer;
     bool doingWrite = false;
-    crow::websocket::Connection& conn;
 };
 
 using ObmcConsoleMap = boost::container::flat_map<
@@ -172,8 +294,18 @@ inline ObmcConsoleMap& getConsoleHandlerMap()
     return map;
 }
 
-// Remove connection from the connection map and if connection map is empty
-// then remove the handler from handlers map.
+// Console object path to the handler shared by its connections
+inline boost::container::flat_map<std::string, std::weak_ptr<ConsoleHandler>>&
+    getConsoleMap()
+{
+    static boost::container::flat_map<std::string,
+                                      std::weak_ptr<ConsoleHandler>>
+        map;
+    return map;
+}
+
+// Remove connection from the connection map and if it was the last connection
+// to its console then remove the console too.
 inline void onClose(crow::websocket::Connection& conn, const std::string& err)
 {
     BMCWEB_LOG_INFO("Closing websocket. Reason: {}", err);
@@ -186,28 +318,40 @@ inline void onClose(crow::websocket::Connection& conn, const std::string& err)
     }
     BMCWEB_LOG_DEBUG("Remove connection {} from obmc console", logPtr(&conn));
 
-    // Removed last connection so remove the path
+    std::shared_ptr<ConsoleHandler> handler = iter->second;
+    handler->removeConnection(conn);
     getConsoleHandlerMap().erase(iter);
+
+    // Removed last connection so remove the console
+    if (handler->connectionCount() == 0)
+    {
+        auto console = getConsoleMap().find(handler->getPath());
+        if (console != getConsoleMap().end() &&
+            console->second.lock() == handler)
+        {
+            getConsoleMap().erase(console);
+        }
+    }
 }
 
-inline void connectConsoleSocket(crow::websocket::Connection& conn,
+inline void connectConsoleSocket(const std::weak_ptr<ConsoleHandler>& weak,
                                  const boost::system::error_code& ec,
                                  const sdbusplus::message::unix_fd& unixfd)
 {
-    if (ec)
+    // Look up the handler
+    std::shared_ptr<ConsoleHandler> handler = weak.lock();
+    if (handler == nullptr)
     {
-        BMCWEB_LOG_ERROR(
-            "Failed to call console Connect() method DBUS error: {}",
-            ec.message());
-        conn.close("Failed to connect");
+        BMCWEB_LOG_ERROR("Connections were already closed");
         return;
     }
 
-    // Look up the handler
-    auto iter = getConsoleHandlerMap().find(&conn);
-    if (iter == getConsoleHandlerMap().end())
+    if (ec)
     {
-        BMCWEB_LOG_ERROR("Connection was already closed");
+        BMCWEB_LOG_ERROR(
+            "Failed to call console Connect() method DBUS error: {}",
+            ec.message());
+        handler->closeAll("Failed to connect");
         return;
     }
 
@@ -215,29 +359,29 @@ inline void connectConsoleSocket(crow::websocket::Connection& conn,
     if (fd == -1)
     {
         BMCWEB_LOG_ERROR("Failed to dup the DBUS unixfd error");
-        conn.close("Internal error");
+        handler->closeAll("Internal error");
         return;
     }
 
     BMCWEB_LOG_DEBUG("Console duped FD: {}", fd);
 
-    if (!iter->second->connect(fd))
+    if (!handler->connect(fd))
     {
         close(fd);
-        conn.close("Internal Error");
+        handler->closeAll("Internal Error");
     }
 }
 
 inline void processConsoleObject(
-    crow::websocket::Connection& conn, const std::string& consoleObjPath,
+    const std::weak_ptr<ConsoleHandler>& weak,
     const boost::system::error_code& ec,
     const ::dbus::utility::MapperGetObject& objInfo)
 {
     // Look up the handler
-    auto iter = getConsoleHandlerMap().find(&conn);
-    if (iter == getConsoleHandlerMap().end())
+    std::shared_ptr<ConsoleHandler> handler = weak.lock();
+    if (handler == nullptr)
     {
-        BMCWEB_LOG_ERROR("Connection was already closed");
+        BMCWEB_LOG_ERROR("Connections were already closed");
         return;
     }
 
@@ -245,7 +389,7 @@ inline void processConsoleObject(
     {
         BMCWEB_LOG_WARNING("getDbusObject() for consoles failed. DBUS error:{}",
                            ec.message());
-        conn.close("getDbusObject() for consoles failed.");
+        handler->closeAll("getDbusObject() for consoles failed.");
         return;
     }
 
@@ -254,25 +398,25 @@ inline void processConsoleObject(
     {
         BMCWEB_LOG_WARNING("getDbusObject() returned unexpected size: {}",
                            objInfo.size());
-        conn.close("getDbusObject() returned unexpected size");
+        handler->closeAll("getDbusObject() returned unexpected size");
         return;
     }
 
     const std::string& consoleService = valueIface->first;
     BMCWEB_LOG_DEBUG("Looking up unixFD for Service {} Path {}", consoleService,
-                     consoleObjPath);
+                     handler->getPath());
     // Call Connect() method to get the unix FD
     dbus::utility::async_method_call(
-        [&conn](const boost::system::error_code& ec1,
-                const sdbusplus::message::unix_fd& unixfd) {
-            connectConsoleSocket(conn, ec1, unixfd);
+        [weak](const boost::system::error_code& ec1,
+               const sdbusplus::message::unix_fd& unixfd) {
+            connectConsoleSocket(weak, ec1, unixfd);
         },
-        consoleService, consoleObjPath, "xyz.openbmc_project.Console.Access",
-        "Connect");
+        consoleService, handler->getPath(),
+        "xyz.openbmc_project.Console.Access", "Connect");
 }
 
 // Query consoles from DBUS and find the matching to the
-// rules string.
+// rules string.  Connections to a console that is already open share it.
 inline void onOpen(crow::websocket::Connection& conn)
 {
     std::string consoleLeaf;
@@ -285,10 +429,6 @@ inline void onOpen(crow::websocket::Connection& conn)
         return;
     }
 
-    std::shared_ptr<ConsoleHandler> handler =
-        std::make_shared<ConsoleHandler>(getIoContext(), conn);
-    getConsoleHandlerMap().emplace(&conn, handler);
-
     conn.deferRead();
 
     // Keep old path for backward compatibility
@@ -308,15 +448,31 @@ inline void onOpen(crow::websocket::Connection& conn)
     BMCWEB_LOG_DEBUG("Console Object path = {} Request target = {}",
                      consolePath, conn.url().path());
 
+    std::weak_ptr<ConsoleHandler>& console = getConsoleMap()[consolePath];
+    std::shared_ptr<ConsoleHandler> handler = console.lock();
+    if (handler != nullptr && !handler->isClosing())
+    {
+        BMCWEB_LOG_DEBUG("Sharing open console {}", consolePath);
+        getConsoleHandlerMap().emplace(&conn, handler);
+        handler->addConnection(conn);
+        return;
+    }
+
+    handler = std::make_shared<ConsoleHandler>(getIoContext(), consolePath);
+    console = handler;
+    getConsoleHandlerMap().emplace(&conn, handler);
+    handler->addConnection(conn);
+
     // mapper call lambda
     constexpr std::array<std::string_view, 1> interfaces = {
         "xyz.openbmc_project.Console.Access"};
 
     dbus::utility::getDbusObject(
         consolePath, interfaces,
-        [&conn, consolePath](const boost::system::error_code& ec,
-                             const ::dbus::utility::MapperGetObject& objInfo) {
-            processConsoleObject(conn, consolePath, ec, objInfo);
+        [weak{std::weak_ptr<ConsoleHandler>(handler)}](
+            const boost::system::error_code& ec,
+            const ::dbus::utility::MapperGetObject& objInfo) {
+            processConsoleObject(weak, ec, objInfo);
         });
 }
 
@@ -329,8 +485,7 @@ inline void onMessage(crow::websocket::Connection& conn,
         BMCWEB_LOG_CRITICAL("Unable to find connection {}", logPtr(&conn));
         return;
     }
-    handler->second->inputBuffer += data;
-    handler->second->doWrite();
+    handler->second->writeInput(data);
 }
 
 inline void requestRoutes(App& app)
@@ -0,0 +1,313 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "logging.hpp"
+#include "relay_buffer.hpp"
+#include "websocket.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace crow
+{
+namespace nbd_relay
+{
+
+// The max network block device buffer size is 128kb plus 16bytes
+// for the message header:
+// https://github.com/NetworkBlockDevice/nbd/blob/master/doc/proto.md#simple-reply-message
+static constexpr size_t nbdBufferSize = (128 * 1024 + 16) * 4;
+
+// Websocket messages up to this size, like NBD request and reply headers, are
+// copied so the websocket can read the next message while they are queued for
+// the nbd socket.  Larger ones are written straight from the websocket buffer.
+static constexpr size_t nbdCopyThreshold = 4096;
+
+struct NbdRelayStats
+{
+    // Bytes written to nbd from websocket messages
+    uint64_t bytesToNbd = 0;
+    // Bytes of those that were copied rather than written in place
+    uint64_t bytesCopied = 0;
+    // Gathered writes to nbd
+    uint64_t nbdWrites = 0;
+    // Most websocket messages written to nbd in one write
+    size_t maxMessagesPerWrite = 0;
+    // Bytes read from nbd and sent to the websocket
+    uint64_t bytesFromNbd = 0;
+    // Websocket messages sent
+    uint64_t messagesSent = 0;
+};
+
+// Moves NBD traffic between a websocket and the nbd socket or pipes of a
+// Derived class, which provides nbdReadStream() and nbdWriteStream() and
+// inherits std::enable_shared_from_this.
+//
+// Websocket messages are queued as views of the websocket buffer and written
+// to nbd with a single gathered write.  Small messages are copied and released
+// right away so the client can keep several requests in flight; large ones
+// hold the websocket read until they are written.  Data from nbd is read into
+// one of two buffers and sent to the websocket in place, like the KVM relay.
+template <typename Derived>
+class NbdRelay
+{
+  public:
+    NbdRelay(const NbdRelay&) = delete;
+    NbdRelay(NbdRelay&&) = delete;
+    NbdRelay& operator=(const NbdRelay&) = delete;
+    NbdRelay& operator=(NbdRelay&&) = delete;
+
+    // Queues a websocket message for nbd.  whenComplete is called once data is
+    // no longer referenced.
+    void relayMessage(std::string_view data,
+                      std::function<void()>&& whenComplete)
+    {
+        if (data.empty())
+        {
+            whenComplete();
+            return;
+        }
+        PendingWrite& write = queuedWrites.emplace_back();
+        if (data.size() <= nbdCopyThreshold &&
+            queuedCopyBytes + data.size() <= nbdBufferSize)
+        {
+            write.copy = data;
+            queuedCopyBytes += data.size();
+            stats.bytesCopied += data.size();
+            whenComplete();
+        }
+        else
+        {
+            write.borrowed = data;
+            write.whenComplete = std::move(whenComplete);
+        }
+        doWrite();
+    }
+
+    const NbdRelayStats& getStats() const
+    {
+        return stats;
+    }
+
+  protected:
+    explicit NbdRelay(crow::websocket::Connection& connIn) : conn(connIn) {}
+
+    ~NbdRelay()
+    {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - startTime;
+        BMCWEB_LOG_INFO(
+            "conn:{}, NBD wrote {} bytes ({} copied) in {} writes, "
+            "read {} bytes in {} messages over {:.1f}s",
+            logPtr(&conn), stats.bytesToNbd, stats.bytesCopied,
+            stats.nbdWrites, stats.bytesFromNbd, stats.messagesSent,
+            elapsed.count());
+    }
+
+    // Starts relaying data from nbd to the websocket
+    void doRead()
+    {
+        if (doingRead)
+        {
+            return;
+        }
+        if (outputBuffers[fillIndex].size() == 0)
+        {
+            outputBuffers[fillIndex].reset();
+        }
+        if (outputBuffers[fillIndex].full())
+        {
+            // Only move on to the other buffer once all of it has been sent,
+            // so the data in it is always older
+            size_t other = 1 - fillIndex;
+            if (outputBuffers[other].size() != 0)
+            {
+                // Resumed once the websocket catches up
+                return;
+            }
+            outputBuffers[other].reset();
+            fillIndex = other;
+        }
+        size_t index = fillIndex;
+        doingRead = true;
+        derived().nbdReadStream().async_read_some(
+            outputBuffers[index].prepare(),
+            std::bind_front(&NbdRelay::afterRead, this,
+                            derived().weak_from_this(), index));
+    }
+
+    crow::websocket::Connection& conn;
+
+  private:
+    struct PendingWrite
+    {
+        std::string copy;
+        std::string_view borrowed;
+        std::function<void()> whenComplete;
+
+        std::string_view data() const
+        {
+            if (borrowed.empty())
+            {
+                return copy;
+            }
+            return borrowed;
+        }
+    };
+
+    Derived& derived()
+    {
+        return static_cast<Derived&>(*this);
+    }
+
+    void afterRead(const std::weak_ptr<Derived>& weak, size_t index,
+                   const boost::system::error_code& ec, std::size_t bytesRead)
+    {
+        std::shared_ptr<Derived> self = weak.lock();
+        if (self == nullptr)
+        {
+            return;
+        }
+        doingRead = false;
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR("conn:{}, Couldn't read from nbd: {}",
+                             logPtr(&conn), ec.message());
+            if (ec != boost::asio::error::operation_aborted)
+            {
+                conn.close("Error in reading from nbd");
+            }
+            return;
+        }
+
+        outputBuffers[index].commit(bytesRead);
+        doSend();
+        doRead();
+    }
+
+    void doSend()
+    {
+        if (doingSend)
+        {
+            return;
+        }
+        // Send the older data first.  The buffer being read into can be sent
+        // while the read is in flight, as the read only appends to it.
+        size_t index = 1 - fillIndex;
+        if (outputBuffers[index].size() == 0)
+        {
+            index = fillIndex;
+        }
+        std::string_view payload = outputBuffers[index].data();
+        if (payload.empty())
+        {
+            return;
+        }
+        doingSend = true;
+        stats.messagesSent++;
+        stats.bytesFromNbd += payload.size();
+        conn.sendEx(crow::websocket::MessageType::Binary, payload,
+                    std::bind_front(&NbdRelay::afterSend, this,
+                                    derived().shared_from_this(), index,
+                                    payload.size()));
+    }
+
+    void afterSend(const std::shared_ptr<Derived>& /*self*/, size_t index,
+                   size_t bytesSent)
+    {
+        doingSend = false;
+        outputBuffers[index].consume(bytesSent);
+        doSend();
+        doRead();
+    }
+
+    void doWrite()
+    {
+        if (!writing.empty() || queuedWrites.empty())
+        {
+            return;
+        }
+        std::swap(writing, queuedWrites);
+
+        std::vector<boost::asio::const_buffer> buffers;
+        buffers.reserve(writing.size());
+        for (const PendingWrite& write : writing)
+        {
+            buffers.emplace_back(boost::asio::buffer(write.data()));
+        }
+        stats.nbdWrites++;
+        stats.maxMessagesPerWrite =
+            std::max(stats.maxMessagesPerWrite, writing.size());
+        boost::asio::async_write(
+            derived().nbdWriteStream(), buffers,
+            std::bind_front(&NbdRelay::afterWrite, this,
+                            derived().weak_from_this()));
+    }
+
+    void afterWrite(const std::weak_ptr<Derived>& weak,
+                    const boost::system::error_code& ec, size_t bytesWritten)
+    {
+        std::shared_ptr<Derived> self = weak.lock();
+        if (self == nullptr)
+        {
+            return;
+        }
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR("conn:{}, Couldn't write to nbd: {}",
+                             logPtr(&conn), ec.message());
+            if (ec != boost::asio::error::operation_aborted)
+            {
+                conn.close("Error in writing to nbd");
+            }
+            return;
+        }
+        stats.bytesToNbd += bytesWritten;
+
+        std::vector<PendingWrite> done;
+        std::swap(done, writing);
+        for (PendingWrite& write : done)
+        {
+            queuedCopyBytes -= write.copy.size();
+            if (write.whenComplete)
+            {
+                write.whenComplete();
+            }
+        }
+        doWrite();
+    }
+
+    // Websocket messages waiting for the current write to nbd
+    std::vector<PendingWrite> queuedWrites;
+    // Websocket messages being written to nbd
+    std::vector<PendingWrite> writing;
+    size_t queuedCopyBytes = 0;
+
+    std::array<RelayBuffer<nbdBufferSize>, 2> outputBuffers;
+    // Index of the output buffer that reads from nbd go into
+    size_t fillIndex = 0;
+    bool doingRead = false;
+    bool doingSend = false;
+
+    NbdRelayStats stats;
+    std::chrono::steady_clock::time_point startTime =
+        std::chrono::steady_clock::now();
+};
+
+} // namespace nbd_relay
+} // namespace crow
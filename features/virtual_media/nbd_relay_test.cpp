@@ -0,0 +1,421 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "io_context_singleton.hpp"
+#include "nbd_relay.hpp"
+#include "websocket.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/url/url_view.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+namespace crow::nbd_relay
+{
+namespace
+{
+
+using boost::asio::local::stream_protocol;
+
+constexpr uint32_t nbdRequestMagic = 0x25609513;
+constexpr uint32_t nbdReplyMagic = 0x67446698;
+constexpr size_t nbdRequestSize = 28;
+constexpr size_t nbdReplyHeaderSize = 16;
+constexpr size_t nbdReadSize = 128UL * 1024UL;
+
+void putBigEndian(std::string& out, uint64_t value, size_t bytes)
+{
+    for (size_t i = bytes; i > 0; i--)
+    {
+        out += static_cast<char>((value >> ((i - 1) * 8)) & 0xff);
+    }
+}
+
+uint64_t getBigEndian(std::string_view in, size_t offset, size_t bytes)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; i++)
+    {
+        value = (value << 8) | static_cast<uint8_t>(in[offset + i]);
+    }
+    return value;
+}
+
+std::string readRequest(uint64_t handle, uint64_t offset, uint32_t length)
+{
+    std::string out;
+    putBigEndian(out, nbdRequestMagic, 4);
+    // Flags, then NBD_CMD_READ
+    putBigEndian(out, 0, 4);
+    putBigEndian(out, handle, 8);
+    putBigEndian(out, offset, 8);
+    putBigEndian(out, length, 4);
+    return out;
+}
+
+std::string replyHeader(uint64_t handle)
+{
+    std::string out;
+    putBigEndian(out, nbdReplyMagic, 4);
+    putBigEndian(out, 0, 4);
+    putBigEndian(out, handle, 8);
+    return out;
+}
+
+class TestRelay :
+    public NbdRelay<TestRelay>,
+    public std::enable_shared_from_this<TestRelay>
+{
+  public:
+    TestRelay(crow::websocket::Connection& connIn,
+              stream_protocol::socket&& socketIn) :
+        NbdRelay<TestRelay>(connIn), socket(std::move(socketIn))
+    {}
+
+    void start()
+    {
+        doRead();
+    }
+
+    stream_protocol::socket& nbdReadStream()
+    {
+        return socket;
+    }
+
+    stream_protocol::socket& nbdWriteStream()
+    {
+        return socket;
+    }
+
+    stream_protocol::socket socket;
+};
+
+// Websocket client standing in for the browser that serves the image.  It
+// answers NBD read requests and, like the websocket core, only hands the next
+// message to the relay once the last one is complete.
+class ImageServer : public crow::websocket::Connection
+{
+  public:
+    void sendBinary(std::string_view /*msg*/) override
+    {
+        ADD_FAILURE() << "sendBinary used by the relay";
+    }
+
+    void sendEx(crow::websocket::MessageType /*type*/, std::string_view msg,
+                std::function<void()>&& onDone) override
+    {
+        requests += msg;
+        while (requests.size() >= nbdRequestSize)
+        {
+            EXPECT_EQ(getBigEndian(requests, 0, 4), nbdRequestMagic);
+            uint64_t handle = getBigEndian(requests, 8, 8);
+            size_t length = getBigEndian(requests, 24, 4);
+            requests.erase(0, nbdRequestSize);
+
+            std::string reply = replyHeader(handle);
+            reply.append(length, static_cast<char>(handle));
+            messages.emplace_back(std::move(reply));
+        }
+        boost::asio::post(getIoContext(), std::move(onDone));
+        boost::asio::post(getIoContext(), [this]() { feed(); });
+    }
+
+    void sendText(std::string_view /*msg*/) override
+    {
+        ADD_FAILURE() << "sendText used by the relay";
+    }
+
+    void close(std::string_view /*msg*/) override
+    {
+        closed = true;
+    }
+
+    void deferRead() override {}
+
+    void resumeRead() override {}
+
+    boost::urls::url_view url() override
+    {
+        return {};
+    }
+
+    void feed()
+    {
+        if (reading || messages.empty() || relay == nullptr)
+        {
+            return;
+        }
+        reading = true;
+        relay->relayMessage(messages.front(), [this]() {
+            messages.pop_front();
+            boost::asio::post(getIoContext(), [this]() {
+                reading = false;
+                feed();
+            });
+        });
+    }
+
+    std::shared_ptr<TestRelay> relay;
+    std::string requests;
+    std::deque<std::string> messages;
+    bool reading = false;
+    bool closed = false;
+};
+
+struct RelayFixture
+{
+    RelayFixture() : client(getIoContext())
+    {
+        stream_protocol::socket relaySide(getIoContext());
+        boost::asio::local::connect_pair(relaySide, client);
+        server.relay =
+            std::make_shared<TestRelay>(server, std::move(relaySide));
+    }
+
+    ~RelayFixture()
+    {
+        // Let outstanding handlers see the relay go away
+        server.relay->socket.close();
+        server.relay.reset();
+        client.close();
+        getIoContext().restart();
+        getIoContext().poll();
+    }
+
+    RelayFixture(const RelayFixture&) = delete;
+    RelayFixture(RelayFixture&&) = delete;
+    RelayFixture& operator=(const RelayFixture&) = delete;
+    RelayFixture& operator=(RelayFixture&&) = delete;
+
+    // Runs the io context until done returns true, or a timeout
+    static bool runUntil(const std::function<bool()>& done)
+    {
+        getIoContext().restart();
+        for (int i = 0; i < 3000 && !done(); i++)
+        {
+            getIoContext().run_for(std::chrono::milliseconds(10));
+        }
+        return done();
+    }
+
+    ImageServer server;
+    stream_protocol::socket client;
+};
+
+TEST(NbdRelay, PipelinedReads)
+{
+    // Pipelined 128KiB reads, like the nbd-client kernel driver issues while
+    // an image is copied
+    constexpr size_t reads = 256;
+    constexpr size_t replySize = nbdReplyHeaderSize + nbdReadSize;
+    RelayFixture fixture;
+    fixture.server.relay->start();
+
+    std::string requests;
+    for (uint64_t handle = 0; handle < reads; handle++)
+    {
+        requests += readRequest(handle, handle * nbdReadSize, nbdReadSize);
+    }
+    std::string replies(reads * replySize, '\0');
+    bool written = false;
+    bool read = false;
+
+    boost::asio::async_write(
+        fixture.client, boost::asio::buffer(requests),
+        [&written](const boost::system::error_code& ec, size_t) {
+            EXPECT_FALSE(ec);
+            written = true;
+        });
+    boost::asio::async_read(
+        fixture.client, boost::asio::buffer(replies),
+        [&read](const boost::system::error_code& ec, size_t) {
+            EXPECT_FALSE(ec);
+            read = true;
+        });
+    ASSERT_TRUE(RelayFixture::runUntil([&]() { return written && read; }));
+
+    for (uint64_t handle = 0; handle < reads; handle++)
+    {
+        std::string_view reply =
+            std::string_view(replies).substr(handle * replySize, replySize);
+        ASSERT_EQ(reply.substr(0, nbdReplyHeaderSize), replyHeader(handle));
+        EXPECT_EQ(reply.find_first_not_of(static_cast<char>(handle),
+                                          nbdReplyHeaderSize),
+                  std::string_view::npos);
+    }
+
+    const NbdRelayStats& stats = fixture.server.relay->getStats();
+    EXPECT_EQ(stats.bytesFromNbd, requests.size());
+    EXPECT_EQ(stats.bytesToNbd, replies.size());
+    // Replies are written from the websocket buffer
+    EXPECT_EQ(stats.bytesCopied, 0U);
+    EXPECT_FALSE(fixture.server.closed);
+}
+
+TEST(NbdRelay, GathersQueuedMessages)
+{
+    RelayFixture fixture;
+    // Keep the nbd side from draining so writes back up behind each other
+    fixture.server.relay->socket.set_option(
+        boost::asio::socket_base::send_buffer_size(4096));
+    fixture.client.set_option(
+        boost::asio::socket_base::receive_buffer_size(4096));
+
+    // Error replies are header only, and small enough to be copied
+    constexpr size_t replies = 64;
+    std::string expected;
+    for (uint64_t handle = 0; handle < replies; handle++)
+    {
+        std::string reply = replyHeader(handle);
+        reply.append(1000, static_cast<char>(handle));
+        expected += reply;
+        fixture.server.messages.emplace_back(std::move(reply));
+    }
+    fixture.server.feed();
+    ASSERT_TRUE(RelayFixture::runUntil(
+        [&]() { return fixture.server.messages.empty(); }));
+
+    std::string received(expected.size(), '\0');
+    bool read = false;
+    boost::asio::async_read(
+        fixture.client, boost::asio::buffer(received),
+        [&read](const boost::system::error_code& ec, size_t) {
+            EXPECT_FALSE(ec);
+            read = true;
+        });
+    ASSERT_TRUE(RelayFixture::runUntil([&read]() { return read; }));
+    EXPECT_TRUE(received == expected);
+
+    const NbdRelayStats& stats = fixture.server.relay->getStats();
+    EXPECT_EQ(stats.bytesToNbd, expected.size());
+    EXPECT_EQ(stats.bytesCopied, expected.size());
+    EXPECT_GT(stats.maxMessagesPerWrite, 1U);
+    EXPECT_LT(stats.nbdWrites, replies);
+}
+
+// Websocket client that holds on to every sendEx completion until the test
+// releases it
+class SlowClient : public crow::websocket::Connection
+{
+  public:
+    void sendBinary(std::string_view /*msg*/) override
+    {
+        ADD_FAILURE() << "sendBinary used by the relay";
+    }
+
+    void sendEx(crow::websocket::MessageType /*type*/, std::string_view msg,
+                std::function<void()>&& onDone) override
+    {
+        EXPECT_FALSE(pendingDone) << "sendEx called with a write in flight";
+        received += msg;
+        pendingDone = std::move(onDone);
+        sending = msg;
+        sendingCopy = msg;
+    }
+
+    void sendText(std::string_view /*msg*/) override
+    {
+        ADD_FAILURE() << "sendText used by the relay";
+    }
+
+    void close(std::string_view /*msg*/) override
+    {
+        closed = true;
+    }
+
+    void deferRead() override {}
+
+    void resumeRead() override {}
+
+    boost::urls::url_view url() override
+    {
+        return {};
+    }
+
+    bool completeSend()
+    {
+        if (!pendingDone)
+        {
+            return false;
+        }
+        // The websocket writes from the caller's buffer until it's done
+        EXPECT_EQ(sending, sendingCopy) << "Buffer changed while being sent";
+        std::function<void()> onDone = std::move(pendingDone);
+        pendingDone = nullptr;
+        onDone();
+        return true;
+    }
+
+    std::string received;
+    std::function<void()> pendingDone;
+    std::string_view sending;
+    std::string sendingCopy;
+    bool closed = false;
+};
+
+void runFor(std::chrono::milliseconds duration)
+{
+    getIoContext().restart();
+    getIoContext().run_for(duration);
+}
+
+TEST(NbdRelay, SendCompletesBeforeRead)
+{
+    SlowClient client;
+    stream_protocol::socket nbd(getIoContext());
+    stream_protocol::socket relaySide(getIoContext());
+    boost::asio::local::connect_pair(relaySide, nbd);
+    std::shared_ptr<TestRelay> relay =
+        std::make_shared<TestRelay>(client, std::move(relaySide));
+    relay->start();
+
+    boost::asio::write(nbd, boost::asio::buffer(std::string_view("first")));
+    runFor(std::chrono::milliseconds(5));
+    EXPECT_EQ(client.received, "first");
+
+    // Read behind the data being sent while the client is still busy, and
+    // start the next read behind that
+    boost::asio::write(nbd, boost::asio::buffer(std::string_view("second")));
+    runFor(std::chrono::milliseconds(5));
+    EXPECT_EQ(client.received, "first");
+
+    // A reply that was read is sent as soon as the client is ready, without
+    // waiting for nbd to send more
+    EXPECT_TRUE(client.completeSend());
+    runFor(std::chrono::milliseconds(1));
+    EXPECT_EQ(client.received, "firstsecond");
+
+    boost::asio::write(nbd, boost::asio::buffer(std::string_view("third")));
+    runFor(std::chrono::milliseconds(5));
+    EXPECT_EQ(client.received, "firstsecond");
+    EXPECT_TRUE(client.completeSend());
+    runFor(std::chrono::milliseconds(1));
+    EXPECT_EQ(client.received, "firstsecondthird");
+    EXPECT_TRUE(client.completeSend());
+    EXPECT_EQ(relay->getStats().bytesFromNbd, client.received.size());
+    EXPECT_FALSE(client.closed);
+
+    relay->socket.close();
+    relay.reset();
+    nbd.close();
+    getIoContext().restart();
+    getIoContext().poll();
+}
+
+} // namespace
+} // namespace crow::nbd_relay
@@ -8,26 +8,22 @@
 #include "dbus_utility.hpp"
 #include "io_context_singleton.hpp"
 #include "logging.hpp"
+#include "nbd_relay.hpp"
 #include "websocket.hpp"
 
-#include <boost/asio/buffer.hpp>
-#include <boost/asio/error.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/readable_pipe.hpp>
 #include <boost/asio/writable_pipe.hpp>
-#include <boost/beast/core/buffers_to_string.hpp>
-#include <boost/beast/core/error.hpp>
-#include <boost/beast/core/flat_static_buffer.hpp>
 #include <boost/container/flat_map.hpp>
 #include <boost/process/v2/process.hpp>
 #include <boost/process/v2/stdio.hpp>
+#include <boost/system/error_code.hpp>
 #include <sdbusplus/message/native_types.hpp>
 #include <sdbusplus/unpack_properties.hpp>
 
 #include <cerrno>
 #include <csignal>
-#include <cstddef>
 #include <filesystem>
 #include <format>
 #include <functional>
@@ -46,16 +42,14 @@ namespace obmc_vm
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 static crow::websocket::Connection* session = nullptr;
 
-// The max network block device buffer size is 128kb plus 16bytes
-// for the message header:
-// https://github.com/NetworkBlockDevice/nbd/blob/master/doc/proto.md#simple-reply-message
-static constexpr auto nbdBufferSize = (128 * 1024 + 16) * 4;
-
-class Handler : public std::enable_shared_from_this<Handler>
+class Handler :
+    public nbd_relay::NbdRelay<Handler>,
+    public std::enable_shared_from_this<Handler>
 {
   public:
-    Handler(const std::string& media, boost::asio::io_context& ios) :
-        pipeOut(ios), pipeIn(ios),
+    Handler(crow::websocket::Connection& connIn, const std::string& media,
+            boost::asio::io_context& ios) :
+        nbd_relay::NbdRelay<Handler>(connIn), pipeOut(ios), pipeIn(ios),
         proxy(ios, "/usr/bin/nbd-proxy", {media},
               boost::process::v2::process_stdio{
                   .in = pipeIn, .out = pipeOut, .err = nullptr})
@@ -85,103 +79,25 @@ class Handler : public std::enable_shared_from_this<Handler>
 
     void connect()
     {
-        std::error_code ec;
-        if (ec)
-        {
-            BMCWEB_LOG_ERROR("Couldn't connect to nbd-proxy: {}", ec.message());
-            if (session != nullptr)
-            {
-                session->close("Error connecting to nbd-proxy");
-            }
-            return;
-        }
-        doWrite();
         doRead();
     }
 
-    void doWrite()
-    {
-        if (doingWrite)
-        {
-            BMCWEB_LOG_DEBUG("Already writing.  Bailing out");
-            return;
-        }
-
-        if (inputBuffer.size() == 0)
-        {
-            BMCWEB_LOG_DEBUG("inputBuffer empty.  Bailing out");
-            return;
-        }
-
-        doingWrite = true;
-        pipeIn.async_write_some(
-            inputBuffer.data(),
-            [this, self(shared_from_this())](const boost::beast::error_code& ec,
-                                             std::size_t bytesWritten) {
-                BMCWEB_LOG_DEBUG("Wrote {}bytes", bytesWritten);
-                doingWrite = false;
-                inputBuffer.consume(bytesWritten);
+  private:
+    friend class nbd_relay::NbdRelay<Handler>;
 
-                if (session == nullptr)
-                {
-                    return;
-                }
-                if (ec == boost::asio::error::eof)
-                {
-                    session->close("VM socket port closed");
-                    return;
-                }
-                if (ec)
-                {
-                    session->close("Error in writing to proxy port");
-                    BMCWEB_LOG_ERROR("Error in VM socket write {}", ec);
-                    return;
-                }
-                doWrite();
-            });
+    boost::asio::readable_pipe& nbdReadStream()
+    {
+        return pipeOut;
     }
 
-    void doRead()
+    boost::asio::writable_pipe& nbdWriteStream()
     {
-        std::size_t bytes = outputBuffer.capacity() - outputBuffer.size();
-
-        pipeOut.async_read_some(
-            outputBuffer.prepare(bytes),
-            [this, self(shared_from_this())](
-                const boost::system::error_code& ec, std::size_t bytesRead) {
-                BMCWEB_LOG_DEBUG("Read done.  Read {} bytes", bytesRead);
-                if (ec)
-                {
-                    BMCWEB_LOG_ERROR("Couldn't read from VM port: {}", ec);
-                    if (session != nullptr)
-                    {
-                        session->close("Error in connecting to VM port");
-                    }
-                    return;
-                }
-                if (session == nullptr)
-                {
-                    return;
-                }
-
-                outputBuffer.commit(bytesRead);
-                std::string_view payload(
-                    static_cast<const char*>(outputBuffer.data().data()),
-                    bytesRead);
-                session->sendBinary(payload);
-                outputBuffer.consume(bytesRead);
-
-                doRead();
-            });
+        return pipeIn;
     }
 
     boost::asio::readable_pipe pipeOut;
     boost::asio::writable_pipe pipeIn;
     boost::process::v2::process proxy;
-    bool doingWrite{false};
-
-    boost::beast::flat_static_buffer<nbdBufferSize> outputBuffer;
-    boost::beast::flat_static_buffer<nbdBufferSize> inputBuffer;
 };
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
@@ -193,21 +109,18 @@ namespace nbd_proxy
 {
 using boost::asio::local::stream_protocol;
 
-// The max network block device buffer size is 128kb plus 16bytes
-// for the message header:
-// https://github.com/NetworkBlockDevice/nbd/blob/master/doc/proto.md#simple-reply-message
-static constexpr auto nbdBufferSize = (128 * 1024 + 16) * 4;
-
-struct NbdProxyServer : std::enable_shared_from_this<NbdProxyServer>
+struct NbdProxyServer :
+    nbd_relay::NbdRelay<NbdProxyServer>,
+    std::enable_shared_from_this<NbdProxyServer>
 {
     NbdProxyServer(crow::websocket::Connection& connIn,
                    const std::string& socketIdIn,
                    const std::string& endpointIdIn, const std::string& pathIn) :
-        socketId(socketIdIn), endpointId(endpointIdIn), path(pathIn),
+        nbd_relay::NbdRelay<NbdProxyServer>(connIn), socketId(socketIdIn),
+        endpointId(endpointIdIn), path(pathIn),
 
         peerSocket(getIoContext()),
-        acceptor(getIoContext(), stream_protocol::endpoint(socketId)),
-        connection(connIn)
+        acceptor(getIoContext(), stream_protocol::endpoint(socketId))
     {}
 
     NbdProxyServer(const NbdProxyServer&) = delete;
@@ -255,7 +168,7 @@ struct NbdProxyServer : std::enable_shared_from_this<NbdProxyServer>
             BMCWEB_LOG_ERROR("DBus error: cannot call mount method = {}",
                              ec.message());
 
-            self->connection.close("Failed to mount media");
+            self->conn.close("Failed to mount media");
             return;
         }
     }
@@ -278,7 +191,7 @@ struct NbdProxyServer : std::enable_shared_from_this<NbdProxyServer>
             return;
         }
 
-        self->connection.resumeRead();
+        self->conn.resumeRead();
         self->peerSocket = std::move(socket);
         //  Start reading from socket
         self->doRead();
@@ -298,106 +211,17 @@ struct NbdProxyServer : std::enable_shared_from_this<NbdProxyServer>
             "xyz.openbmc_project.VirtualMedia.Proxy", "Mount");
     }
 
-    void send(std::string_view buffer, std::function<void()>&& onDone)
-    {
-        size_t copied = boost::asio::buffer_copy(
-            ws2uxBuf.prepare(buffer.size()), boost::asio::buffer(buffer));
-        ws2uxBuf.commit(copied);
-
-        doWrite(std::move(onDone));
-    }
-
   private:
-    static void afterSendEx(const std::weak_ptr<NbdProxyServer>& weak)
-    {
-        std::shared_ptr<NbdProxyServer> self2 = weak.lock();
-        if (self2 != nullptr)
-        {
-            self2->ux2wsBuf.consume(self2->ux2wsBuf.size());
-            self2->doRead();
-        }
-    }
-
-    void afterRead(const std::weak_ptr<NbdProxyServer>& weak,
-                   const boost::system::error_code& ec, size_t bytesRead)
-    {
-        if (ec)
-        {
-            BMCWEB_LOG_ERROR("UNIX socket: async_read_some error = {}",
-                             ec.message());
-            return;
-        }
-        std::shared_ptr<NbdProxyServer> self = weak.lock();
-        if (self == nullptr)
-        {
-            return;
-        }
+    friend class nbd_relay::NbdRelay<NbdProxyServer>;
 
-        // Send to websocket
-        self->ux2wsBuf.commit(bytesRead);
-        self->connection.sendEx(
-            crow::websocket::MessageType::Binary,
-            boost::beast::buffers_to_string(self->ux2wsBuf.data()),
-            std::bind_front(&NbdProxyServer::afterSendEx, weak_from_this()));
-    }
-
-    void doRead()
-    {
-        // Trigger async read
-        peerSocket.async_read_some(ux2wsBuf.prepare(nbdBufferSize),
-                                   std::bind_front(&NbdProxyServer::afterRead,
-                                                   this, weak_from_this()));
-    }
-
-    static void afterWrite(const std::weak_ptr<NbdProxyServer>& weak,
-                           std::function<void()>&& onDone,
-                           const boost::system::error_code& ec,
-                           size_t bytesWritten)
+    stream_protocol::socket& nbdReadStream()
     {
-        std::shared_ptr<NbdProxyServer> self = weak.lock();
-        if (self == nullptr)
-        {
-            return;
-        }
-
-        self->ws2uxBuf.consume(bytesWritten);
-        self->uxWriteInProgress = false;
-
-        if (ec)
-        {
-            BMCWEB_LOG_ERROR("UNIX: async_write error = {}", ec.message());
-            self->connection.close("Internal error");
-            return;
-        }
-
-        // Retrigger doWrite if there is something in buffer
-        if (self->ws2uxBuf.size() > 0)
-        {
-            self->doWrite(std::move(onDone));
-            return;
-        }
-        onDone();
+        return peerSocket;
     }
 
-    void doWrite(std::function<void()>&& onDone)
+    stream_protocol::socket& nbdWriteStream()
     {
-        if (uxWriteInProgress)
-        {
-            BMCWEB_LOG_ERROR("Write in progress");
-            return;
-        }
-
-        if (ws2uxBuf.size() == 0)
-        {
-            BMCWEB_LOG_ERROR("No data to write to UNIX socket");
-            return;
-        }
-
-        uxWriteInProgress = true;
-        peerSocket.async_write_some(
-            ws2uxBuf.data(),
-            std::bind_front(&NbdProxyServer::afterWrite, weak_from_this(),
-                            std::move(onDone)));
+        return peerSocket;
     }
 
     // Keeps UNIX socket endpoint file path
@@ -405,21 +229,11 @@ struct NbdProxyServer : std::enable_shared_from_this<NbdProxyServer>
     const std::string endpointId;
     const std::string path;
 
-    bool uxWriteInProgress = false;
-
-    // UNIX => WebSocket buffer
-    boost::beast::flat_static_buffer<nbdBufferSize> ux2wsBuf;
-
-    // WebSocket => UNIX buffer
-    boost::beast::flat_static_buffer<nbdBufferSize> ws2uxBuf;
-
     // The socket used to communicate with the client.
     stream_protocol::socket peerSocket;
 
     // Default acceptor for UNIX socket
     stream_protocol::acceptor acceptor;
-
-    crow::websocket::Connection& connection;
 };
 
 using SessionMap = boost::container::flat_map<crow::websocket::Connection*,
@@ -530,7 +344,7 @@ inline void onMessage(crow::websocket::Connection& conn, std::string_view data,
         return;
     }
 
-    session->second->send(data, std::move(whenComplete));
+    session->second->relayMessage(data, std::move(whenComplete));
 }
 } // namespace nbd_proxy
 
@@ -585,7 +399,8 @@ inline void requestRoutes(App& app)
                 // media is the last digit of the endpoint /vm/0/0. A future
                 // enhancement can include supporting different endpoint values.
                 const char* media = "0";
-                handler = std::make_shared<Handler>(media, getIoContext());
+                handler =
+                    std::make_shared<Handler>(conn, media, getIoContext());
                 handler->connect();
             })
             // ast-grep-ignore: long-lambda
@@ -598,27 +413,18 @@ inline void requestRoutes(App& app)
 
                 session = nullptr;
                 handler->doClose();
-                handler->inputBuffer.clear();
-                handler->outputBuffer.clear();
                 handler.reset();
             })
-            // ast-grep-ignore: long-lambda
-            .onmessage([](crow::websocket::Connection& conn,
-                          const std::string& data, bool) {
-                if (data.length() > handler->inputBuffer.capacity() -
-                                        handler->inputBuffer.size())
+            .onmessageex([](crow::websocket::Connection& conn,
+                            std::string_view data,
+                            crow::websocket::MessageType /*type*/,
+                            std::function<void()>&& whenComplete) {
+                if (&conn != session || handler == nullptr)
                 {
-                    BMCWEB_LOG_ERROR("Buffer overrun when writing {} bytes",
-                                     data.length());
-                    conn.close("Buffer overrun");
+                    whenComplete();
                     return;
                 }
-
-                size_t copied = boost::asio::buffer_copy(
-                    handler->inputBuffer.prepare(data.size()),
-                    boost::asio::buffer(data));
-                handler->inputBuffer.commit(copied);
-                handler->doWrite();
+                handler->relayMessage(data, std::move(whenComplete));
             });
     }
 }
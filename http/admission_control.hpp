@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "async_resp.hpp"
+#include "http_request.hpp"
+#include "http_response.hpp"
+#include "io_context_singleton.hpp"
+#include "logging.hpp"
+
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <boost/container/flat_map.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace crow
+{
+
+// Most connections open at once
+constexpr size_t maxConnections = 200;
+// Connections only kept once their client authenticates, so that logged in
+// users can still connect while scanners hold the rest
+constexpr size_t reservedAuthenticatedConnections = 40;
+// Most connections from one address, other than loopback
+constexpr size_t maxConnectionsPerIp = 64;
+// Most requests being handled at once before new ones wait in priority order
+constexpr size_t maxActiveRequests = 32;
+
+enum class Admission
+{
+    Rejected,
+    Admitted,
+    // Admitted into a reserved slot, which the client has to authenticate
+    // to keep
+    MustAuthenticate,
+};
+
+// Decides whether to accept a new connection.  Every admitted connection has
+// to be released exactly once.
+class ConnectionAdmission
+{
+  public:
+    ConnectionAdmission(size_t maxConnectionsIn, size_t reservedIn,
+                        size_t maxPerIpIn) :
+        maxTotal(maxConnectionsIn), reserved(reservedIn), maxPerIp(maxPerIpIn)
+    {}
+
+    Admission admit(const boost::asio::ip::address& ip)
+    {
+        if (total >= maxTotal)
+        {
+            BMCWEB_LOG_CRITICAL("Max connection count exceeded. Request {}",
+                                ip.to_string());
+            return Admission::Rejected;
+        }
+        auto it = perIp.find(ip);
+        if (it != perIp.end() && it->second >= maxPerIp && !ip.is_loopback())
+        {
+            BMCWEB_LOG_WARNING("Max connection count for {} exceeded",
+                               ip.to_string());
+            return Admission::Rejected;
+        }
+        perIp[ip]++;
+        total++;
+        if (total - authenticatedCount > maxTotal - reserved)
+        {
+            return Admission::MustAuthenticate;
+        }
+        return Admission::Admitted;
+    }
+
+    // The client of an admitted connection authenticated.  Called at most
+    // once per connection.
+    void authenticated()
+    {
+        authenticatedCount++;
+    }
+
+    void release(const boost::asio::ip::address& ip, bool wasAuthenticated)
+    {
+        total--;
+        if (wasAuthenticated)
+        {
+            authenticatedCount--;
+        }
+        auto it = perIp.find(ip);
+        if (it != perIp.end() && --it->second == 0)
+        {
+            perIp.erase(it);
+        }
+    }
+
+    size_t connections() const
+    {
+        return total;
+    }
+
+    static ConnectionAdmission& getInstance()
+    {
+        static ConnectionAdmission admission(
+            maxConnections, reservedAuthenticatedConnections,
+            maxConnectionsPerIp);
+        return admission;
+    }
+
+  private:
+    size_t maxTotal;
+    size_t reserved;
+    size_t maxPerIp;
+    size_t total = 0;
+    size_t authenticatedCount = 0;
+    boost::container::flat_map<boost::asio::ip::address, size_t> perIp;
+};
+
+enum class RequestPriority : uint8_t
+{
+    // Actions such as ComputerSystem.Reset, and logins
+    Control,
+    // Other requests that change something
+    Modify,
+    // Reads, including bulk log and dump downloads
+    Read,
+};
+
+// Whether a request creates a session.  |target| is the request target, and
+// may include a query string.
+inline bool isLoginRequest(boost::beast::http::verb method,
+                           std::string_view target)
+{
+    if (method != boost::beast::http::verb::post)
+    {
+        return false;
+    }
+    std::string_view path = target.substr(0, target.find('?'));
+    return path == "/redfish/v1/SessionService/Sessions" ||
+           path == "/redfish/v1/SessionService/Sessions/" || path == "/login";
+}
+
+inline RequestPriority getRequestPriority(boost::beast::http::verb method,
+                                          std::string_view path)
+{
+    using boost::beast::http::verb;
+    if (method == verb::get || method == verb::head ||
+        method == verb::options)
+    {
+        return RequestPriority::Read;
+    }
+    if (isLoginRequest(method, path) ||
+        (method == verb::post &&
+         path.find("/Actions/") != std::string_view::npos))
+    {
+        return RequestPriority::Control;
+    }
+    return RequestPriority::Modify;
+}
+
+// Limits how many requests are handled at once.  Once the limit is reached,
+// new requests wait and are started in priority order as others complete, so
+// that a power control action doesn't queue up behind a burst of log reads.
+class RequestQueue
+{
+  public:
+    using StartHandler = std::function<void()>;
+
+    explicit RequestQueue(size_t maxActiveIn) : maxActive(maxActiveIn) {}
+
+    // Starts the request now if there is a free slot, otherwise once it is
+    // the oldest waiting request of the highest priority.  A started request
+    // holds its slot until it calls release().
+    void enqueue(RequestPriority priority, StartHandler&& start)
+    {
+        if (active < maxActive && waitingCount == 0)
+        {
+            startRequest(start);
+            return;
+        }
+        waiting[static_cast<size_t>(priority)].emplace_back(std::move(start));
+        waitingCount++;
+    }
+
+    void release()
+    {
+        active--;
+        if (waitingCount == 0 || startPending)
+        {
+            return;
+        }
+        // Start the next request from the event loop, so a request that
+        // completes straight away doesn't recurse into the next one
+        startPending = true;
+        boost::asio::post(getIoContext(), [this]() { startWaiting(); });
+    }
+
+    size_t activeRequests() const
+    {
+        return active;
+    }
+
+    size_t waitingRequests() const
+    {
+        return waitingCount;
+    }
+
+    static RequestQueue& getInstance()
+    {
+        static RequestQueue queue(maxActiveRequests);
+        return queue;
+    }
+
+  private:
+    void startRequest(const StartHandler& start)
+    {
+        // Count the slot first, the request may complete before start returns
+        active++;
+        start();
+    }
+
+    void startWaiting()
+    {
+        startPending = false;
+        for (std::deque<StartHandler>& queue : waiting)
+        {
+            while (!queue.empty() && active < maxActive)
+            {
+                StartHandler start = std::move(queue.front());
+                queue.pop_front();
+                waitingCount--;
+                startRequest(start);
+            }
+        }
+    }
+
+    size_t maxActive;
+    size_t active = 0;
+    size_t waitingCount = 0;
+    bool startPending = false;
+    std::array<std::deque<StartHandler>, 3> waiting;
+};
+
+// Passes a request to the handler once the request queue lets it start.  The
+// request holds its slot until the response completes.
+template <typename Handler>
+void queueRequest(Handler* handler, const std::shared_ptr<Request>& req,
+                  const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    RequestQueue::getInstance().enqueue(
+        getRequestPriority(req->method(), req->url().path()),
+        [handler, req, asyncResp]() {
+            std::function<void(Response&)> done =
+                asyncResp->res.releaseCompleteRequestHandler();
+            asyncResp->res.setCompleteRequestHandler(
+                [done{std::move(done)}](Response& res) {
+                    RequestQueue::getInstance().release();
+                    if (done)
+                    {
+                        done(res);
+                    }
+                });
+            handler->handle(req, asyncResp);
+        });
+}
+
+} // namespace crow
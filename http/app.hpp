@@ -8,6 +8,7 @@
 #include "http_server.hpp"
 #include "io_context_singleton.hpp"
 #include "logging.hpp"
+#include "route_metrics.hpp"
 #include "routing.hpp"
 #include "routing/dynamicrule.hpp"
 #include "str_utility.hpp"
@@ -209,6 +210,11 @@ class App
         return router.getRoutes(parent);
     }
 
+    std::vector<RouteMetricsEntry> getRouteMetrics() const
+    {
+        return router.getRouteMetrics();
+    }
+
     std::optional<server_type> server;
 
     Router router;
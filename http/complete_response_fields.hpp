@@ -132,35 +132,47 @@ inline void completeResponseFields(
     BMCWEB_LOG_INFO("Response: {}", res.resultInt());
     addSecurityHeaders(res);
 
-    res.setResponseEtagAndHandleNotModified();
-    if (res.jsonValue.is_structured())
+    if (!res.jsonValue.is_structured())
     {
-        using http_helpers::ContentType;
-        std::array<ContentType, 3> allowed{ContentType::CBOR, ContentType::JSON,
-                                           ContentType::HTML};
-        ContentType preferred = getPreferredContentType(accepts, allowed);
+        res.setResponseEtagAndHandleNotModified();
+        handleEncoding(acceptEncoding, res);
+        return;
+    }
 
-        if (preferred == ContentType::HTML)
-        {
-            json_html_util::prettyPrintJson(res);
-        }
-        else if (preferred == ContentType::CBOR)
+    using http_helpers::ContentType;
+    std::array<ContentType, 3> allowed{ContentType::CBOR, ContentType::JSON,
+                                       ContentType::HTML};
+    ContentType preferred = getPreferredContentType(accepts, allowed);
+
+    if (preferred == ContentType::HTML)
+    {
+        // Only browsers ask for HTML, so there's no ETag to compute
+        json_html_util::prettyPrintJson(res);
+    }
+    else if (preferred == ContentType::CBOR)
+    {
+        std::string cbor;
+        nlohmann::json::to_cbor(res.jsonValue, cbor);
+        if (!res.setResponseEtagAndHandleNotModified(cbor))
         {
             res.addHeader(boost::beast::http::field::content_type,
                           "application/cbor");
-            std::string cbor;
-            nlohmann::json::to_cbor(res.jsonValue, cbor);
             res.write(std::move(cbor));
         }
-        else
+    }
+    else
+    {
+        // Technically preferred could also be NoMatch here, but we'd
+        // like to default to something rather than return 400 for
+        // backward compatibility.
+        // The ETag is hashed from the serialized body, so serialize once
+        // and use it for both.
+        std::string body = serializeJsonBody(res.jsonValue);
+        if (!res.setResponseEtagAndHandleNotModified(body))
         {
-            // Technically preferred could also be NoMatch here, but we'd
-            // like to default to something rather than return 400 for
-            // backward compatibility.
             res.addHeader(boost::beast::http::field::content_type,
                           "application/json");
-            res.write(res.jsonValue.dump(
-                2, ' ', true, nlohmann::json::error_handler_t::replace));
+            res.write(std::move(body));
         }
     }
 
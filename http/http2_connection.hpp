@@ -3,6 +3,7 @@
 #pragma once
 #include "bmcweb_config.h"
 
+#include "admission_control.hpp"
 #include "async_resp.hpp"
 #include "authentication.hpp"
 #include "complete_response_fields.hpp"
@@ -225,8 +226,21 @@ class HTTP2Connection :
         Response& res = stream.res;
         res = std::move(completedRes);
 
+        std::shared_ptr<RouteTimer> timer;
+        if (stream.req != nullptr)
+        {
+            timer = stream.req->routeTimer;
+        }
+        if (timer != nullptr)
+        {
+            timer->serializationStarted();
+        }
         completeResponseFields(stream.accept, stream.acceptEnc, res);
         res.addHeader(boost::beast::http::field::date, getCachedDateStr());
+        if (timer != nullptr)
+        {
+            timer->finish(res.size().value_or(0));
+        }
         boost::urls::url_view urlView;
         if (stream.req != nullptr)
         {
@@ -351,7 +365,7 @@ class HTTP2Connection :
             asyncResp->res.setExpectedEtag(expectedEtag);
         }
         it->second.req->ipAddress = ip;
-        handler->handle(it->second.req, asyncResp);
+        queueRequest(handler, it->second.req, asyncResp);
         return 0;
     }
 
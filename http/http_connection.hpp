@@ -3,6 +3,7 @@
 #pragma once
 #include "bmcweb_config.h"
 
+#include "admission_control.hpp"
 #include "async_resp.hpp"
 #include "authentication.hpp"
 #include "complete_response_fields.hpp"
@@ -60,9 +61,6 @@
 namespace crow
 {
 
-// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
-static int connectionCount = 0;
-
 // request body limit size set by the BMCWEB_HTTP_BODY_LIMIT option
 constexpr uint64_t httpReqBodyLimit = 1024UL * 1024UL * BMCWEB_HTTP_BODY_LIMIT;
 
@@ -92,10 +90,7 @@ class Connection :
     {
         initParser();
 
-        connectionCount++;
-
-        BMCWEB_LOG_DEBUG("{} Connection created, total {}", logPtr(this),
-                         connectionCount);
+        BMCWEB_LOG_DEBUG("{} Connection created", logPtr(this));
     }
 
     ~Connection()
@@ -103,9 +98,12 @@ class Connection :
         res.releaseCompleteRequestHandler();
         cancelDeadlineTimer();
 
-        connectionCount--;
+        if (admission != Admission::Rejected)
+        {
+            ConnectionAdmission::getInstance().release(ip, clientAuthenticated);
+        }
         BMCWEB_LOG_DEBUG("{} Connection closed, total {}", logPtr(this),
-                         connectionCount);
+                         ConnectionAdmission::getInstance().connections());
     }
 
     Connection(const Connection&) = delete;
@@ -206,16 +204,14 @@ class Connection :
 
     void start()
     {
-        BMCWEB_LOG_DEBUG("{} Connection started, total {}", logPtr(this),
-                         connectionCount);
         readClientIp();
-        if (connectionCount >= 200)
+        admission = ConnectionAdmission::getInstance().admit(ip);
+        if (admission == Admission::Rejected)
         {
-            BMCWEB_LOG_CRITICAL("{} Max connection count exceeded. Request {}",
-                                logPtr(this), ip.to_string());
-
             return;
         }
+        BMCWEB_LOG_DEBUG("{} Connection started, total {}", logPtr(this),
+                         ConnectionAdmission::getInstance().connections());
 
         if constexpr (BMCWEB_MUTUAL_TLS_AUTH)
         {
@@ -256,7 +252,7 @@ class Connection :
             mtlsSession = verifyMtlsUser(ip, ssl);
             if (mtlsSession != nullptr)
             {
-                BMCWEB_LOG_DEBUG("{} Generated TLS session: {}", logPtr(this),
+                BMCWEB_LOG_DEBUG("{} Using TLS session: {}", logPtr(this),
                                  mtlsSession->uniqueId);
             }
         }
@@ -460,7 +456,7 @@ class Connection :
         {
             asyncResp->res.setExpectedEtag(expectedEtag);
         }
-        handler->handle(req, asyncResp);
+        queueRequest(handler, req, asyncResp);
     }
 
     void hardClose()
@@ -486,14 +482,8 @@ class Connection :
 
         if (httpType == HttpType::HTTPS)
         {
-            if (mtlsSession != nullptr)
-            {
-                BMCWEB_LOG_DEBUG("{} Removing TLS session: {}", logPtr(this),
-                                 mtlsSession->uniqueId);
-                persistent_data::SessionStore::getInstance().removeSession(
-                    mtlsSession);
-            }
-
+            // The mTLS session outlives the connection so that the client can
+            // reconnect with it.  It expires like other idle sessions.
             adaptor.async_shutdown(std::bind_front(
                 &self_type::tlsShutdownComplete, this, shared_from_this()));
         }
@@ -508,8 +498,21 @@ class Connection :
         res = std::move(thisRes);
         res.keepAlive(keepAlive);
 
+        std::shared_ptr<RouteTimer> timer;
+        if (req != nullptr)
+        {
+            timer = req->routeTimer;
+        }
+        if (timer != nullptr)
+        {
+            timer->serializationStarted();
+        }
         completeResponseFields(accept, acceptEncoding, res);
         res.addHeader(boost::beast::http::field::date, getCachedDateStr());
+        if (timer != nullptr)
+        {
+            timer->finish(res.size().value_or(0));
+        }
 
         doWrite();
 
@@ -542,6 +545,38 @@ class Connection :
     }
 
   private:
+    // Counts the connection as authenticated once a request on it is.  A
+    // connection in a reserved slot is closed when its client sends anything
+    // other than a login without authenticating.  Returns false if the
+    // connection is being closed.
+    bool checkAdmission(boost::beast::http::verb method,
+                        std::string_view target)
+    {
+        if (clientAuthenticated)
+        {
+            return true;
+        }
+        if (userSession != nullptr || !authenticationEnabled)
+        {
+            clientAuthenticated = true;
+            ConnectionAdmission::getInstance().authenticated();
+            return true;
+        }
+        // A client in a reserved slot can only log in
+        if (admission != Admission::MustAuthenticate ||
+            isLoginRequest(method, target))
+        {
+            return true;
+        }
+        BMCWEB_LOG_WARNING(
+            "{} Closing unauthenticated connection in a reserved slot {}",
+            logPtr(this), ip.to_string());
+        res.result(boost::beast::http::status::service_unavailable);
+        keepAlive = false;
+        doWrite();
+        return false;
+    }
+
     uint64_t getContentLengthLimit()
     {
         if constexpr (!BMCWEB_INSECURE_DISABLE_AUTH)
@@ -650,6 +685,11 @@ class Connection :
                 ip, res, method, value.base(), mtlsSession);
         }
 
+        if (!checkAdmission(value.method(), value.target()))
+        {
+            return;
+        }
+
         if (!handleContentLengthError())
         {
             return;
@@ -973,6 +1013,9 @@ class Connection :
 
     std::shared_ptr<persistent_data::UserSession> userSession;
     std::shared_ptr<persistent_data::UserSession> mtlsSession;
+    // Rejected until start() admits the connection
+    Admission admission = Admission::Rejected;
+    bool clientAuthenticated = false;
 
     boost::asio::steady_timer timer;
 
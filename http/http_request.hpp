@@ -3,6 +3,7 @@
 #pragma once
 
 #include "http_body.hpp"
+#include "route_metrics.hpp"
 #include "sessions.hpp"
 
 #include <boost/asio/ip/address.hpp>
@@ -41,6 +42,10 @@ struct Request
     std::shared_ptr<persistent_data::UserSession> session;
 
     std::string userRole;
+
+    // Set by the router once the request matches a route
+    std::shared_ptr<RouteTimer> routeTimer;
+
     Request(Body&& reqIn, std::error_code& ec) : req(std::move(reqIn))
     {
         if (!setUrlInfo())
@@ -62,7 +67,10 @@ struct Request
 
     Request copy() const
     {
-        return {*this};
+        Request copied(*this);
+        // A copy is routed, and timed, on its own
+        copied.routeTimer = nullptr;
+        return copied;
     }
 
     void addHeader(std::string_view key, std::string_view value)
@@ -19,6 +19,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <format>
 #include <functional>
 #include <iterator>
 #include <optional>
@@ -41,6 +42,20 @@ enum class OpenCode
     InternalError,
 };
 
+// Serializes a json body the way every JSON response is written
+inline std::string serializeJsonBody(const nlohmann::json& json)
+{
+    return json.dump(2, ' ', true, nlohmann::json::error_handler_t::replace);
+}
+
+// ETag of a json body, hashed from the bytes sent rather than from the json
+// tree, so that it comes from the serialization the response needs anyway
+inline std::string getSerializedJsonEtag(std::string_view serialized)
+{
+    return std::format("\"{:08X}\"",
+                       std::hash<std::string_view>{}(serialized));
+}
+
 struct Response
 {
     template <typename Adaptor, typename Handler>
@@ -48,6 +63,9 @@ struct Response
 
     http::response<bmcweb::HttpBody> response;
 
+    // Objects keep their keys sorted.  Handlers fill in properties as their
+    // D-Bus calls return, in no fixed order, and sorted keys keep the body,
+    // and so the ETag, the same from one request to the next.
     nlohmann::json jsonValue;
     using fields_type = http::header<false, http::fields>;
     fields_type& fields()
@@ -272,8 +290,7 @@ struct Response
             return currentOverrideEtag.value();
         }
 
-        size_t hashval = std::hash<nlohmann::json>{}(jsonValue);
-        return std::format("\"{:08X}\"", hashval);
+        return getSerializedJsonEtag(serializeJsonBody(jsonValue));
     }
 
     void write(std::string&& bodyPart)
@@ -324,13 +341,23 @@ struct Response
         {
             return;
         }
-        std::string hexVal = getCurrentEtag();
-        addHeader(http::field::etag, hexVal);
-        if (requestExpectedEtag && hexVal == *requestExpectedEtag)
+        setEtagAndHandleNotModified(getCurrentEtag());
+    }
+
+    // Same as above, hashing the body the caller serialized from jsonValue
+    // instead of serializing it again as JSON.  Returns true if the client
+    // already has the response and the body isn't needed.
+    bool setResponseEtagAndHandleNotModified(std::string_view serialized)
+    {
+        if (jsonValue.empty() || result() != http::status::ok)
         {
-            jsonValue = nullptr;
-            result(http::status::not_modified);
+            return false;
         }
+        if (currentOverrideEtag)
+        {
+            return setEtagAndHandleNotModified(*currentOverrideEtag);
+        }
+        return setEtagAndHandleNotModified(getSerializedJsonEtag(serialized));
     }
 
     std::optional<std::string_view> getExpectedEtag() const
@@ -390,6 +417,18 @@ struct Response
     }
 
   private:
+    bool setEtagAndHandleNotModified(std::string etag)
+    {
+        bool notModified = requestExpectedEtag && etag == *requestExpectedEtag;
+        addHeader(http::field::etag, etag);
+        if (notModified)
+        {
+            jsonValue = nullptr;
+            result(http::status::not_modified);
+        }
+        return notModified;
+    }
+
     std::optional<std::string> requestExpectedEtag;
     std::optional<std::string> currentOverrideEtag;
     bool completed = false;
@@ -7,6 +7,7 @@
 #include "ossl_wrappers.hpp"
 #include "sessions.hpp"
 #include "str_utility.hpp"
+#include "utils/ip_utils.hpp"
 
 #include <bit>
 #include <cstddef>
@@ -26,9 +27,11 @@ extern "C"
 #include "logging.hpp"
 
 #include <boost/asio/ip/address.hpp>
+#include <boost/container/flat_map.hpp>
 
 #include <memory>
 #include <string_view>
+#include <utility>
 
 bool isUPNMatch(std::string_view upn, std::string_view hostname)
 {
@@ -160,6 +163,108 @@ static std::string getUsernameFromCert(OpenSSLX509& x509)
     }
 }
 
+namespace
+{
+
+struct CachedMtlsSession
+{
+    std::weak_ptr<persistent_data::UserSession> session;
+    // The username was parsed from the certificate with these settings
+    persistent_data::MTLSCommonNameParseMode parseMode =
+        persistent_data::MTLSCommonNameParseMode::Invalid;
+    std::string hostname;
+};
+
+// Sessions of clients that authenticated with a certificate, by the
+// certificate fingerprint.  Clients that reconnect get their session back
+// instead of a new one each time.
+boost::container::flat_map<std::string, CachedMtlsSession>& getMtlsSessions()
+{
+    static boost::container::flat_map<std::string, CachedMtlsSession>
+        sessions;
+    return sessions;
+}
+
+// Hostname used to match the UPN, or empty when the parse mode doesn't use it
+std::string getHostNameForParseMode(
+    persistent_data::MTLSCommonNameParseMode parseMode)
+{
+    if (parseMode !=
+        persistent_data::MTLSCommonNameParseMode::UserPrincipalName)
+    {
+        return "";
+    }
+    return getHostName();
+}
+
+// Looks up the session of a certificate that connected before.  The session
+// is only reused while it is still in the session store, which drops it once
+// it has been idle for the session timeout, or on logout, or when the user is
+// removed.
+std::shared_ptr<persistent_data::UserSession> findCachedMtlsSession(
+    const std::string& fingerprint, const boost::asio::ip::address& clientIp)
+{
+    auto& sessions = getMtlsSessions();
+    auto it = sessions.find(fingerprint);
+    if (it == sessions.end())
+    {
+        return nullptr;
+    }
+    std::shared_ptr<persistent_data::UserSession> session =
+        it->second.session.lock();
+    persistent_data::SessionStore& store =
+        persistent_data::SessionStore::getInstance();
+    persistent_data::MTLSCommonNameParseMode parseMode =
+        store.getAuthMethodsConfig().mTLSCommonNameParsingMode;
+    if (session == nullptr ||
+        store.loginSessionByToken(session->sessionToken) != session)
+    {
+        sessions.erase(it);
+        return nullptr;
+    }
+    if (it->second.parseMode != parseMode ||
+        it->second.hostname != getHostNameForParseMode(parseMode) ||
+        session->clientIp != redfish::ip_util::toString(clientIp))
+    {
+        // A new session is made for this connection, so the old one would
+        // only wait for its idle timeout
+        store.removeSession(session);
+        sessions.erase(it);
+        return nullptr;
+    }
+    return session;
+}
+
+void cacheMtlsSession(
+    std::string&& fingerprint,
+    const std::shared_ptr<persistent_data::UserSession>& session)
+{
+    auto& sessions = getMtlsSessions();
+    // Entries are checked when they are used, so drop the ones whose session
+    // is gone before adding another
+    auto it = sessions.begin();
+    while (it != sessions.end())
+    {
+        if (it->second.session.expired())
+        {
+            it = sessions.erase(it);
+            continue;
+        }
+        it++;
+    }
+
+    persistent_data::MTLSCommonNameParseMode parseMode =
+        persistent_data::SessionStore::getInstance()
+            .getAuthMethodsConfig()
+            .mTLSCommonNameParsingMode;
+    CachedMtlsSession& cached = sessions[std::move(fingerprint)];
+    cached.session = session;
+    cached.parseMode = parseMode;
+    cached.hostname = getHostNameForParseMode(parseMode);
+}
+
+} // namespace
+
 std::shared_ptr<persistent_data::UserSession> verifyMtlsUser(
     const boost::asio::ip::address& clientIp, OpenSSLSSL& ssl)
 {
@@ -194,6 +299,19 @@ std::shared_ptr<persistent_data::UserSession> verifyMtlsUser(
         return nullptr;
     }
 
+    std::string fingerprint = peerCert->getFingerprint();
+    if (!fingerprint.empty())
+    {
+        std::shared_ptr<persistent_data::UserSession> session =
+            findCachedMtlsSession(fingerprint, clientIp);
+        if (session != nullptr)
+        {
+            BMCWEB_LOG_DEBUG("Reusing TLS session {} of user {}",
+                             session->uniqueId, session->username);
+            return session;
+        }
+    }
+
     std::string sslUser = getUsernameFromCert(*peerCert);
     if (sslUser.empty())
     {
@@ -202,7 +320,13 @@ std::shared_ptr<persistent_data::UserSession> verifyMtlsUser(
     }
 
     std::string unsupportedClientId;
-    return persistent_data::SessionStore::getInstance().generateUserSession(
-        sslUser, clientIp, unsupportedClientId,
-        persistent_data::SessionType::MutualTLS);
+    std::shared_ptr<persistent_data::UserSession> session =
+        persistent_data::SessionStore::getInstance().generateUserSession(
+            sslUser, clientIp, unsupportedClientId,
+            persistent_data::SessionType::MutualTLS);
+    if (session != nullptr && !fingerprint.empty())
+    {
+        cacheMtlsSession(std::move(fingerprint), session);
+    }
+    return session;
 }
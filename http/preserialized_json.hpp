@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "http_body.hpp"
+#include "http_request.hpp"
+#include "http_response.hpp"
+#include "http_utility.hpp"
+#include "zstd_compressor.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/status.hpp>
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace crow
+{
+
+// A JSON document serialized once and written to many responses, for
+// resources that don't change while bmcweb runs
+struct PreserializedJson
+{
+    std::string etag;
+    // May be left empty to save memory when zstd is kept
+    std::string json;
+    // Empty when zstd isn't compiled in
+    std::string zstd;
+};
+
+inline std::string compressZstd([[maybe_unused]] std::string_view data)
+{
+#ifdef HAVE_ZSTD
+    bmcweb::ZstdCompressor compressor;
+    if (!compressor.init(data.size()))
+    {
+        return "";
+    }
+    std::span<const uint8_t> dataIn(
+        std::bit_cast<const uint8_t*>(data.data()), data.size());
+    std::optional<std::span<const uint8_t>> compressed =
+        compressor.compress(dataIn, false);
+    if (!compressed)
+    {
+        return "";
+    }
+    return {std::bit_cast<const char*>(compressed->data()),
+            compressed->size()};
+#else
+    return "";
+#endif
+}
+
+inline PreserializedJson preserializeJson(std::string&& json)
+{
+    PreserializedJson out;
+    out.etag = getSerializedJsonEtag(json);
+    out.zstd = compressZstd(json);
+    out.json = std::move(json);
+    return out;
+}
+
+// Serializes and hashes the way completeResponseFields() and
+// Response::getCurrentEtag() do, so the body and ETag match what the
+// document would get as a jsonValue
+inline PreserializedJson preserializeJson(const nlohmann::json& value)
+{
+    return preserializeJson(serializeJsonBody(value));
+}
+
+// Query parameters need the document as a jsonValue, and so do clients that
+// prefer CBOR or HTML
+inline bool canUsePreserializedJson(const Request& req)
+{
+    if (!req.url().params().empty())
+    {
+        return false;
+    }
+    using http_helpers::ContentType;
+    std::array<ContentType, 3> allowed{ContentType::CBOR, ContentType::JSON,
+                                       ContentType::HTML};
+    ContentType preferred = http_helpers::getPreferredContentType(
+        req.getHeaderValue(boost::beast::http::field::accept), allowed);
+    return preferred != ContentType::CBOR && preferred != ContentType::HTML;
+}
+
+// Writes the document, or a 304 if the client already has it.  Returns false
+// when only the zstd form is kept and the client can't take it, leaving the
+// body for the caller to write.
+inline bool writePreserializedJson(const Request& req, Response& res,
+                                   const PreserializedJson& doc)
+{
+    res.addHeader(boost::beast::http::field::content_type, "application/json");
+    res.addHeader(boost::beast::http::field::etag, doc.etag);
+    if (req.getHeaderValue(boost::beast::http::field::if_none_match) ==
+        doc.etag)
+    {
+        res.result(boost::beast::http::status::not_modified);
+        return true;
+    }
+
+    using http_helpers::Encoding;
+    std::array<Encoding, 1> allowedEnc{Encoding::ZSTD};
+    if (!doc.zstd.empty() &&
+        http_helpers::getPreferredEncoding(
+            req.getHeaderValue(boost::beast::http::field::accept_encoding),
+            allowedEnc) == Encoding::ZSTD)
+    {
+        res.write(std::string(doc.zstd));
+        res.addHeader(boost::beast::http::field::content_encoding, "zstd");
+        res.response.body().compressionType = bmcweb::CompressionType::Zstd;
+        res.response.body().clientCompressionType =
+            bmcweb::CompressionType::Zstd;
+        return true;
+    }
+    if (doc.json.empty())
+    {
+        return false;
+    }
+    res.write(std::string(doc.json));
+    return true;
+}
+
+} // namespace crow
@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace crow
+{
+
+// Latency histogram with fixed buckets, in the layout Prometheus uses
+class LatencyHistogram
+{
+  public:
+    // Upper bounds of the buckets in microseconds.  Larger values go in a
+    // final +Inf bucket.
+    static constexpr std::array<uint64_t, 14> bucketBounds{
+        500,    1000,   2500,    5000,    10000,   25000,   50000,
+        100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000};
+
+    void record(std::chrono::microseconds duration)
+    {
+        uint64_t value = duration.count() < 0
+                             ? 0U
+                             : static_cast<uint64_t>(duration.count());
+        size_t bucket = 0;
+        while (bucket < bucketBounds.size() && value > bucketBounds[bucket])
+        {
+            bucket++;
+        }
+        buckets[bucket]++;
+        count++;
+        sum += value;
+    }
+
+    uint64_t getCount() const
+    {
+        return count;
+    }
+
+    // Total of all recorded durations in microseconds
+    uint64_t getSum() const
+    {
+        return sum;
+    }
+
+    // Number of values in each bucket, not cumulative
+    const std::array<uint64_t, bucketBounds.size() + 1>& getBuckets() const
+    {
+        return buckets;
+    }
+
+  private:
+    std::array<uint64_t, bucketBounds.size() + 1> buckets{};
+    uint64_t count = 0;
+    uint64_t sum = 0;
+};
+
+// Request statistics of one route
+struct RouteMetrics
+{
+    uint64_t requests = 0;
+    uint64_t inFlight = 0;
+    uint64_t responseBytes = 0;
+    // From matching the route until the response is serialized
+    LatencyHistogram latency;
+    // Spent in the handler before it returned
+    LatencyHistogram handlerTime;
+    // Waiting for the response to complete outside of the handler, which is
+    // mostly waiting on D-Bus
+    LatencyHistogram waitTime;
+    // Serializing and compressing the completed response
+    LatencyHistogram serializationTime;
+};
+
+// Times one request to a route.  The router starts it when the route matches,
+// and the connection finishes it once the response is serialized.  A request
+// that is never finished, such as one made internally for $expand, is
+// recorded without a response size when the timer is destroyed.
+class RouteTimer
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RouteTimer(RouteMetrics& metricsIn) :
+        metrics(metricsIn), start(Clock::now())
+    {
+        metrics.inFlight++;
+    }
+
+    ~RouteTimer()
+    {
+        if (!finished)
+        {
+            finish(0);
+        }
+    }
+
+    RouteTimer(const RouteTimer&) = delete;
+    RouteTimer(RouteTimer&&) = delete;
+    RouteTimer& operator=(const RouteTimer&) = delete;
+    RouteTimer& operator=(RouteTimer&&) = delete;
+
+    void handlerStarted()
+    {
+        handlerStart = Clock::now();
+    }
+
+    void handlerReturned()
+    {
+        handlerEnd = Clock::now();
+    }
+
+    void serializationStarted()
+    {
+        serializationStart = Clock::now();
+    }
+
+    void finish(uint64_t responseBytes)
+    {
+        if (finished)
+        {
+            return;
+        }
+        finished = true;
+        Clock::time_point end = Clock::now();
+        if (serializationStart == Clock::time_point())
+        {
+            serializationStart = end;
+        }
+        Clock::duration total = end - start;
+        Clock::duration handler{};
+        if (handlerEnd != Clock::time_point())
+        {
+            handler = handlerEnd - handlerStart;
+        }
+        Clock::duration serialization = end - serializationStart;
+
+        metrics.inFlight--;
+        metrics.requests++;
+        metrics.responseBytes += responseBytes;
+        metrics.latency.record(toMicroseconds(total));
+        metrics.handlerTime.record(toMicroseconds(handler));
+        metrics.waitTime.record(
+            toMicroseconds(total - handler - serialization));
+        metrics.serializationTime.record(toMicroseconds(serialization));
+    }
+
+  private:
+    static std::chrono::microseconds toMicroseconds(Clock::duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration);
+    }
+
+    RouteMetrics& metrics;
+    Clock::time_point start;
+    Clock::time_point handlerStart;
+    Clock::time_point handlerEnd;
+    Clock::time_point serializationStart;
+    bool finished = false;
+};
+
+struct RouteMetricsEntry
+{
+    std::string_view route;
+    // Methods the route handles, separated by commas
+    std::string methods;
+    const RouteMetrics* metrics = nullptr;
+};
+
+inline void appendPrometheusLabels(std::string& out,
+                                   const RouteMetricsEntry& entry)
+{
+    out += "{route=\"";
+    for (char c : entry.route)
+    {
+        if (c == '\\' || c == '"')
+        {
+            out += '\\';
+        }
+        out += c;
+    }
+    out += "\",method=\"";
+    out += entry.methods;
+    out += '"';
+}
+
+inline void appendPrometheusValue(
+    std::string& out, std::string_view name,
+    std::span<const RouteMetricsEntry> entries, std::string_view type,
+    std::string_view help, uint64_t RouteMetrics::* value)
+{
+    out += std::format("# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+    for (const RouteMetricsEntry& entry : entries)
+    {
+        out += name;
+        appendPrometheusLabels(out, entry);
+        out += std::format("}} {}\n", entry.metrics->*value);
+    }
+}
+
+inline void appendPrometheusHistogram(
+    std::string& out, std::string_view name,
+    std::span<const RouteMetricsEntry> entries, std::string_view help,
+    LatencyHistogram RouteMetrics::* histogram)
+{
+    out += std::format("# HELP {} {}\n# TYPE {} histogram\n", name, help,
+                       name);
+    for (const RouteMetricsEntry& entry : entries)
+    {
+        const LatencyHistogram& values = entry.metrics->*histogram;
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < values.getBuckets().size(); i++)
+        {
+            cumulative += values.getBuckets()[i];
+            out += name;
+            out += "_bucket";
+            appendPrometheusLabels(out, entry);
+            if (i < LatencyHistogram::bucketBounds.size())
+            {
+                out += std::format(
+                    ",le=\"{}\"}} {}\n",
+                    static_cast<double>(LatencyHistogram::bucketBounds[i]) /
+                        1e6,
+                    cumulative);
+            }
+            else
+            {
+                out += std::format(",le=\"+Inf\"}} {}\n", cumulative);
+            }
+        }
+        out += name;
+        out += "_sum";
+        appendPrometheusLabels(out, entry);
+        out += std::format("}} {}\n",
+                           static_cast<double>(values.getSum()) / 1e6);
+        out += name;
+        out += "_count";
+        appendPrometheusLabels(out, entry);
+        out += std::format("}} {}\n", values.getCount());
+    }
+}
+
+// Formats the metrics in the Prometheus text exposition format
+inline std::string formatPrometheusMetrics(
+    std::span<const RouteMetricsEntry> entries)
+{
+    std::string out;
+    appendPrometheusValue(out, "bmcweb_route_requests_total", entries,
+                          "counter", "Completed requests",
+                          &RouteMetrics::requests);
+    appendPrometheusValue(out, "bmcweb_route_in_flight_requests", entries,
+                          "gauge", "Requests being handled",
+                          &RouteMetrics::inFlight);
+    appendPrometheusValue(out, "bmcweb_route_response_bytes_total", entries,
+                          "counter", "Response body bytes",
+                          &RouteMetrics::responseBytes);
+    appendPrometheusHistogram(out, "bmcweb_route_latency_seconds", entries,
+                              "Time from routing to a serialized response",
+                              &RouteMetrics::latency);
+    appendPrometheusHistogram(out, "bmcweb_route_handler_seconds", entries,
+                              "Time spent in the handler",
+                              &RouteMetrics::handlerTime);
+    appendPrometheusHistogram(out, "bmcweb_route_wait_seconds", entries,
+                              "Time waiting on D-Bus and other async work",
+                              &RouteMetrics::waitTime);
+    appendPrometheusHistogram(out, "bmcweb_route_serialization_seconds",
+                              entries, "Time serializing the response",
+                              &RouteMetrics::serializationTime);
+    return out;
+}
+
+} // namespace crow
@@ -2,11 +2,15 @@
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #pragma once
 
+#include "bmcweb_config.h"
+
 #include "async_resp.hpp"
 #include "dbus_privileges.hpp"
+#include "dbus_trace.hpp"
 #include "http_request.hpp"
 #include "http_response.hpp"
 #include "logging.hpp"
+#include "route_metrics.hpp"
 #include "routing/baserule.hpp"
 #include "routing/dynamicrule.hpp"
 #include "routing/taggedrule.hpp"
@@ -27,7 +31,6 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
-#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -127,6 +130,38 @@ class Router
         }
     };
 
+    // The rules of one url pattern, by verb
+    struct MethodRules
+    {
+        std::array<BaseRule*, static_cast<size_t>(HttpVerb::Max)> rules{};
+        // Bit n is set when rules[n] is
+        size_t methods = 0;
+    };
+
+    void internalAddMethodRule(std::string_view rule, size_t method,
+                               BaseRule* ruleObject)
+    {
+        Node* node = trie.addNode(rule);
+        if (node == nullptr)
+        {
+            return;
+        }
+        if (node->ruleIndex == 0U)
+        {
+            node->ruleIndex = static_cast<unsigned>(methodRules.size());
+            methodRules.emplace_back();
+        }
+        MethodRules& methods = methodRules[node->ruleIndex];
+        if (methods.rules[method] != nullptr)
+        {
+            BMCWEB_LOG_CRITICAL("handler already exists for \"{}\"", rule);
+            throw std::runtime_error(
+                std::format("handler already exists for \"{}\"", rule));
+        }
+        methods.rules[method] = ruleObject;
+        methods.methods |= size_t{1} << method;
+    }
+
     void internalAddRuleObject(const std::string& rule, BaseRule* ruleObject)
     {
         if (ruleObject == nullptr)
@@ -136,9 +171,17 @@ class Router
         for (size_t method = 0; method <= maxVerbIndex; method++)
         {
             size_t methodBit = 1 << method;
-            if ((ruleObject->methodsBitfield & methodBit) > 0U)
+            if ((ruleObject->methodsBitfield & methodBit) == 0U)
+            {
+                continue;
+            }
+            internalAddMethodRule(rule, method, ruleObject);
+            // directory case, as in PerMethod::internalAdd
+            if (rule.size() > 2 && rule.back() == '/')
             {
-                perMethods[method].internalAdd(rule, ruleObject);
+                internalAddMethodRule(
+                    std::string_view(rule).substr(0, rule.size() - 1), method,
+                    ruleObject);
             }
         }
 
@@ -160,6 +203,13 @@ class Router
 
     void validate()
     {
+        // Rules may be added between calls, so build the tries from scratch
+        trie = Trie<crow::Node>();
+        methodRules.assign(1, MethodRules());
+        notFoundRoutes = PerMethod();
+        upgradeRoutes = PerMethod();
+        methodNotAllowedRoutes = PerMethod();
+
         for (std::unique_ptr<BaseRule>& rule : allRules)
         {
             if (rule)
@@ -173,10 +223,7 @@ class Router
                 internalAddRuleObject(rule->rule, rule.get());
             }
         }
-        for (PerMethod& perMethod : perMethods)
-        {
-            perMethod.trie.validate();
-        }
+        trie.validate();
     }
 
     struct FindRoute
@@ -205,25 +252,49 @@ class Router
         if (found.ruleIndex != 0U)
         {
             route.rule = perMethod.rules[found.ruleIndex];
-            route.params = std::move(found.params);
+            route.params.assign(found.params.begin(), found.params.end());
         }
         return route;
     }
 
+    // Finds the rule for the request and the verbs the url allows in a
+    // single walk of the trie
     FindRouteResponse findRoute(const Request& req) const
     {
         FindRouteResponse findRoute;
 
-        // Check to see if this url exists at any verb
-        for (size_t perMethodIndex = 0; perMethodIndex <= maxVerbIndex;
-             perMethodIndex++)
+        std::optional<HttpVerb> verb = httpVerbFromBoost(req.method());
+        size_t reqMethodIndex = verb ? static_cast<size_t>(*verb) : 0U;
+        size_t reqMethodBit = verb ? size_t{1} << reqMethodIndex : 0U;
+        size_t allowed = 0;
+
+        trie.findAll(
+            req.url().encoded_path(),
+            [this, &findRoute, &allowed, reqMethodIndex, reqMethodBit](
+                unsigned ruleIndex,
+                const Trie<crow::Node>::RouteParams& params) {
+                if (ruleIndex >= methodRules.size())
+                {
+                    throw std::runtime_error(
+                        "Trie internal structure corrupted!");
+                }
+                const MethodRules& methods = methodRules[ruleIndex];
+                allowed |= methods.methods;
+                // The first match with the verb wins, later ones only add
+                // to the allowed verbs
+                if (findRoute.route.rule == nullptr &&
+                    (methods.methods & reqMethodBit) != 0U)
+                {
+                    findRoute.route.rule = methods.rules[reqMethodIndex];
+                    findRoute.route.params.assign(params.begin(),
+                                                  params.end());
+                }
+                return false;
+            });
+
+        for (size_t method = 0; method <= maxVerbIndex; method++)
         {
-            // Make sure it's safe to deference the array at that index
-            static_assert(
-                maxVerbIndex < std::tuple_size_v<decltype(perMethods)>);
-            FindRoute route = findRouteByPerMethod(req.url().encoded_path(),
-                                                   perMethods[perMethodIndex]);
-            if (route.rule == nullptr)
+            if ((allowed & (size_t{1} << method)) == 0U)
             {
                 continue;
             }
@@ -231,28 +302,9 @@ class Router
             {
                 findRoute.allowHeader += ", ";
             }
-            HttpVerb thisVerb = static_cast<HttpVerb>(perMethodIndex);
-            findRoute.allowHeader += httpVerbToString(thisVerb);
-        }
-
-        std::optional<HttpVerb> verb = httpVerbFromBoost(req.method());
-        if (!verb)
-        {
-            return findRoute;
-        }
-        size_t reqMethodIndex = static_cast<size_t>(*verb);
-        if (reqMethodIndex >= perMethods.size())
-        {
-            return findRoute;
+            findRoute.allowHeader +=
+                httpVerbToString(static_cast<HttpVerb>(method));
         }
-
-        FindRoute route = findRouteByPerMethod(req.url().encoded_path(),
-                                               perMethods[reqMethodIndex]);
-        if (route.rule != nullptr)
-        {
-            findRoute.route = route;
-        }
-
         return findRoute;
     }
 
@@ -346,45 +398,108 @@ class Router
         BMCWEB_LOG_DEBUG("Matched rule '{}' {} / {}", rule.rule,
                          req->methodString(), rule.getMethods());
 
+        if constexpr (BMCWEB_ROUTE_METRICS)
+        {
+            req->routeTimer = std::make_shared<RouteTimer>(rule.metrics);
+        }
+
+        if constexpr (BMCWEB_DBUS_TRACING)
+        {
+            asyncResp->dbusTrace = std::make_shared<bmcweb::DbusTrace>(
+                req->methodString(), req->url().encoded_path());
+        }
+        // Attribute the D-Bus calls of the privilege check and the handler
+        // to this request
+        bmcweb::ScopedDbusTrace dbusTraceScope(asyncResp->dbusTrace);
+
         if (req->session == nullptr)
         {
-            rule.handle(*req, asyncResp, params);
+            handleRule(rule, req, asyncResp, params);
             return;
         }
         validatePrivilege(
             req, asyncResp, rule,
             [req, asyncResp, &rule, params = std::move(params)]() {
-                rule.handle(*req, asyncResp, params);
+                handleRule(rule, req, asyncResp, params);
             });
     }
 
-    void debugPrint()
+    static void handleRule(BaseRule& rule, const std::shared_ptr<Request>& req,
+                           const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+                           const std::vector<std::string>& params)
     {
-        for (size_t i = 0; i < perMethods.size(); i++)
+        std::shared_ptr<RouteTimer> timer = req->routeTimer;
+        if (timer != nullptr)
         {
-            BMCWEB_LOG_DEBUG("{}", httpVerbToString(static_cast<HttpVerb>(i)));
-            perMethods[i].trie.debugPrint();
+            timer->handlerStarted();
+        }
+        rule.handle(*req, asyncResp, params);
+        if (timer != nullptr)
+        {
+            timer->handlerReturned();
         }
     }
 
+    void debugPrint()
+    {
+        trie.debugPrint();
+    }
+
     std::vector<const std::string*> getRoutes(const std::string& parent)
     {
         std::vector<const std::string*> ret;
 
-        for (const PerMethod& pm : perMethods)
+        std::vector<unsigned> x;
+        trie.findRouteIndexes(parent, x);
+        for (size_t method = 0; method <= maxVerbIndex; method++)
         {
-            std::vector<unsigned> x;
-            pm.trie.findRouteIndexes(parent, x);
             for (unsigned index : x)
             {
-                ret.push_back(&pm.rules[index]->rule);
+                const BaseRule* rule = methodRules[index].rules[method];
+                if (rule != nullptr)
+                {
+                    ret.push_back(&rule->rule);
+                }
+            }
+        }
+        return ret;
+    }
+
+    // Metrics of the routes that have handled requests
+    std::vector<RouteMetricsEntry> getRouteMetrics() const
+    {
+        std::vector<RouteMetricsEntry> ret;
+        for (const std::unique_ptr<BaseRule>& rule : allRules)
+        {
+            if (!rule || (rule->metrics.requests == 0 &&
+                          rule->metrics.inFlight == 0))
+            {
+                continue;
+            }
+            RouteMetricsEntry& entry = ret.emplace_back();
+            entry.route = rule->rule;
+            entry.metrics = &rule->metrics;
+            for (size_t verb = 0; verb <= maxVerbIndex; verb++)
+            {
+                if ((rule->getMethods() & (1U << verb)) == 0U)
+                {
+                    continue;
+                }
+                if (!entry.methods.empty())
+                {
+                    entry.methods += ',';
+                }
+                entry.methods += httpVerbToString(static_cast<HttpVerb>(verb));
             }
         }
         return ret;
     }
 
   private:
-    std::array<PerMethod, static_cast<size_t>(HttpVerb::Max)> perMethods;
+    // Every route, with the rules of each url pattern in methodRules.
+    // Index 0 is reserved, as in PerMethod.
+    Trie<crow::Node> trie;
+    std::vector<MethodRules> methodRules = std::vector<MethodRules>(1);
 
     PerMethod notFoundRoutes;
     PerMethod upgradeRoutes;
@@ -5,6 +5,7 @@
 #include "async_resp.hpp"
 #include "http_request.hpp"
 #include "privileges.hpp"
+#include "route_metrics.hpp"
 #include "verb.hpp"
 
 #include <boost/asio/ip/tcp.hpp>
@@ -99,6 +100,8 @@ class BaseRule
 
     std::string rule;
 
+    RouteMetrics metrics;
+
     std::unique_ptr<BaseRule> ruleToUpgrade;
 
     friend class Router;
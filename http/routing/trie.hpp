@@ -140,41 +140,60 @@ class Trie
         findRouteIndexesHelper(reqUrl, routeIndexes, head());
     }
 
+    // Parameters captured from the url, pointing into it
+    using RouteParams = boost::container::small_vector<std::string_view, 5>;
+
     struct FindResult
     {
         unsigned ruleIndex = 0;
-        std::vector<std::string> params;
+        RouteParams params;
     };
 
   private:
-    FindResult findHelper(const std::string_view reqUrl,
-                          const ContainedType& node,
-                          std::vector<std::string>& params) const
+    // Literal children are prefix free, so only the greatest fragment that
+    // sorts before the url can be a prefix of it
+    const typename ContainedType::ChildMap::value_type* findChild(
+        const ContainedType& node, std::string_view reqUrl) const
+    {
+        typename ContainedType::ChildMap::const_iterator it =
+            node.children.upper_bound(reqUrl);
+        if (it == node.children.begin())
+        {
+            return nullptr;
+        }
+        --it;
+        if (!reqUrl.starts_with(it->first))
+        {
+            return nullptr;
+        }
+        return &*it;
+    }
+
+    template <typename Visitor>
+    bool findAllHelper(std::string_view reqUrl, const ContainedType& node,
+                       RouteParams& params, Visitor& visitor) const
     {
         if (reqUrl.empty())
         {
-            return {node.ruleIndex, params};
+            return node.ruleIndex != 0U && visitor(node.ruleIndex, params);
         }
 
         if (node.stringParamChild != 0U)
         {
-            size_t epos = 0;
-            for (; epos < reqUrl.size(); epos++)
+            size_t epos = reqUrl.find('/');
+            if (epos == std::string_view::npos)
             {
-                if (reqUrl[epos] == '/')
-                {
-                    break;
-                }
+                epos = reqUrl.size();
             }
 
             if (epos != 0)
             {
                 params.emplace_back(reqUrl.substr(0, epos));
-                FindResult ret = findHelper(
-                    reqUrl.substr(epos), nodes[node.stringParamChild], params);
-                if (ret.ruleIndex != 0U)
+                if (findAllHelper(reqUrl.substr(epos),
+                                  nodes[node.stringParamChild], params,
+                                  visitor))
                 {
-                    return {ret.ruleIndex, std::move(ret.params)};
+                    return true;
                 }
                 params.pop_back();
             }
@@ -183,42 +202,48 @@ class Trie
         if (node.pathParamChild != 0U)
         {
             params.emplace_back(reqUrl);
-            FindResult ret = findHelper("", nodes[node.pathParamChild], params);
-            if (ret.ruleIndex != 0U)
+            if (findAllHelper("", nodes[node.pathParamChild], params, visitor))
             {
-                return {ret.ruleIndex, std::move(ret.params)};
+                return true;
             }
             params.pop_back();
         }
 
-        for (const typename ContainedType::ChildMap::value_type& kv :
-             node.children)
+        const typename ContainedType::ChildMap::value_type* child =
+            findChild(node, reqUrl);
+        if (child == nullptr)
         {
-            const std::string& fragment = kv.first;
-            const ContainedType& child = nodes[kv.second];
-
-            if (reqUrl.starts_with(fragment))
-            {
-                FindResult ret =
-                    findHelper(reqUrl.substr(fragment.size()), child, params);
-                if (ret.ruleIndex != 0U)
-                {
-                    return {ret.ruleIndex, std::move(ret.params)};
-                }
-            }
+            return false;
         }
-
-        return {0U, std::vector<std::string>()};
+        return findAllHelper(reqUrl.substr(child->first.size()),
+                             nodes[child->second], params, visitor);
     }
 
   public:
+    // Calls visitor(ruleIndex, params) for every rule matching the url, in
+    // order of precedence, until it returns true
+    template <typename Visitor>
+    void findAll(std::string_view reqUrl, Visitor&& visitor) const
+    {
+        RouteParams params;
+        findAllHelper(reqUrl, head(), params, visitor);
+    }
+
     FindResult find(const std::string_view reqUrl) const
     {
-        std::vector<std::string> start;
-        return findHelper(reqUrl, head(), start);
+        FindResult result;
+        findAll(reqUrl,
+                [&result](unsigned ruleIndex, const RouteParams& params) {
+                    result.ruleIndex = ruleIndex;
+                    result.params = params;
+                    return true;
+                });
+        return result;
     }
 
-    void add(std::string_view urlIn, unsigned ruleIndex)
+    // Returns the node for the url, adding it if needed, or nullptr if the
+    // url has an unknown tag
+    ContainedType* addNode(std::string_view urlIn)
     {
         size_t idx = 0;
 
@@ -266,7 +291,7 @@ class Trie
                 }
 
                 BMCWEB_LOG_CRITICAL("Can't find tag for {}", urlIn);
-                return;
+                return nullptr;
             }
             std::string piece(&c, 1);
             if (!nodes[idx].children.contains(piece))
@@ -277,14 +302,23 @@ class Trie
             idx = nodes[idx].children[piece];
             url.remove_prefix(1);
         }
-        ContainedType& node = nodes[idx];
-        if (node.ruleIndex != 0U)
+        return &nodes[idx];
+    }
+
+    void add(std::string_view urlIn, unsigned ruleIndex)
+    {
+        ContainedType* node = addNode(urlIn);
+        if (node == nullptr)
+        {
+            return;
+        }
+        if (node->ruleIndex != 0U)
         {
             BMCWEB_LOG_CRITICAL("handler already exists for \"{}\"", urlIn);
             throw std::runtime_error(
                 std::format("handler already exists for \"{}\"", urlIn));
         }
-        node.ruleIndex = ruleIndex;
+        node->ruleIndex = ruleIndex;
     }
 
   private:
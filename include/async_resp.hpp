@@ -2,10 +2,20 @@
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #pragma once
 
+#include "bmcweb_config.h"
+
+#include "dbus_trace.hpp"
+#include "heap_trim.hpp"
 #include "http_response.hpp"
 
+#include <memory>
 #include <utility>
 
+namespace redfish::query_param
+{
+class SelectTrieNode;
+} // namespace redfish::query_param
+
 namespace bmcweb
 {
 
@@ -27,10 +37,26 @@ class AsyncResp
 
     ~AsyncResp()
     {
+        if (dbusTrace != nullptr)
+        {
+            dbusTrace->complete();
+            res.addHeader("Server-Timing", dbusTrace->getServerTiming());
+            DbusTraceLog::getInstance().add(std::move(dbusTrace));
+        }
+        if constexpr (BMCWEB_HEAP_TRIM_IDLE_MS > 0)
+        {
+            HeapTrimmer::getInstance().responseCompleted();
+        }
         res.end();
     }
 
     crow::Response res;
+
+    // The D-Bus calls made for this response, when D-Bus tracing is enabled
+    std::shared_ptr<DbusTrace> dbusTrace;
+
+    // The $select of the GET being answered, if it has one
+    std::shared_ptr<const redfish::query_param::SelectTrieNode> selectTrie;
 };
 
 } // namespace bmcweb
@@ -0,0 +1,359 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include <boost/callable_traits/args.hpp>
+#include <boost/system/error_code.hpp>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <format>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace bmcweb
+{
+
+struct DbusCall
+{
+    std::string service;
+    std::string path;
+    std::string interface;
+    std::string method;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::duration duration{};
+    // Estimated from the unpacked reply values
+    size_t replyBytes = 0;
+    bool error = false;
+    bool replied = false;
+};
+
+// The D-Bus calls made on behalf of one request
+class DbusTrace
+{
+  public:
+    // Calls past this many are counted, but not recorded
+    static constexpr size_t maxCalls = 1024;
+
+    DbusTrace(std::string_view methodIn, std::string_view targetIn) :
+        name(std::format("{} {}", methodIn, targetIn)),
+        start(std::chrono::steady_clock::now())
+    {}
+
+    // Returns the index to pass to finishCall
+    size_t startCall(std::string_view service, std::string_view path,
+                     std::string_view interface, std::string_view method)
+    {
+        if (completed)
+        {
+            return calls.size();
+        }
+        callCount++;
+        if (calls.size() >= maxCalls)
+        {
+            return calls.size();
+        }
+        DbusCall& call = calls.emplace_back();
+        call.service = service;
+        call.path = path;
+        call.interface = interface;
+        call.method = method;
+        call.start = std::chrono::steady_clock::now();
+        return calls.size() - 1;
+    }
+
+    void finishCall(size_t index, bool error, size_t replyBytes)
+    {
+        if (completed)
+        {
+            return;
+        }
+        std::chrono::steady_clock::time_point now =
+            std::chrono::steady_clock::now();
+        if (error)
+        {
+            errorCount++;
+        }
+        totalReplyBytes += replyBytes;
+        if (index >= calls.size())
+        {
+            return;
+        }
+        DbusCall& call = calls[index];
+        call.duration = now - call.start;
+        call.error = error;
+        call.replyBytes = replyBytes;
+        call.replied = true;
+        busTime += call.duration;
+    }
+
+    // The response is complete.  The trace may be logged from here on, so
+    // calls made or answered later are ignored, and calls still waiting for
+    // a reply are left unreplied.
+    void complete()
+    {
+        end = std::chrono::steady_clock::now();
+        completed = true;
+    }
+
+    // Value of a Server-Timing header summarizing the calls, with the sum of
+    // the call latencies as the duration
+    std::string getServerTiming() const
+    {
+        std::chrono::duration<double, std::milli> millis = busTime;
+        return std::format(
+            "dbus;dur={:.3f};desc=\"{} calls, {} errors, {} reply bytes\"",
+            millis.count(), callCount, errorCount, totalReplyBytes);
+    }
+
+    // Adds Chrome trace events for the request and its calls
+    void appendChromeTrace(nlohmann::json::array_t& events, uint64_t tid) const
+    {
+        nlohmann::json::object_t request;
+        request["name"] = name;
+        request["cat"] = "request";
+        request["ph"] = "X";
+        request["ts"] = toMicroseconds(start.time_since_epoch());
+        request["dur"] = toMicroseconds(end - start);
+        request["pid"] = 1;
+        request["tid"] = tid;
+        request["args"]["calls"] = callCount;
+        request["args"]["errors"] = errorCount;
+        request["args"]["replyBytes"] = totalReplyBytes;
+        events.emplace_back(std::move(request));
+
+        for (const DbusCall& call : calls)
+        {
+            nlohmann::json::object_t event;
+            event["name"] = std::format("{}.{}", call.interface, call.method);
+            event["cat"] = "dbus";
+            event["ph"] = "X";
+            event["ts"] = toMicroseconds(call.start.time_since_epoch());
+            event["dur"] = toMicroseconds(call.duration);
+            event["pid"] = 1;
+            event["tid"] = tid;
+            nlohmann::json& args = event["args"];
+            args["service"] = call.service;
+            args["path"] = call.path;
+            args["replyBytes"] = call.replyBytes;
+            args["error"] = call.error;
+            args["replied"] = call.replied;
+            events.emplace_back(std::move(event));
+        }
+    }
+
+    const std::vector<DbusCall>& getCalls() const
+    {
+        return calls;
+    }
+
+    size_t getCallCount() const
+    {
+        return callCount;
+    }
+
+  private:
+    static int64_t toMicroseconds(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+            .count();
+    }
+
+    std::string name;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+    std::vector<DbusCall> calls;
+    size_t callCount = 0;
+    size_t errorCount = 0;
+    size_t totalReplyBytes = 0;
+    std::chrono::steady_clock::duration busTime{};
+    bool completed = false;
+};
+
+// The traces of the most recently completed requests
+class DbusTraceLog
+{
+  public:
+    static constexpr size_t maxTraces = 16;
+
+    void add(std::shared_ptr<const DbusTrace>&& trace)
+    {
+        if (traces.size() >= maxTraces)
+        {
+            traces.pop_front();
+        }
+        traces.emplace_back(std::move(trace));
+    }
+
+    // The traces in the Chrome trace event format, which chrome://tracing
+    // and Perfetto can load.  Each request is shown as its own thread.
+    nlohmann::json::object_t getChromeTrace() const
+    {
+        nlohmann::json::array_t events;
+        uint64_t tid = 1;
+        for (const std::shared_ptr<const DbusTrace>& trace : traces)
+        {
+            trace->appendChromeTrace(events, tid++);
+        }
+        nlohmann::json::object_t out;
+        out["traceEvents"] = std::move(events);
+        out["displayTimeUnit"] = "ms";
+        return out;
+    }
+
+    static DbusTraceLog& getInstance()
+    {
+        static DbusTraceLog log;
+        return log;
+    }
+
+  private:
+    std::deque<std::shared_ptr<const DbusTrace>> traces;
+};
+
+// The trace of the request whose handler or D-Bus reply is being run.  D-Bus
+// calls made meanwhile are recorded in it, and their replies run with it set
+// again, which carries the trace through chains of callbacks.
+inline std::shared_ptr<DbusTrace>& currentDbusTrace()
+{
+    static std::shared_ptr<DbusTrace> trace;
+    return trace;
+}
+
+class ScopedDbusTrace
+{
+  public:
+    explicit ScopedDbusTrace(std::shared_ptr<DbusTrace> trace) :
+        previous(std::exchange(currentDbusTrace(), std::move(trace)))
+    {}
+
+    ~ScopedDbusTrace()
+    {
+        currentDbusTrace() = std::move(previous);
+    }
+
+    ScopedDbusTrace(const ScopedDbusTrace&) = delete;
+    ScopedDbusTrace(ScopedDbusTrace&&) = delete;
+    ScopedDbusTrace& operator=(const ScopedDbusTrace&) = delete;
+    ScopedDbusTrace& operator=(ScopedDbusTrace&&) = delete;
+
+  private:
+    std::shared_ptr<DbusTrace> previous;
+};
+
+template <typename T>
+struct IsVariant : std::false_type
+{};
+
+template <typename... Types>
+struct IsVariant<std::variant<Types...>> : std::true_type
+{};
+
+// Approximate size of a value on the bus, without alignment padding or type
+// signatures
+template <typename T>
+size_t estimateDbusSize(const T& value)
+{
+    if constexpr (std::is_same_v<T, boost::system::error_code>)
+    {
+        return 0;
+    }
+    else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+    {
+        return sizeof(T);
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+    {
+        return std::string_view(value).size();
+    }
+    else if constexpr (requires { value.str.size(); })
+    {
+        // sdbusplus::object_path and signature
+        return value.str.size();
+    }
+    else if constexpr (IsVariant<T>::value)
+    {
+        return std::visit(
+            [](const auto& alternative) {
+                return estimateDbusSize(alternative);
+            },
+            value);
+    }
+    else if constexpr (std::ranges::range<T>)
+    {
+        size_t size = 0;
+        for (const auto& element : value)
+        {
+            size += estimateDbusSize(element);
+        }
+        return size;
+    }
+    else if constexpr (requires { std::tuple_size<T>::value; })
+    {
+        return std::apply(
+            [](const auto&... members) {
+                return (size_t{0} + ... + estimateDbusSize(members));
+            },
+            value);
+    }
+    else
+    {
+        // Raw messages and other types that can't be measured
+        return 0;
+    }
+}
+
+template <typename Arg>
+bool isDbusError(const Arg& arg)
+{
+    if constexpr (std::is_same_v<std::decay_t<Arg>, boost::system::error_code>)
+    {
+        return static_cast<bool>(arg);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template <typename Handler, typename... Args>
+auto traceDbusReply(std::shared_ptr<DbusTrace> trace, size_t call,
+                    Handler&& handler, std::tuple<Args...>* /*signature*/)
+{
+    // The wrapper takes exactly the arguments of the handler, so sdbusplus
+    // unpacks the reply into the same types
+    return [trace = std::move(trace), call,
+            handler = std::forward<Handler>(handler)](Args... args) mutable {
+        trace->finishCall(call, (false || ... || isDbusError(args)),
+                          (size_t{0} + ... + estimateDbusSize(args)));
+        ScopedDbusTrace scope(trace);
+        handler(std::forward<Args>(args)...);
+    };
+}
+
+// Records a call in trace, and wraps the handler of its reply to record the
+// reply
+template <typename Handler>
+auto traceDbusCall(const std::shared_ptr<DbusTrace>& trace,
+                   std::string_view service, std::string_view path,
+                   std::string_view interface, std::string_view method,
+                   Handler&& handler)
+{
+    using Signature = boost::callable_traits::args_t<std::decay_t<Handler>>;
+    size_t call = trace->startCall(service, path, interface, method);
+    return traceDbusReply(trace, call, std::forward<Handler>(handler),
+                          static_cast<Signature*>(nullptr));
+}
+
+} // namespace bmcweb
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "app.hpp"
+#include "async_resp.hpp"
+#include "dbus_trace.hpp"
+#include "http_request.hpp"
+
+#include <boost/beast/http/verb.hpp>
+
+#include <memory>
+
+namespace crow
+{
+namespace dbus_trace
+{
+
+inline void handleDbusTraceGet(
+    const crow::Request& /*req*/,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    asyncResp->res.jsonValue =
+        bmcweb::DbusTraceLog::getInstance().getChromeTrace();
+}
+
+inline void requestRoutes(App& app)
+{
+    BMCWEB_ROUTE(app, "/dbus-trace/")
+        .privileges({{"ConfigureManager"}})
+        .methods(boost::beast::http::verb::get)(handleDbusTraceGet);
+}
+
+} // namespace dbus_trace
+} // namespace crow
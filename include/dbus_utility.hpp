@@ -3,9 +3,12 @@
 // SPDX-FileCopyrightText: Copyright 2018 Intel Corporation
 #pragma once
 
+#include "bmcweb_config.h"
+
 #include "async_resp.hpp"
 #include "boost_formatters.hpp"
 #include "dbus_singleton.hpp"
+#include "dbus_trace.hpp"
 
 #include <boost/system/error_code.hpp>
 #include <sdbusplus/asio/connection.hpp>
@@ -103,6 +106,19 @@ void async_method_call(MessageHandler&& handler, const std::string& service,
                        const std::string& objpath, const std::string& interf,
                        const std::string& method, const InputArgs&... a)
 {
+    if constexpr (BMCWEB_DBUS_TRACING)
+    {
+        const std::shared_ptr<bmcweb::DbusTrace>& trace =
+            bmcweb::currentDbusTrace();
+        if (trace != nullptr)
+        {
+            crow::connections::systemBus->async_method_call(
+                bmcweb::traceDbusCall(trace, service, objpath, interf, method,
+                                      std::forward<MessageHandler>(handler)),
+                service, objpath, interf, method, a...);
+            return;
+        }
+    }
     crow::connections::systemBus->async_method_call(
         std::forward<MessageHandler>(handler), service, objpath, interf, method,
         a...);
@@ -110,14 +126,23 @@ void async_method_call(MessageHandler&& handler, const std::string& service,
 
 template <typename MessageHandler, typename... InputArgs>
 // NOLINTNEXTLINE(readability-identifier-naming)
-void async_method_call(const std::shared_ptr<bmcweb::AsyncResp>& /*asyncResp*/,
+void async_method_call(const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
                        MessageHandler&& handler, const std::string& service,
                        const std::string& objpath, const std::string& interf,
                        const std::string& method, const InputArgs&... a)
 {
-    crow::connections::systemBus->async_method_call(
-        std::forward<MessageHandler>(handler), service, objpath, interf, method,
-        a...);
+    if constexpr (BMCWEB_DBUS_TRACING)
+    {
+        if (asyncResp->dbusTrace != nullptr)
+        {
+            bmcweb::ScopedDbusTrace scope(asyncResp->dbusTrace);
+            async_method_call(std::forward<MessageHandler>(handler), service,
+                              objpath, interf, method, a...);
+            return;
+        }
+    }
+    async_method_call(std::forward<MessageHandler>(handler), service, objpath,
+                      interf, method, a...);
 }
 
 template <typename PropertyType>
@@ -126,6 +151,21 @@ void getProperty(const std::string& service, const std::string& objectPath,
                  std::function<void(const boost::system::error_code&,
                                     const PropertyType&)>&& callback)
 {
+    if constexpr (BMCWEB_DBUS_TRACING)
+    {
+        const std::shared_ptr<bmcweb::DbusTrace>& trace =
+            bmcweb::currentDbusTrace();
+        if (trace != nullptr)
+        {
+            sdbusplus::asio::getProperty<PropertyType>(
+                *crow::connections::systemBus, service, objectPath, interface,
+                propertyName,
+                bmcweb::traceDbusCall(trace, service, objectPath,
+                                      "org.freedesktop.DBus.Properties", "Get",
+                                      std::move(callback)));
+            return;
+        }
+    }
     sdbusplus::asio::getProperty<PropertyType>(
         *crow::connections::systemBus, service, objectPath, interface,
         propertyName, std::move(callback));
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "bmcweb_config.h"
+
+#include "io_context_singleton.hpp"
+#include "logging.hpp"
+
+#include <malloc.h>
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <chrono>
+#include <functional>
+
+namespace bmcweb
+{
+
+// Gives heap memory that is free back to the system.  Returns whether any
+// was given back.
+inline bool trimHeap()
+{
+#ifdef __GLIBC__
+    return malloc_trim(0) != 0;
+#else
+    return false;
+#endif
+}
+
+// Every response builds its JSON tree out of thousands of small allocations
+// that are all freed when the response is sent.  glibc only gives memory back
+// from the top of the heap, so a few long-lived allocations made between
+// requests can keep all of it resident.  When BMCWEB_HEAP_TRIM_IDLE_MS is set,
+// the heap is trimmed once no response has completed for that long, so that
+// the cost is paid after a burst of requests rather than on each one.
+class HeapTrimmer
+{
+  public:
+    using TrimFunction = bool (*)();
+
+    HeapTrimmer(boost::asio::io_context& io,
+                std::chrono::milliseconds idleTimeIn,
+                TrimFunction trimIn = trimHeap) :
+        timer(io), idleTime(idleTimeIn), trim(trimIn)
+    {}
+
+    static HeapTrimmer& getInstance()
+    {
+        static HeapTrimmer trimmer(
+            getIoContext(),
+            std::chrono::milliseconds(BMCWEB_HEAP_TRIM_IDLE_MS));
+        return trimmer;
+    }
+
+    HeapTrimmer(const HeapTrimmer&) = delete;
+    HeapTrimmer(HeapTrimmer&&) = delete;
+    HeapTrimmer& operator=(const HeapTrimmer&) = delete;
+    HeapTrimmer& operator=(HeapTrimmer&&) = delete;
+    ~HeapTrimmer() = default;
+
+    // Restarts the idle timer
+    void responseCompleted()
+    {
+        timer.expires_after(idleTime);
+        timer.async_wait(std::bind_front(&HeapTrimmer::onIdle, trim));
+    }
+
+  private:
+    static void onIdle(TrimFunction trimFunction,
+                       const boost::system::error_code& ec)
+    {
+        if (ec == boost::asio::error::operation_aborted)
+        {
+            // Another response completed before bmcweb went idle
+            return;
+        }
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR("Heap trim timer failed: {}", ec.message());
+            return;
+        }
+        if (trimFunction())
+        {
+            BMCWEB_LOG_DEBUG("Returned free heap memory to the system");
+        }
+    }
+
+    boost::asio::steady_timer timer;
+    std::chrono::milliseconds idleTime;
+    TrimFunction trim;
+};
+
+} // namespace bmcweb
@@ -2,9 +2,19 @@
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <charconv>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <ranges>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace details
 {
@@ -109,3 +119,127 @@ struct AlphanumLess
         return alphanumComp(left, right) < 0;
     }
 };
+
+// A string's place in the alphanumComp() order, worked out once so that
+// sorting doesn't parse the digit runs again on every comparison.  The key is
+// a fixed size and doesn't allocate.  It views |str|, which has to outlive it.
+//
+// The string is stored as a sequence of units, one per character and two per
+// run of digits, that compare the way alphanumComp() does.  Strings too long
+// to fit are still ordered correctly, by calling alphanumComp() when the
+// stored prefixes tie.
+class HumanSortKey
+{
+  public:
+    explicit HumanSortKey(std::string_view strIn) : str(strIn)
+    {
+        size_t pos = 0;
+        while (pos < str.size())
+        {
+            if (!details::simpleIsDigit(str[pos]))
+            {
+                if (length == units.size())
+                {
+                    truncated = true;
+                    return;
+                }
+                units[length++] = charUnit(str[pos]);
+                pos++;
+                continue;
+            }
+            if (static_cast<size_t>(length) + 2 > units.size())
+            {
+                truncated = true;
+                return;
+            }
+            // Parsed the way alphanumComp() does, including leaving values
+            // that don't fit an int as 0
+            std::string_view rest = str.substr(pos);
+            int value = 0;
+            auto fc = std::from_chars(rest.begin(), rest.end(), value);
+            pos += static_cast<size_t>(std::distance(rest.begin(), fc.ptr));
+            units[length++] = numberUnit;
+            units[length++] = static_cast<uint32_t>(value);
+        }
+    }
+
+    // Same sign as alphanumComp() on the two strings
+    int compare(const HumanSortKey& other) const
+    {
+        size_t common = std::min(length, other.length);
+        for (size_t i = 0; i < common; i++)
+        {
+            if (units[i] != other.units[i])
+            {
+                return units[i] < other.units[i] ? -1 : 1;
+            }
+        }
+        if (truncated || other.truncated)
+        {
+            return alphanumComp(str, other.str);
+        }
+        if (length == other.length)
+        {
+            return 0;
+        }
+        return length < other.length ? -1 : 1;
+    }
+
+    std::weak_ordering operator<=>(const HumanSortKey& other) const
+    {
+        return compare(other) <=> 0;
+    }
+
+    bool operator==(const HumanSortKey& other) const
+    {
+        return compare(other) == 0;
+    }
+
+    std::string_view view() const
+    {
+        return str;
+    }
+
+  private:
+    // Digits sort before every other character
+    static constexpr uint32_t numberUnit = 1;
+
+    static uint32_t charUnit(char c)
+    {
+        return static_cast<uint32_t>(
+                   static_cast<int>(c) -
+                   static_cast<int>(std::numeric_limits<char>::min())) +
+               numberUnit + 1;
+    }
+
+    std::string_view str;
+    std::array<uint32_t, 24> units{};
+    uint8_t length = 0;
+    bool truncated = false;
+};
+
+// Sorts |range| in alphanumComp() order of the string |proj| gives for each
+// element.  Each element's key is built once, instead of on every comparison
+// as sorting with AlphanumLess does.
+template <std::ranges::random_access_range Range, typename Proj = std::identity>
+void humanSort(Range& range, Proj proj = {})
+{
+    using Iterator = std::ranges::iterator_t<Range>;
+    std::vector<std::pair<HumanSortKey, Iterator>> keyed;
+    keyed.reserve(std::ranges::size(range));
+    for (Iterator it = std::ranges::begin(range); it != std::ranges::end(range);
+         it++)
+    {
+        keyed.emplace_back(HumanSortKey(std::invoke(proj, *it)), it);
+    }
+    std::ranges::sort(keyed, {}, &std::pair<HumanSortKey, Iterator>::first);
+
+    // The keys view the elements, so nothing moves until they're sorted
+    std::vector<std::ranges::range_value_t<Range>> sorted;
+    sorted.reserve(keyed.size());
+    for (const std::pair<HumanSortKey, Iterator>& entry : keyed)
+    {
+        sorted.emplace_back(std::move(*entry.second));
+    }
+    std::ranges::move(sorted, std::ranges::begin(range));
+}
@@ -845,6 +845,18 @@ class OpenSSLX509
         return fromBioFile(bufio);
     }
 
+    // SHA-256 digest of the DER encoded certificate, or empty on failure
+    std::string getFingerprint() const
+    {
+        std::array<unsigned char, EVP_MAX_MD_SIZE> digest{};
+        unsigned int length = 0;
+        if (X509_digest(ptr, EVP_sha256(), digest.data(), &length) != 1)
+        {
+            return "";
+        }
+        return {std::bit_cast<const char*>(digest.data()), length};
+    }
+
     bool checkPurpose(int purpose) const
     {
         return X509_check_purpose(ptr, purpose, 0) == 1;
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "app.hpp"
+#include "async_resp.hpp"
+#include "http_request.hpp"
+#include "route_metrics.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/verb.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace crow
+{
+namespace prometheus_metrics
+{
+
+inline void handleMetricsGet(
+    App& app, const crow::Request& /*req*/,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    std::vector<RouteMetricsEntry> entries = app.getRouteMetrics();
+    asyncResp->res.addHeader(boost::beast::http::field::content_type,
+                             "text/plain; version=0.0.4");
+    asyncResp->res.write(formatPrometheusMetrics(entries));
+}
+
+inline void requestRoutes(App& app)
+{
+    BMCWEB_ROUTE(app, "/metrics/")
+        .privileges({{"Login"}})
+        .methods(boost::beast::http::verb::get)(
+            std::bind_front(handleMetricsGet, std::ref(app)));
+}
+
+} // namespace prometheus_metrics
+} // namespace crow
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include <boost/asio/buffer.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace crow
+{
+
+// Buffer for relaying a stream to a websocket in place.  Reads append after
+// the data and sends take it from the front, and the data is never moved, so
+// a read can be in flight while the data before it is being sent.  The space
+// is only reused once the buffer is empty.
+template <size_t Size>
+class RelayBuffer
+{
+  public:
+    // Space after the data for the next read
+    boost::asio::mutable_buffer prepare()
+    {
+        return {storage.data() + end, Size - end};
+    }
+
+    void commit(size_t bytes)
+    {
+        end += bytes;
+    }
+
+    std::string_view data() const
+    {
+        return {storage.data() + begin, end - begin};
+    }
+
+    void consume(size_t bytes)
+    {
+        begin += bytes;
+    }
+
+    size_t size() const
+    {
+        return end - begin;
+    }
+
+    // Whether there is no space left for reads
+    bool full() const
+    {
+        return end == Size;
+    }
+
+    // Reuses the space of an empty buffer.  Only safe when no read is in
+    // flight.
+    void reset()
+    {
+        begin = 0;
+        end = 0;
+    }
+
+  private:
+    std::array<char, Size> storage{};
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+} // namespace crow
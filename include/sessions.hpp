@@ -294,8 +294,10 @@ class SessionStore
             {}});
         auto it = authTokens.emplace(sessionToken, session);
         // Only need to write to disk if session isn't about to be destroyed.
-        needWrite = sessionType != SessionType::Basic &&
-                    sessionType != SessionType::MutualTLS;
+        if (isPersisted(sessionType))
+        {
+            needWrite = true;
+        }
         return it.first->second;
     }
 
@@ -335,7 +337,10 @@ class SessionStore
     void removeSession(const std::shared_ptr<UserSession>& session)
     {
         authTokens.erase(session->sessionToken);
-        needWrite = true;
+        if (isPersisted(session->sessionType))
+        {
+            needWrite = true;
+        }
     }
 
     std::vector<std::string> getAllUniqueIds()
@@ -453,9 +458,11 @@ class SessionStore
                 if (timeNow - authTokensIt->second->lastUpdated >=
                     timeoutInSeconds)
                 {
+                    if (isPersisted(authTokensIt->second->sessionType))
+                    {
+                        needWrite = true;
+                    }
                     authTokensIt = authTokens.erase(authTokensIt);
-
-                    needWrite = true;
                 }
                 else
                 {
@@ -482,6 +489,14 @@ class SessionStore
 
   private:
     SessionStore() : timeoutInSeconds(1800) {}
+
+    // Basic and mutual TLS sessions are created again from the credentials
+    // of each connection, so they aren't written to disk
+    static bool isPersisted(SessionType sessionType)
+    {
+        return sessionType != SessionType::Basic &&
+               sessionType != SessionType::MutualTLS;
+    }
 };
 
 } // namespace persistent_data
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace redfish
+{
+
+// Append-only on-disk journal of the events sent to subscribers, so that SSE
+// clients can resume from a Last-Event-ID after a bmcweb restart.
+//
+// Events are stored one per line as "<id> <json>" across two segment files.
+// When the active segment reaches half of the size limit, the older segment is
+// dropped and the active one takes its place, which bounds the journal to
+// maxSize bytes.  The offset of every record is indexed in memory when the
+// journal is opened, so replays seek straight to the requested event.
+class EventJournal
+{
+  public:
+    EventJournal(const std::filesystem::path& dir, uint64_t maxSize);
+
+    // Id of the newest event in the journal, or 0 if it is empty
+    uint64_t lastEventId() const;
+
+    bool append(uint64_t eventId, std::string_view message);
+
+    // Calls callback for every journaled event newer than eventId.  Returns
+    // false if eventId is no longer, or never was, in the journal.
+    bool replayAfter(
+        uint64_t eventId,
+        const std::function<void(uint64_t, std::string_view)>& callback) const;
+
+  private:
+    struct Record
+    {
+        uint64_t id;
+        uint64_t offset;
+    };
+
+    struct Segment
+    {
+        std::filesystem::path path;
+        std::vector<Record> records;
+        uint64_t size = 0;
+    };
+
+    void load(Segment& segment);
+    bool rotate();
+    static void replaySegment(
+        const Segment& segment, uint64_t offset,
+        const std::function<void(uint64_t, std::string_view)>& callback);
+
+    uint64_t maxSegmentSize;
+    // Older segment first, then the active one
+    std::array<Segment, 2> segments;
+};
+
+} // namespace redfish
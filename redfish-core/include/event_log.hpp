@@ -1,5 +1,6 @@
 #pragma once
 
+#include "event_logs_object_type.hpp"
 #include "utils/time_utils.hpp"
 
 #include <nlohmann/json.hpp>
@@ -35,6 +36,25 @@ int formatEventLogEntry(uint64_t eventId, const std::string& logEntryID,
                         std::string timestamp, const std::string& customText,
                         nlohmann::json::object_t& logEntryJson);
 
+// Formats the event records once so that they can be shared between all
+// subscribers.  Records that fail to format are skipped.  The per-subscription
+// EventId and Context fields are filled in by formatEventLogPayload.
+std::vector<nlohmann::json> formatEventLogEntries(
+    std::span<const EventLogObjectsType> eventRecords);
+
+// Builds the Event payload containing the entries at the given indexes.
+// eventId is incremented once per entry, and on return holds the Id of the
+// Event.
+nlohmann::json::object_t formatEventLogPayload(
+    uint64_t& eventId, std::span<const nlohmann::json> logEntries,
+    std::span<const size_t> entryIndexes, const std::string& customText);
+
+// Moves the Events arrays of several Event payloads, oldest first, into a
+// single Event with the given Id.  The MemberId of each record is renumbered
+// so that it stays unique within the merged array.
+nlohmann::json::object_t mergeEventPayloads(
+    std::span<nlohmann::json::object_t> payloads, uint64_t eventId);
+
 } // namespace event_log
 
 } // namespace redfish
@@ -6,9 +6,12 @@
 
 #include "dbus_log_watcher.hpp"
 #include "error_messages.hpp"
+#include "event_journal.hpp"
+#include "event_log.hpp"
 #include "event_logs_object_type.hpp"
 #include "event_matches_filter.hpp"
 #include "event_service_store.hpp"
+#include "event_subscription_index.hpp"
 #include "filesystem_log_watcher.hpp"
 #include "io_context_singleton.hpp"
 #include "logging.hpp"
@@ -26,13 +29,18 @@
 #include <boost/url/url_view_base.hpp>
 
 #include <algorithm>
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <filesystem>
+#include <map>
 #include <memory>
 #include <optional>
 #include <random>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -56,6 +64,7 @@ class EventServiceManager
     std::optional<FilesystemLogWatcher> filesystemLogMonitor;
     boost::container::flat_map<std::string, std::shared_ptr<Subscription>>
         subscriptionsMap;
+    EventSubscriptionIndex<std::shared_ptr<Subscription>> subscriptionIndex;
 
     uint64_t eventId{1};
 
@@ -67,6 +76,7 @@ class EventServiceManager
 
     constexpr static size_t maxMessages = 200;
     boost::circular_buffer<Event> messages{maxMessages};
+    std::optional<EventJournal> journal;
 
   public:
     EventServiceManager(const EventServiceManager&) = delete;
@@ -77,6 +87,20 @@ class EventServiceManager
 
     explicit EventServiceManager()
     {
+        if constexpr (BMCWEB_REDFISH_EVENT_JOURNAL_SIZE > 0)
+        {
+            std::filesystem::path journalDir =
+                std::filesystem::path(persistent_data::ConfigFile::filename())
+                    .parent_path() /
+                "event_journal";
+            journal.emplace(
+                journalDir,
+                static_cast<uint64_t>(BMCWEB_REDFISH_EVENT_JOURNAL_SIZE) *
+                    1024U);
+            // Continue the event ids from before the restart
+            eventId = std::max(eventId, journal->lastEventId());
+        }
+
         // Load config from persist store.
         initConfig();
     }
@@ -120,6 +144,7 @@ class EventServiceManager
             };
 
             subscriptionsMap.emplace(id, subValue);
+            subscriptionIndex.add(id, *subValue->userSub, subValue);
 
             updateNoOfSubscribersCount();
 
@@ -336,6 +361,7 @@ class EventServiceManager
 
         // Set Subscription ID for back trace
         subValue->userSub->id = id;
+        subscriptionIndex.add(id, *subValue->userSub, subValue);
 
         persistent_data::EventServiceStore::getInstance()
             .subscriptionsConfigMap.emplace(id, subValue->userSub);
@@ -364,7 +390,8 @@ class EventServiceManager
                         return std::to_string(event.id) == lastEventId;
                     });
             // Can't find a matching ID
-            if (lastEvent == messages.end())
+            if (lastEvent == messages.end() &&
+                !replayFromJournal(*subValue, lastEventId))
             {
                 nlohmann::json msg = messages::eventBufferExceeded();
 
@@ -373,7 +400,7 @@ class EventServiceManager
                 eventId++;
                 subValue->sendEventToSubscriber(eventId, std::move(strMsg));
             }
-            else
+            else if (lastEvent != messages.end())
             {
                 // Skip the last event the user already has
                 lastEvent++;
@@ -395,6 +422,52 @@ class EventServiceManager
         return id;
     }
 
+    // Replays the journaled events newer than lastEventId, for clients that
+    // resume after the in-memory buffer has wrapped or bmcweb has restarted
+    bool replayFromJournal(Subscription& subValue,
+                           std::string_view lastEventId) const
+    {
+        if (!journal)
+        {
+            return false;
+        }
+        uint64_t lastId = 0;
+        const char* end = lastEventId.data() + lastEventId.size();
+        auto [ptr, ec] = std::from_chars(lastEventId.data(), end, lastId);
+        if (ec != std::errc() || ptr != end)
+        {
+            return false;
+        }
+        BMCWEB_LOG_INFO("Replaying events after {} from the journal", lastId);
+        return journal->replayAfter(
+            lastId, [&subValue](uint64_t id, std::string_view message) {
+                // The journal keeps one event per line, so reformat it the
+                // way events replayed from memory are sent
+                nlohmann::json msg =
+                    nlohmann::json::parse(message, nullptr, false);
+                if (msg.is_discarded())
+                {
+                    BMCWEB_LOG_ERROR("Event {} in the journal isn't JSON", id);
+                    return;
+                }
+                subValue.sendEventToSubscriber(
+                    id, msg.dump(2, ' ', true,
+                                 nlohmann::json::error_handler_t::replace));
+            });
+    }
+
+    // Keeps the event for SSE clients resuming with a Last-Event-ID
+    void storeEvent(uint64_t id, const nlohmann::json::object_t& message)
+    {
+        messages.push_back(Event(id, message));
+        if (journal)
+        {
+            std::string strMsg = nlohmann::json(message).dump(
+                -1, ' ', true, nlohmann::json::error_handler_t::replace);
+            journal->append(id, strMsg);
+        }
+    }
+
     std::string addPushSubscription(
         const std::shared_ptr<Subscription>& subValue)
     {
@@ -420,7 +493,11 @@ class EventServiceManager
             BMCWEB_LOG_WARNING("Could not find subscription with id {}", id);
             return false;
         }
+        // Events waiting for the coalescing window were accepted before the
+        // subscription was deleted, so deliver them rather than drop them
+        obj->second->flushPendingEvents();
         subscriptionsMap.erase(obj);
+        subscriptionIndex.remove(id);
         auto& event = persistent_data::EventServiceStore::getInstance();
         auto persistentObj = event.subscriptionsConfigMap.find(id);
         if (persistentObj == event.subscriptionsConfigMap.end())
@@ -446,6 +523,7 @@ class EventServiceManager
             {
                 persistent_data::EventServiceStore::getInstance()
                     .subscriptionsConfigMap.erase(entry->userSub->id);
+                subscriptionIndex.remove(it->first);
                 it = subscriptionsMap.erase(it);
                 return;
             }
@@ -480,6 +558,21 @@ class EventServiceManager
         return idList;
     }
 
+    // Returns the subscriptions whose RegistryPrefixes, MessageIds,
+    // OriginResources and ResourceTypes all accept the event, in id order
+    std::vector<std::shared_ptr<Subscription>> getMatchingSubscriptions(
+        const nlohmann::json::object_t& eventMessage,
+        std::string_view resourceType) const
+    {
+        std::vector<std::shared_ptr<Subscription>> matches =
+            subscriptionIndex.getCandidates(eventMessage, resourceType);
+        std::erase_if(matches, [&](const std::shared_ptr<Subscription>& sub) {
+            return !eventMatchesFilter(*sub->userSub, eventMessage,
+                                       resourceType);
+        });
+        return matches;
+    }
+
     bool sendTestEventLog(TestEvent& testEvent)
     {
         eventId++;
@@ -537,7 +630,7 @@ class EventServiceManager
         std::string strMsg = nlohmann::json(msg).dump(
             2, ' ', true, nlohmann::json::error_handler_t::replace);
 
-        messages.push_back(Event(eventId, msg));
+        storeEvent(eventId, msg);
         for (const auto& it : subscriptionsMap)
         {
             std::shared_ptr<Subscription> entry = it.second;
@@ -554,13 +647,102 @@ class EventServiceManager
     {
         EventServiceManager& mgr = EventServiceManager::getInstance();
         mgr.eventId++;
-        for (const auto& it : mgr.subscriptionsMap)
+
+        // Format every record once, rather than once per subscription
+        std::vector<nlohmann::json> logEntries =
+            event_log::formatEventLogEntries(eventRecords);
+        if (logEntries.empty())
         {
-            Subscription& entry = *it.second;
-            entry.filterAndSendEventLogs(mgr.eventId, eventRecords);
+            BMCWEB_LOG_DEBUG("No log entries available to be transferred.");
+            return;
+        }
+
+        // Collect the matching entries of each subscription, looking only
+        // at the subscriptions the index says can match each entry.  These
+        // are keyed by id so that subscribers are sent to in a stable order.
+        struct SubMatches
+        {
+            std::shared_ptr<Subscription> sub;
+            std::vector<size_t> matches;
+        };
+        boost::container::flat_map<std::string, SubMatches> matchesBySub;
+        for (size_t index = 0; index < logEntries.size(); index++)
+        {
+            const nlohmann::json::object_t* bmcLogEntry =
+                logEntries[index].get_ptr<const nlohmann::json::object_t*>();
+            if (bmcLogEntry == nullptr)
+            {
+                continue;
+            }
+            for (const std::shared_ptr<Subscription>& entry :
+                 mgr.getMatchingSubscriptions(*bmcLogEntry, ""))
+            {
+                SubMatches& subMatches = matchesBySub[entry->userSub->id];
+                subMatches.sub = entry;
+                std::vector<size_t>& matches = subMatches.matches;
+                // Entries get consecutive EventIds in the subscriber's payload
+                if (!entry->eventLogMatchesFilter(
+                        logEntries[index], mgr.eventId + matches.size()))
+                {
+                    continue;
+                }
+                matches.emplace_back(index);
+            }
+        }
+
+        // Subscriptions that match the same entries and share a Context get
+        // an identical payload, so it only needs to be built once.
+        struct Payload
+        {
+            uint64_t eventId = 0;
+            nlohmann::json::object_t msg;
+            std::optional<std::string> body;
+        };
+        std::map<std::pair<std::vector<size_t>, std::string>, Payload>
+            payloads;
+        for (auto& [id, subMatches] : matchesBySub)
+        {
+            std::vector<size_t>& matches = subMatches.matches;
+            if (matches.empty())
+            {
+                continue;
+            }
+            Subscription& entry = *subMatches.sub;
+            auto [payload, inserted] = payloads.try_emplace(
+                std::make_pair(std::move(matches), entry.userSub->customText));
+            if (inserted)
+            {
+                payload->second.eventId = mgr.eventId;
+                payload->second.msg = event_log::formatEventLogPayload(
+                    payload->second.eventId, logEntries, payload->first.first,
+                    entry.userSub->customText);
+            }
+            queueEventPayload(entry, payload->second.eventId,
+                              payload->second.msg, payload->second.body);
         }
     }
 
+    // Hands an Event payload that may be shared between subscribers to one
+    // of them.  Subscriptions that coalesce events keep their own copy of
+    // the JSON until the coalescing window closes, and the rest share a
+    // single serialization of it in |body|.
+    static void queueEventPayload(Subscription& entry, uint64_t eventId,
+                                  const nlohmann::json::object_t& msg,
+                                  std::optional<std::string>& body)
+    {
+        if (entry.coalescesEvents())
+        {
+            entry.queueEvent(eventId, nlohmann::json::object_t(msg));
+            return;
+        }
+        if (!body)
+        {
+            body = nlohmann::json(msg).dump(
+                2, ' ', true, nlohmann::json::error_handler_t::replace);
+        }
+        entry.sendEventToSubscriber(eventId, std::string(*body));
+    }
+
     static void sendTelemetryReportToSubs(
         const std::string& reportId, const telemetry::TimestampReadings& var)
     {
@@ -591,31 +773,27 @@ class EventServiceManager
         // MemberId is 0 : since we are sending one event record.
         eventMessage["MemberId"] = "0";
 
-        messages.push_back(Event(eventId, eventMessage));
+        storeEvent(eventId, eventMessage);
 
-        for (auto& it : subscriptionsMap)
+        // The payload is the same for every subscriber, so build it once the
+        // first time a subscription matches.
+        std::optional<nlohmann::json::object_t> msg;
+        std::optional<std::string> body;
+        for (const std::shared_ptr<Subscription>& entry :
+             getMatchingSubscriptions(eventMessage, resourceType))
         {
-            std::shared_ptr<Subscription>& entry = it.second;
-            if (!eventMatchesFilter(*entry->userSub, eventMessage,
-                                    resourceType))
+            if (!msg)
             {
-                BMCWEB_LOG_DEBUG("Filter didn't match");
-                continue;
+                nlohmann::json::array_t eventRecord;
+                eventRecord.emplace_back(eventMessage);
+
+                msg.emplace();
+                (*msg)["@odata.type"] = "#Event.v1_4_0.Event";
+                (*msg)["Name"] = "Event Log";
+                (*msg)["Id"] = eventId;
+                (*msg)["Events"] = std::move(eventRecord);
             }
-
-            nlohmann::json::array_t eventRecord;
-            eventRecord.emplace_back(eventMessage);
-
-            nlohmann::json msgJson;
-
-            msgJson["@odata.type"] = "#Event.v1_4_0.Event";
-            msgJson["Name"] = "Event Log";
-            msgJson["Id"] = eventId;
-            msgJson["Events"] = std::move(eventRecord);
-
-            std::string strMsg = msgJson.dump(
-                2, ' ', true, nlohmann::json::error_handler_t::replace);
-            entry->sendEventToSubscriber(eventId, std::move(strMsg));
+            queueEventPayload(*entry, eventId, *msg, body);
         }
     }
 };
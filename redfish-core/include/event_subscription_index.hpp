@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#pragma once
+
+#include "event_matches_filter.hpp"
+#include "event_service_store.hpp"
+
+#include <boost/container/flat_map.hpp>
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace redfish
+{
+
+// Inverted index from the RegistryPrefixes, MessageIds, OriginResources and
+// ResourceTypes of each subscription to the subscription itself.  Dispatching
+// an event only needs to look at the subscriptions that can possibly match
+// it, rather than walking the filter lists of every subscription.
+template <typename Value>
+class EventSubscriptionIndex
+{
+  public:
+    void add(const std::string& id,
+             const persistent_data::UserSubscription& userSub,
+             const Value& value)
+    {
+        remove(id);
+        dimensions[registryPrefixIndex].add(id, userSub.registryPrefixes,
+                                            value);
+        dimensions[messageIdIndex].add(id, userSub.registryMsgIds, value);
+        dimensions[originIndex].add(id, userSub.originResources, value);
+        dimensions[resourceTypeIndex].add(id, userSub.resourceTypes, value);
+    }
+
+    void remove(const std::string& id)
+    {
+        for (Dimension& dimension : dimensions)
+        {
+            dimension.remove(id);
+        }
+    }
+
+    // Returns the subscriptions that may match the event, in id order.  The
+    // candidates are taken from the most selective filter, so callers still
+    // need to confirm each one with eventMatchesFilter.
+    std::vector<Value> getCandidates(
+        const nlohmann::json::object_t& eventMessage,
+        std::string_view resourceType) const
+    {
+        std::string registry;
+        std::string messageKey;
+        const std::string* messageId = getString(eventMessage, "MessageId");
+        if (messageId != nullptr)
+        {
+            getRegistryAndMessageKey(*messageId, registry, messageKey);
+        }
+        std::string registryMsgId = std::format("{}.{}", registry, messageKey);
+        const std::string* origin =
+            getString(eventMessage, "OriginOfCondition");
+
+        std::array<std::string_view, 4> keys{};
+        keys[registryPrefixIndex] = registry;
+        keys[messageIdIndex] = registryMsgId;
+        if (origin != nullptr)
+        {
+            keys[originIndex] = *origin;
+        }
+        keys[resourceTypeIndex] = resourceType;
+
+        size_t best = 0;
+        for (size_t i = 1; i < dimensions.size(); i++)
+        {
+            if (dimensions[i].count(keys[i]) <
+                dimensions[best].count(keys[best]))
+            {
+                best = i;
+            }
+        }
+        return dimensions[best].get(keys[best]);
+    }
+
+  private:
+    // Keyed by subscription id, so candidates come out in a stable order
+    using Entries = boost::container::flat_map<std::string, Value>;
+
+    struct Dimension
+    {
+        // Subscriptions that don't filter on this property
+        Entries any;
+        boost::container::flat_map<std::string, Entries, std::less<>> byKey;
+        boost::container::flat_map<std::string, std::vector<std::string>>
+            keysById;
+
+        void add(const std::string& id, const std::vector<std::string>& keys,
+                 const Value& value)
+        {
+            if (keys.empty())
+            {
+                any.emplace(id, value);
+                return;
+            }
+            for (const std::string& key : keys)
+            {
+                byKey[key].emplace(id, value);
+            }
+            keysById.emplace(id, keys);
+        }
+
+        void remove(const std::string& id)
+        {
+            any.erase(id);
+            auto keys = keysById.find(id);
+            if (keys == keysById.end())
+            {
+                return;
+            }
+            for (const std::string& key : keys->second)
+            {
+                auto entries = byKey.find(key);
+                if (entries == byKey.end())
+                {
+                    continue;
+                }
+                entries->second.erase(id);
+                if (entries->second.empty())
+                {
+                    byKey.erase(entries);
+                }
+            }
+            keysById.erase(keys);
+        }
+
+        size_t count(std::string_view key) const
+        {
+            auto entries = byKey.find(key);
+            if (entries == byKey.end())
+            {
+                return any.size();
+            }
+            return any.size() + entries->second.size();
+        }
+
+        std::vector<Value> get(std::string_view key) const
+        {
+            std::vector<Value> out;
+            auto entries = byKey.find(key);
+            if (entries == byKey.end())
+            {
+                out.reserve(any.size());
+                for (const auto& [id, value] : any)
+                {
+                    out.emplace_back(value);
+                }
+                return out;
+            }
+            // A subscription is either in any or in byKey, never both, so
+            // merging the two by id gives each one once
+            out.reserve(any.size() + entries->second.size());
+            auto left = any.begin();
+            auto right = entries->second.begin();
+            while (left != any.end() || right != entries->second.end())
+            {
+                if (right == entries->second.end() ||
+                    (left != any.end() && left->first < right->first))
+                {
+                    out.emplace_back(left->second);
+                    left++;
+                }
+                else
+                {
+                    out.emplace_back(right->second);
+                    right++;
+                }
+            }
+            return out;
+        }
+    };
+
+    static const std::string* getString(const nlohmann::json::object_t& obj,
+                                        const char* key)
+    {
+        auto it = obj.find(key);
+        if (it == obj.end())
+        {
+            return nullptr;
+        }
+        return it->second.get_ptr<const std::string*>();
+    }
+
+    static constexpr size_t registryPrefixIndex = 0;
+    static constexpr size_t messageIdIndex = 1;
+    static constexpr size_t originIndex = 2;
+    static constexpr size_t resourceTypeIndex = 3;
+
+    std::array<Dimension, 4> dimensions;
+};
+
+} // namespace redfish
@@ -6,11 +6,86 @@
 
 #include <nlohmann/json.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
 namespace redfish
 {
 
-bool memberMatches(const nlohmann::json& member,
-                   const filter_ast::LogicalAnd& filterParam);
+namespace filter_program
+{
+
+// A property of the member, looked up the way a json pointer would be
+struct Key
+{
+    std::string name;
+    // Whether the property is an Edm.DateTimeOffset
+    bool isDateTime = false;
+};
+
+// A quoted string from the expression
+struct Literal
+{
+    std::string value;
+    // The literal as microseconds since epoch, if it parses as a date
+    std::optional<int64_t> dateUs;
+};
+
+using Operand = std::variant<double, int64_t, Literal, Key>;
+
+struct Comparison
+{
+    Operand left;
+    filter_ast::ComparisonOpEnum token = filter_ast::ComparisonOpEnum::Invalid;
+    Operand right;
+};
+
+enum class OpCode : uint8_t
+{
+    // Pushes the result of comparisons[arg]
+    Compare,
+    // Negates the top of the stack
+    Not,
+    // Replaces the top arg results with their conjunction or disjunction
+    And,
+    Or,
+};
+
+struct Instruction
+{
+    OpCode op = OpCode::Compare;
+    size_t arg = 0;
+};
+
+} // namespace filter_program
+
+// A $filter expression compiled into a flat postfix program once, so that
+// checking each member doesn't walk the parser's AST
+class CompiledFilter
+{
+  public:
+    explicit CompiledFilter(const filter_ast::LogicalAnd& filter);
+
+    // Whether a fully built member matches
+    bool matches(const nlohmann::json& member) const;
+
+    // Whether a member could match when only the properties in |known| are
+    // available.  Comparisons on other properties could go either way, so
+    // false means the member can be dropped before the rest of it is built.
+    bool mayMatch(const nlohmann::json& known) const;
+
+  private:
+    bool run(const nlohmann::json& member, bool partial) const;
+
+    std::vector<filter_program::Comparison> comparisons;
+    std::vector<filter_program::Instruction> program;
+};
+
+bool memberMatches(const nlohmann::json& member, const CompiledFilter& filter);
 
 bool applyFilterToCollection(nlohmann::json& body,
                              const filter_ast::LogicalAnd& filterParam);
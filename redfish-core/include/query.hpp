@@ -190,6 +190,14 @@ inline bool handleIfMatch(crow::App& app, const crow::Request& req,
     // Cleanup is required here.
     auto newReq = std::make_shared<crow::Request>(req.copy());
 
+    if (!queryOpt->selectTrie.root.empty())
+    {
+        // Kept even if the handler takes over $select, so that it can skip
+        // fetching properties that won't be returned
+        asyncResp->selectTrie = std::make_shared<query_param::SelectTrieNode>(
+            queryOpt->selectTrie.root);
+    }
+
     delegated = query_param::delegate(queryCapabilities, *queryOpt);
     std::function<void(crow::Response&)> handler =
         asyncResp->res.releaseCompleteRequestHandler();
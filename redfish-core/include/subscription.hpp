@@ -3,9 +3,10 @@
 // SPDX-FileCopyrightText: Copyright 2020 Intel Corporation
 #pragma once
 
-#include "event_logs_object_type.hpp"
+#include "bmcweb_config.h"
+
 #include "event_service_store.hpp"
-#include "filter_expr_parser_ast.hpp"
+#include "filter_expr_executor.hpp"
 #include "http_client.hpp"
 #include "http_response.hpp"
 #include "server_sent_event.hpp"
@@ -14,12 +15,16 @@
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/url/url_view_base.hpp>
+#include <nlohmann/json.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace redfish
@@ -27,8 +32,31 @@ namespace redfish
 
 static constexpr const char* subscriptionTypeSSE = "SSE";
 
-static constexpr const uint8_t maxNoOfSubscriptions = 20;
-static constexpr const uint8_t maxNoOfSSESubscriptions = 10;
+static constexpr const size_t maxNoOfSubscriptions =
+    static_cast<size_t>(BMCWEB_REDFISH_MAX_SUBSCRIPTIONS);
+static constexpr const size_t maxNoOfSSESubscriptions =
+    static_cast<size_t>(BMCWEB_REDFISH_MAX_SSE_SUBSCRIPTIONS);
+
+// Number of events that can wait for the coalescing window before the
+// pending payloads are flushed early
+static constexpr const size_t maxPendingEvents = 100;
+
+// Per-destination delivery counters for push style subscriptions
+struct DeliveryStats
+{
+    // Events handed to the subscription for delivery
+    uint64_t eventsQueued = 0;
+    // Requests sent to the destination
+    uint64_t payloadsSent = 0;
+    // Events that were merged into another event's request
+    uint64_t eventsCoalesced = 0;
+    // Events that the destination never accepted, either because the
+    // outgoing request queue was full or the retries were exhausted
+    uint64_t eventsDropped = 0;
+    // Largest number of events that waited for the coalescing window
+    size_t maxPendingEvents = 0;
+};
+
 struct TestEvent
 {
     std::optional<int64_t> eventGroupId;
@@ -59,7 +87,7 @@ class Subscription : public std::enable_shared_from_this<Subscription>
 
     // callback for subscription sendData
     void resHandler(const std::shared_ptr<Subscription>& /*self*/,
-                    const crow::Response& res);
+                    size_t eventCount, const crow::Response& res);
 
     void sendHeartbeatEvent();
     void scheduleNextHeartbeatEvent();
@@ -67,10 +95,35 @@ class Subscription : public std::enable_shared_from_this<Subscription>
     void onHbTimeout(const std::weak_ptr<Subscription>& weakSelf,
                      const boost::system::error_code& ec);
 
+    // Sends an event straight away.  Events still waiting for the coalescing
+    // window are sent first, so they aren't overtaken.
     bool sendEventToSubscriber(uint64_t eventId, std::string&& msg);
 
-    void filterAndSendEventLogs(
-        uint64_t eventId, const std::vector<EventLogObjectsType>& eventRecords);
+    // Whether queueEvent holds events for the coalescing window rather than
+    // sending them straight away
+    bool coalescesEvents() const
+    {
+        return client && coalescingWindow.count() > 0;
+    }
+
+    // Like sendEventToSubscriber, but push subscriptions hold the event for
+    // the coalescing window so that a burst of events is delivered as one
+    // request with a combined Events array.  The events are kept as JSON and
+    // only serialized once the request is sent.
+    bool queueEvent(uint64_t eventId, nlohmann::json::object_t&& msg);
+
+    // Sends the events waiting for the coalescing window straight away
+    void flushPendingEvents();
+
+    const DeliveryStats& getDeliveryStats() const
+    {
+        return stats;
+    }
+
+    // Checks a formatted log entry against the $filter given when the
+    // subscription was created, as the entry would be sent with |eventId|
+    bool eventLogMatchesFilter(const nlohmann::json& logEntry,
+                               uint64_t eventId) const;
 
     void filterAndSendReports(uint64_t eventId, const std::string& reportId,
                               const telemetry::TimestampReadings& var);
@@ -88,6 +141,10 @@ class Subscription : public std::enable_shared_from_this<Subscription>
     std::function<void()> deleter;
 
   private:
+    bool sendPayload(uint64_t eventId, std::string&& msg, size_t eventCount);
+    void onCoalescingTimeout(const std::weak_ptr<Subscription>& weakSelf,
+                             const boost::system::error_code& ec);
+
     boost::urls::url host;
     std::shared_ptr<crow::ConnectionPolicy> policy;
     crow::sse_socket::Connection* sseConn = nullptr;
@@ -95,8 +152,15 @@ class Subscription : public std::enable_shared_from_this<Subscription>
     boost::asio::steady_timer hbTimer;
     std::optional<crow::HttpClient> client;
 
+    std::chrono::milliseconds coalescingWindow{
+        BMCWEB_REDFISH_EVENT_COALESCING_MS};
+    boost::asio::steady_timer coalescingTimer;
+    std::vector<std::pair<uint64_t, nlohmann::json::object_t>> pendingEvents;
+    DeliveryStats stats;
+
   public:
-    std::optional<filter_ast::LogicalAnd> filter;
+    // Compiled once when the filter is set rather than for every event
+    std::optional<CompiledFilter> filter;
 };
 
 } // namespace redfish
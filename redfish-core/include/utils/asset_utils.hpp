@@ -7,6 +7,7 @@
 #include "error_messages.hpp"
 #include "logging.hpp"
 #include "utils/dbus_utils.hpp"
+#include "utils/query_param.hpp"
 
 #include <asm-generic/errno.h>
 
@@ -18,6 +19,7 @@
 #include <memory>
 #include <ranges>
 #include <string>
+#include <string_view>
 
 namespace redfish
 {
@@ -93,12 +95,35 @@ inline void afterGetAssetInfo(
                      includeManufacturer);
 }
 
+// Returns false if $select drops everything getAssetInfo() would write
+inline bool isAssetInfoSelected(const bmcweb::AsyncResp& asyncResp,
+                                const nlohmann::json::json_pointer& jsonKeyName)
+{
+    if (jsonKeyName.empty())
+    {
+        return query_param::isSelected(
+            asyncResp, {"Manufacturer", "Model", "PartNumber", "SerialNumber",
+                        "SparePartNumber"});
+    }
+    // $select applies to the top level property the asset is written under
+    std::string key = jsonKeyName.to_string();
+    std::string_view topLevel(key);
+    topLevel.remove_prefix(1);
+    topLevel = topLevel.substr(0, topLevel.find('/'));
+    return query_param::isSelected(asyncResp, {topLevel});
+}
+
 inline void getAssetInfo(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const std::string& serviceName, const std::string& dbusPath,
     const nlohmann::json::json_pointer& jsonKeyName,
     bool includeSparePartNumber = false, bool includeManufacturer = true)
 {
+    if (!isAssetInfoSelected(*asyncResp, jsonKeyName))
+    {
+        BMCWEB_LOG_DEBUG("Asset information isn't selected");
+        return;
+    }
     dbus::utility::getAllProperties(
         serviceName, dbusPath, "xyz.openbmc_project.Inventory.Decorator.Asset",
         std::bind_front(afterGetAssetInfo, asyncResp, jsonKeyName,
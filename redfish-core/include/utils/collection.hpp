@@ -6,16 +6,21 @@
 #include "dbus_utility.hpp"
 #include "error_messages.hpp"
 #include "http/utility.hpp"
+#include "human_sort.hpp"
 #include "json_utils.hpp"
 #include "logging.hpp"
+#include "utils/query_param.hpp"
 
 #include <boost/url/url.hpp>
 #include <nlohmann/json.hpp>
 #include <sdbusplus/message/native_types.hpp>
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <span>
 #include <string>
@@ -48,11 +53,32 @@ inline nlohmann::json::array_t& getJsonArray(nlohmann::json& parent,
     return details::getJsonArrayAt(parent[key]);
 }
 
-inline void handleCollectionMembers(
+// The query parameters getCollectionMembers() can take over from the default
+// handler, when it's given the delegated query
+constexpr query_param::QueryCapabilities collectionCapabilities{
+    .canDelegateTop = true,
+    .canDelegateSkip = true,
+};
+
+inline void appendCollectionMember(nlohmann::json::array_t& membersArr,
+                                   const boost::urls::url& collectionPath,
+                                   std::string_view leaf)
+{
+    boost::urls::url url = collectionPath;
+    crow::utility::appendUrlPieces(url, leaf);
+    nlohmann::json::object_t member;
+    member["@odata.id"] = std::move(url);
+    membersArr.emplace_back(std::move(member));
+}
+
+// Fills in the members in [skip, skip + top) of the sorted collection.  Leaf
+// names are sorted as plain strings, and only as far as the end of the window,
+// so that JSON is only built for the members that are returned.
+inline void handleCollectionMembersPage(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const boost::urls::url& collectionPath,
-    const nlohmann::json::json_pointer& jsonKeyName,
-    const boost::system::error_code& ec,
+    const nlohmann::json::json_pointer& jsonKeyName, size_t skip,
+    std::optional<size_t> top, const boost::system::error_code& ec,
     const dbus::utility::MapperGetSubTreePathsResponse& objects)
 {
     if (jsonKeyName.empty())
@@ -82,6 +108,7 @@ inline void handleCollectionMembers(
     }
 
     std::vector<std::string> pathNames;
+    pathNames.reserve(objects.size());
     for (const auto& object : objects)
     {
         sdbusplus::object_path path(object);
@@ -90,21 +117,55 @@ inline void handleCollectionMembers(
         {
             continue;
         }
-        pathNames.push_back(leaf);
+        pathNames.push_back(std::move(leaf));
     }
 
     nlohmann::json::array_t& membersArr =
         details::getJsonArrayAt(asyncResp->res.jsonValue[jsonKeyName]);
-    for (const std::string& leaf : pathNames)
+    size_t count = membersArr.size() + pathNames.size();
+    size_t begin = std::min(skip, count);
+    size_t end = begin + std::min(top.value_or(count), count - begin);
+
+    if (!membersArr.empty())
+    {
+        // Another call already added members, which have to be sorted in with
+        // these as JSON
+        for (const std::string& leaf : pathNames)
+        {
+            appendCollectionMember(membersArr, collectionPath, leaf);
+        }
+        json_util::sortJsonArrayByOData(membersArr);
+        membersArr.erase(membersArr.begin() + static_cast<ssize_t>(end),
+                         membersArr.end());
+        membersArr.erase(membersArr.begin(),
+                         membersArr.begin() + static_cast<ssize_t>(begin));
+        asyncResp->res.jsonValue[jsonCountKeyName] = count;
+        return;
+    }
+
+    // Every member shares the collection path, so sorting the leaves sorts
+    // the members the way sortJsonArrayByOData() would
+    std::vector<HumanSortKey> keys(pathNames.begin(), pathNames.end());
+    auto windowEnd = keys.begin() + static_cast<ssize_t>(end);
+    std::ranges::partial_sort(keys, windowEnd);
+    membersArr.reserve(end - begin);
+    for (const HumanSortKey& key : std::ranges::subrange(
+             keys.begin() + static_cast<ssize_t>(begin), windowEnd))
     {
-        boost::urls::url url = collectionPath;
-        crow::utility::appendUrlPieces(url, leaf);
-        nlohmann::json::object_t member;
-        member["@odata.id"] = std::move(url);
-        membersArr.emplace_back(std::move(member));
+        appendCollectionMember(membersArr, collectionPath, key.view());
     }
-    json_util::sortJsonArrayByOData(membersArr);
-    asyncResp->res.jsonValue[jsonCountKeyName] = membersArr.size();
+    asyncResp->res.jsonValue[jsonCountKeyName] = count;
+}
+
+inline void handleCollectionMembers(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const boost::urls::url& collectionPath,
+    const nlohmann::json::json_pointer& jsonKeyName,
+    const boost::system::error_code& ec,
+    const dbus::utility::MapperGetSubTreePathsResponse& objects)
+{
+    handleCollectionMembersPage(asyncResp, collectionPath, jsonKeyName, 0,
+                                std::nullopt, ec, objects);
 }
 
 /**
@@ -142,5 +203,32 @@ inline void getCollectionMembers(
                        nlohmann::json::json_pointer("/Members"));
 }
 
+/**
+ * @brief Populate the members of a collection whose handler delegated $skip
+ *        and $top with collectionCapabilities
+ *
+ * @param[i,o] asyncResp  Async response object
+ * @param[i]   collectionPath  Redfish collection path which is used for the
+ *             Members Redfish Path
+ * @param[i]   interfaces  List of interfaces to constrain the GetSubTree search
+ * @param[in]  subtree     D-Bus base path to constrain search to.
+ * @param[in]  delegatedQuery  The query parameters the handler took over
+ *
+ * @return void
+ */
+inline void getCollectionMembers(
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const boost::urls::url& collectionPath,
+    std::span<const std::string_view> interfaces, const std::string& subtree,
+    const query_param::Query& delegatedQuery)
+{
+    BMCWEB_LOG_DEBUG("Get collection members for: {}", collectionPath.buffer());
+    dbus::utility::getSubTreePaths(
+        subtree, 0, interfaces,
+        std::bind_front(handleCollectionMembersPage, asyncResp, collectionPath,
+                        nlohmann::json::json_pointer("/Members"),
+                        delegatedQuery.skip.value_or(0), delegatedQuery.top));
+}
+
 } // namespace collection_util
 } // namespace redfish
@@ -7,6 +7,7 @@
 #include "dbus_utility.hpp"
 #include "error_messages.hpp"
 #include "event_log.hpp"
+#include "filter_expr_executor.hpp"
 #include "generated/enums/log_service.hpp"
 #include "http_response.hpp"
 #include "logging.hpp"
@@ -193,12 +194,14 @@ enum class LogParseError
     success,
     parseFailed,
     messageIdNotInRegistry,
+    filteredOut,
 };
 
 static LogParseError fillEventLogEntryJson(
     const std::string& logEntryID, const std::string& logEntry,
     nlohmann::json::object_t& logEntryJson, const std::string& collectionStr,
-    const std::string_view memberId, const std::string& logEntryDescriptor)
+    const std::string_view memberId, const std::string& logEntryDescriptor,
+    const CompiledFilter* filter = nullptr)
 {
     // The redfish log format is "<Timestamp> <MessageId>,<MessageArgs>"
     // First get the Timestamp
@@ -254,6 +257,33 @@ static LogParseError fillEventLogEntryJson(
 
     const unsigned int& versionMajor = registry->get().header.versionMajor;
     const unsigned int& versionMinor = registry->get().header.versionMinor;
+    std::string versionedMessageId =
+        std::format("{}.{}.{}.{}", msgComponents->registryName, versionMajor,
+                    versionMinor, msgComponents->messageKey);
+
+    // Get the Created time from the timestamp. The log timestamp is in RFC3339
+    // format which matches the Redfish format except for the
+    // fractional seconds between the '.' and the '+', so just remove them.
+    std::size_t dot = timestamp.find_first_of('.');
+    std::size_t plus = timestamp.find_first_of('+');
+    if (dot != std::string::npos && plus != std::string::npos)
+    {
+        timestamp.erase(dot, plus - dot);
+    }
+
+    // Skip formatting the message for entries $filter will drop
+    if (filter != nullptr)
+    {
+        nlohmann::json known;
+        known["MessageId"] = versionedMessageId;
+        known["Severity"] = message->messageSeverity;
+        known["Created"] = timestamp;
+        known["EntryType"] = "Event";
+        if (!filter->mayMatch(known))
+        {
+            return LogParseError::filteredOut;
+        }
+    }
 
     std::vector<std::string_view> messageArgs(logEntryIter,
                                               logEntryFields.end());
@@ -266,16 +296,6 @@ static LogParseError fillEventLogEntryJson(
         return LogParseError::parseFailed;
     }
 
-    // Get the Created time from the timestamp. The log timestamp is in RFC3339
-    // format which matches the Redfish format except for the
-    // fractional seconds between the '.' and the '+', so just remove them.
-    std::size_t dot = timestamp.find_first_of('.');
-    std::size_t plus = timestamp.find_first_of('+');
-    if (dot != std::string::npos && plus != std::string::npos)
-    {
-        timestamp.erase(dot, plus - dot);
-    }
-
     // Fill in the log entry with the gathered data
     logEntryJson["@odata.type"] = "#LogEntry.v1_9_0.LogEntry";
     logEntryJson["@odata.id"] =
@@ -285,9 +305,7 @@ static LogParseError fillEventLogEntryJson(
         std::format("{} Event Log Entry", logEntryDescriptor);
     logEntryJson["Id"] = logEntryID;
     logEntryJson["Message"] = std::move(msg);
-    logEntryJson["MessageId"] =
-        std::format("{}.{}.{}.{}", msgComponents->registryName, versionMajor,
-                    versionMinor, msgComponents->messageKey);
+    logEntryJson["MessageId"] = std::move(versionedMessageId);
     logEntryJson["MessageArgs"] = messageArgs;
     logEntryJson["EntryType"] = "Event";
     logEntryJson["Severity"] = message->messageSeverity;
@@ -301,6 +319,13 @@ inline void handleSystemsAndManagersLogServiceEventLogLogEntryCollection(
 {
     size_t top = delegatedQuery.top.value_or(query_param::Query::maxTop);
     size_t skip = delegatedQuery.skip.value_or(0);
+    // Entries are filtered before paging, as $filter comes before
+    // $skip and $top
+    std::optional<CompiledFilter> filter;
+    if (delegatedQuery.filter)
+    {
+        filter.emplace(*delegatedQuery.filter);
+    }
 
     const std::string collectionStr =
         logServiceParentCollectionToString(collection);
@@ -359,8 +384,9 @@ inline void handleSystemsAndManagersLogServiceEventLogLogEntryCollection(
             nlohmann::json::object_t bmcLogEntry;
             LogParseError status = fillEventLogEntryJson(
                 idStr, logEntry, bmcLogEntry, collectionStr, memberId,
-                logEntryDescriptor);
-            if (status == LogParseError::messageIdNotInRegistry)
+                logEntryDescriptor, filter ? &*filter : nullptr);
+            if (status == LogParseError::messageIdNotInRegistry ||
+                status == LogParseError::filteredOut)
             {
                 continue;
             }
@@ -571,7 +597,9 @@ inline void fillEventLogLogEntryFromDbusLogEntry(
 inline void afterLogEntriesGetManagedObjects(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const std::string& collectionStr, const std::string_view memberId,
-    const std::string& logEntryDescriptor, const boost::system::error_code& ec,
+    const std::string& logEntryDescriptor,
+    const std::optional<CompiledFilter>& filter,
+    const boost::system::error_code& ec,
     const dbus::utility::ManagedObjectType& resp)
 {
     if (ec)
@@ -619,6 +647,20 @@ inline void afterLogEntriesGetManagedObjects(
             messages::internalError(asyncResp->res);
             return;
         }
+        // Skip building entries $filter will drop
+        if (filter)
+        {
+            nlohmann::json known;
+            known["Severity"] =
+                translateSeverityDbusToRedfish(optEntry->Severity);
+            known["Created"] =
+                redfish::time_utils::getDateTimeUintMs(optEntry->Timestamp);
+            known["EntryType"] = "Event";
+            if (!filter->mayMatch(known))
+            {
+                continue;
+            }
+        }
         fillEventLogLogEntryFromDbusLogEntry(
             *optEntry, entriesArray.emplace_back(), collectionStr, memberId,
             logEntryDescriptor);
@@ -631,6 +673,7 @@ inline void afterLogEntriesGetManagedObjects(
 
 inline void dBusEventLogEntryCollection(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const query_param::Query& delegatedQuery,
     LogServiceParentCollection collection)
 {
     const std::string_view memberId =
@@ -658,16 +701,24 @@ inline void dBusEventLogEntryCollection(
     asyncResp->res.jsonValue["Description"] =
         std::format("Collection of {} Event Log Entries", logEntryDescriptor);
 
+    std::optional<CompiledFilter> filter;
+    if (delegatedQuery.filter)
+    {
+        filter.emplace(*delegatedQuery.filter);
+    }
+
     // DBus implementation of EventLog/Entries
     // Make call to Logging Service to find all log entry objects
     sdbusplus::object_path path("/xyz/openbmc_project/logging");
     dbus::utility::getManagedObjects(
         "xyz.openbmc_project.Logging", path,
-        [asyncResp, collectionStr, memberId,
-         logEntryDescriptor](const boost::system::error_code& ec,
-                             const dbus::utility::ManagedObjectType& resp) {
+        [asyncResp, collectionStr, memberId, logEntryDescriptor,
+         filter{std::move(filter)}](
+            const boost::system::error_code& ec,
+            const dbus::utility::ManagedObjectType& resp) {
             afterLogEntriesGetManagedObjects(asyncResp, collectionStr, memberId,
-                                             logEntryDescriptor, ec, resp);
+                                             logEntryDescriptor, filter, ec,
+                                             resp);
         });
 }
 
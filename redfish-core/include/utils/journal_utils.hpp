@@ -2,6 +2,7 @@
 
 #include "bmcweb_config.h"
 
+#include "filter_expr_executor.hpp"
 #include "generated/enums/log_entry.hpp"
 #include "logging.hpp"
 #include "utility.hpp"
@@ -18,6 +19,7 @@
 #include <cstdlib>
 #include <format>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -54,6 +56,39 @@ inline std::optional<std::string> getEntryTimestamp(JournalReadState& journal)
     return redfish::time_utils::getDateTimeUintUs(*timestamp);
 }
 
+inline log_entry::EventSeverity journalPriorityToSeverity(long int priority)
+{
+    if (priority <= 2)
+    {
+        return log_entry::EventSeverity::Critical;
+    }
+    if (priority <= 4)
+    {
+        return log_entry::EventSeverity::Warning;
+    }
+    return log_entry::EventSeverity::OK;
+}
+
+// Whether the entry the journal is at could match $filter, going by the
+// fields that are cheap to read, so that the rest needn't be read for
+// entries that $filter will drop
+inline bool journalEntryMayMatch(JournalReadState& journal,
+                                 const CompiledFilter& filter)
+{
+    nlohmann::json known;
+    std::optional<long int> severity =
+        getJournalMetadataInt(journal, "PRIORITY");
+    // Default to an invalid priority, as fillBMCJournalLogEntryJson() does
+    known["Severity"] = journalPriorityToSeverity(severity.value_or(8));
+    std::optional<std::string> entryTimeStr = getEntryTimestamp(journal);
+    if (entryTimeStr)
+    {
+        known["Created"] = std::move(*entryTimeStr);
+    }
+    known["EntryType"] = log_entry::LogEntryType::Oem;
+    return filter.mayMatch(known);
+}
+
 inline bool fillBMCJournalLogEntryJson(
     JournalReadState& journal, nlohmann::json::object_t& bmcJournalLogEntryJson)
 {
@@ -108,17 +143,7 @@ inline bool fillBMCJournalLogEntryJson(
     bmcJournalLogEntryJson["Id"] = entryIdBase64;
     bmcJournalLogEntryJson["Message"] = std::move(message);
     bmcJournalLogEntryJson["EntryType"] = log_entry::LogEntryType::Oem;
-    log_entry::EventSeverity rfseverity = log_entry::EventSeverity::OK;
-    if (severity <= 2)
-    {
-        rfseverity = log_entry::EventSeverity::Critical;
-    }
-    else if (severity <= 4)
-    {
-        rfseverity = log_entry::EventSeverity::Warning;
-    }
-
-    bmcJournalLogEntryJson["Severity"] = rfseverity;
+    bmcJournalLogEntryJson["Severity"] = journalPriorityToSeverity(*severity);
     bmcJournalLogEntryJson["OemRecordFormat"] = "BMC Journal Entry";
 
     return true;
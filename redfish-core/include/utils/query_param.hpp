@@ -33,6 +33,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <initializer_list>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -64,7 +65,7 @@ class SelectTrieNode
   public:
     SelectTrieNode() = default;
 
-    const SelectTrieNode* find(const std::string& jsonKey) const
+    const SelectTrieNode* find(std::string_view jsonKey) const
     {
         auto it = children.find(jsonKey);
         if (it == children.end())
@@ -164,6 +165,22 @@ struct SelectTrie
     SelectTrieNode root;
 };
 
+// Returns true unless the $select of the request being answered drops all of
+// |properties|, which are top level properties of the resource.  Handlers use
+// it to skip the D-Bus calls behind properties that processSelect() would
+// remove anyway.
+inline bool isSelected(const bmcweb::AsyncResp& asyncResp,
+                       std::initializer_list<std::string_view> properties)
+{
+    if (asyncResp.selectTrie == nullptr || asyncResp.selectTrie->empty())
+    {
+        return true;
+    }
+    return std::ranges::any_of(properties, [&asyncResp](std::string_view key) {
+        return asyncResp.selectTrie->find(key) != nullptr;
+    });
+}
+
 // The struct stores the parsed query parameters of the default Redfish route.
 struct Query
 {
@@ -201,6 +218,9 @@ struct QueryCapabilities
     bool canDelegateSkip = false;
     uint8_t canDelegateExpandLevel = 0;
     bool canDelegateSelect = false;
+    // The handler can drop members that can't match $filter before building
+    // them.  $filter is still applied to the response afterwards.
+    bool canPushDownFilter = false;
 };
 
 // Delegates query parameters according to the given |queryCapabilities|
@@ -253,6 +273,12 @@ inline Query delegate(const QueryCapabilities& queryCapabilities, Query& query)
         delegated.selectTrie = std::move(query.selectTrie);
         query.selectTrie.root.clear();
     }
+
+    // push down filter, keeping it for the final response
+    if (query.filter && queryCapabilities.canPushDownFilter)
+    {
+        delegated.filter = query.filter;
+    }
     return delegated;
 }
 
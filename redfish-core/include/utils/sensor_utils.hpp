@@ -17,6 +17,7 @@
 
 #include <asm-generic/errno.h>
 
+#include <boost/container/flat_map.hpp>
 #include <boost/url/format.hpp>
 #include <nlohmann/json.hpp>
 #include <sdbusplus/message/native_types.hpp>
@@ -162,6 +163,132 @@ class InventoryItem
     LedState ledState = LedState::UNKNOWN;
 };
 
+/**
+ * Inventory items associated with the sensors of one request.  Items are
+ * indexed by inventory object path, sensor object path and LED object path so
+ * that per-sensor lookups don't need to scan every inventory item.
+ */
+class InventoryItems
+{
+  public:
+    /**
+     * @brief Finds the inventory item with the specified object path.
+     * @param invItemObjPath D-Bus object path of inventory item.
+     * @return Inventory item, or nullptr if no match found.
+     */
+    InventoryItem* find(std::string_view invItemObjPath)
+    {
+        return lookup(byObjectPath, invItemObjPath);
+    }
+
+    /**
+     * @brief Finds the inventory item associated with the specified sensor.
+     * @param sensorObjPath D-Bus object path of sensor.
+     * @return Inventory item, or nullptr if no match found.
+     */
+    InventoryItem* findForSensor(std::string_view sensorObjPath)
+    {
+        return lookup(bySensor, sensorObjPath);
+    }
+
+    /**
+     * @brief Finds the inventory item associated with the specified led.
+     * @param ledObjPath D-Bus object path of led.
+     * @return Inventory item, or nullptr if no match found.
+     */
+    InventoryItem* findForLed(std::string_view ledObjPath)
+    {
+        return lookup(byLed, ledObjPath);
+    }
+
+    /**
+     * @brief Adds inventory item and associated sensor.
+     *
+     * Adds a new InventoryItem if one with the specified object path doesn't
+     * already exist, then associates the specified sensor with it.
+     *
+     * @param invItemObjPath D-Bus object path of inventory item.
+     * @param sensorObjPath D-Bus object path of sensor
+     */
+    void add(const std::string& invItemObjPath,
+             const std::string& sensorObjPath)
+    {
+        auto [it, inserted] =
+            byObjectPath.try_emplace(invItemObjPath, items.size());
+        if (inserted)
+        {
+            items.emplace_back(invItemObjPath);
+        }
+        size_t index = it->second;
+        items[index].sensors.emplace(sensorObjPath);
+        bySensor.try_emplace(sensorObjPath, index);
+    }
+
+    /**
+     * @brief Stores the LED object path of the specified inventory item.
+     * @param invItemObjPath D-Bus object path of inventory item.
+     * @param ledObjPath D-Bus object path of led.
+     */
+    void setLedObjectPath(std::string_view invItemObjPath,
+                          const std::string& ledObjPath)
+    {
+        auto it = byObjectPath.find(invItemObjPath);
+        if (it == byObjectPath.end())
+        {
+            return;
+        }
+        InventoryItem& inventoryItem = items[it->second];
+        if (!inventoryItem.ledObjectPath.empty())
+        {
+            auto led = byLed.find(inventoryItem.ledObjectPath);
+            if (led != byLed.end() && led->second == it->second)
+            {
+                byLed.erase(led);
+            }
+        }
+        inventoryItem.ledObjectPath = ledObjPath;
+        byLed.try_emplace(ledObjPath, it->second);
+    }
+
+    auto begin()
+    {
+        return items.begin();
+    }
+
+    auto end()
+    {
+        return items.end();
+    }
+
+    size_t size() const
+    {
+        return items.size();
+    }
+
+    bool empty() const
+    {
+        return items.empty();
+    }
+
+  private:
+    using Index = boost::container::flat_map<std::string, size_t, std::less<>>;
+
+    InventoryItem* lookup(const Index& index, std::string_view objPath)
+    {
+        auto it = index.find(objPath);
+        if (it == index.end())
+        {
+            return nullptr;
+        }
+        return &items[it->second];
+    }
+
+    std::vector<InventoryItem> items;
+    Index byObjectPath;
+    Index bySensor;
+    Index byLed;
+};
+
 inline std::string getSensorId(std::string_view sensorName,
                                std::string_view sensorType)
 {
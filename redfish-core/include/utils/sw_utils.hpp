@@ -11,6 +11,7 @@
 #include "generated/enums/resource.hpp"
 #include "logging.hpp"
 #include "utils/dbus_utils.hpp"
+#include "utils/query_param.hpp"
 
 #include <asm-generic/errno.h>
 
@@ -302,6 +303,15 @@ inline void populateSoftwareInformation(
     const std::string& swVersionPurpose,
     const std::string& activeVersionPropName, const bool populateLinkToImages)
 {
+    bool versionSelected =
+        query_param::isSelected(*asyncResp, {activeVersionPropName});
+    bool linksSelected =
+        populateLinkToImages && query_param::isSelected(*asyncResp, {"Links"});
+    if (!versionSelected && !linksSelected)
+    {
+        BMCWEB_LOG_DEBUG("Software information isn't selected");
+        return;
+    }
     auto swPath = getFunctionalSoftwarePath(swVersionPurpose);
     if (!swPath)
     {
@@ -85,7 +85,7 @@ inline void handleSystemCollectionMembers(
         }
         pathNames.emplace_back(leaf);
     }
-    std::ranges::sort(pathNames, AlphanumLess<std::string>());
+    humanSort(pathNames);
 
     for (const std::string& systemName : pathNames)
     {
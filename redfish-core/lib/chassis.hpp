@@ -552,8 +552,14 @@ inline void handleDecoratorAssetProperties(
                                                BMCWEB_REDFISH_MANAGER_URI_NAME);
     managedBy.emplace_back(std::move(manager));
     asyncResp->res.jsonValue["Links"]["ManagedBy"] = std::move(managedBy);
-    getChassisState(asyncResp);
-    getStorageLink(asyncResp, path);
+    if (query_param::isSelected(*asyncResp, {"PowerState", "Status"}))
+    {
+        getChassisState(asyncResp);
+    }
+    if (query_param::isSelected(*asyncResp, {"Links"}))
+    {
+        getStorageLink(asyncResp, path);
+    }
 }
 
 inline void handleChassisProperties(
@@ -613,13 +619,19 @@ inline void handleChassisGetSubTree(
             continue;
         }
 
-        getChassisConnectivity(asyncResp, chassisId, path);
-
-        // Multi-host Processor URIs are not resolvable yet. The
-        // Processor resource returns 404 under multi-host.
-        if constexpr (!BMCWEB_EXPERIMENTAL_REDFISH_MULTI_COMPUTER_SYSTEM)
+        // Properties that are fetched from D-Bus are only fetched if $select
+        // keeps them
+        using query_param::isSelected;
+        if (isSelected(*asyncResp, {"Links"}))
         {
-            getChassisProcessorLinks(asyncResp, objPath);
+            getChassisConnectivity(asyncResp, chassisId, path);
+
+            // Multi-host Processor URIs are not resolvable yet. The
+            // Processor resource returns 404 under multi-host.
+            if constexpr (!BMCWEB_EXPERIMENTAL_REDFISH_MULTI_COMPUTER_SYSTEM)
+            {
+                getChassisProcessorLinks(asyncResp, objPath);
+            }
         }
 
         if (connectionNames.empty())
@@ -639,21 +651,25 @@ inline void handleChassisGetSubTree(
             .jsonValue["Actions"]["#Chassis.Reset"]["@Redfish.ActionInfo"] =
             boost::urls::format("/redfish/v1/Chassis/{}/ResetActionInfo",
                                 chassisId);
-        dbus::utility::getAssociationEndPoints(
-            path + "/drive",
-            // ast-grep-ignore: long-lambda
-            [asyncResp, chassisId](const boost::system::error_code& ec3,
-                                   const dbus::utility::MapperEndPoints& resp) {
-                if (ec3 || resp.empty())
-                {
-                    return; // no drives = no failures
-                }
+        if (isSelected(*asyncResp, {"Drives"}))
+        {
+            dbus::utility::getAssociationEndPoints(
+                path + "/drive",
+                // ast-grep-ignore: long-lambda
+                [asyncResp,
+                 chassisId](const boost::system::error_code& ec3,
+                            const dbus::utility::MapperEndPoints& resp) {
+                    if (ec3 || resp.empty())
+                    {
+                        return; // no drives = no failures
+                    }
 
-                nlohmann::json reference;
-                reference["@odata.id"] = boost::urls::format(
-                    "/redfish/v1/Chassis/{}/Drives", chassisId);
-                asyncResp->res.jsonValue["Drives"] = std::move(reference);
-            });
+                    nlohmann::json reference;
+                    reference["@odata.id"] = boost::urls::format(
+                        "/redfish/v1/Chassis/{}/Drives", chassisId);
+                    asyncResp->res.jsonValue["Drives"] = std::move(reference);
+                });
+        }
 
         const std::string& connectionName = connectionNames[0].first;
 
@@ -671,7 +687,8 @@ inline void handleChassisGetSubTree(
 
         for (const auto& interface : interfaces2)
         {
-            if (interface == assetTagInterface)
+            if (interface == assetTagInterface &&
+                isSelected(*asyncResp, {"AssetTag"}))
             {
                 dbus::utility::getProperty<std::string>(
                     connectionName, path, assetTagInterface, "AssetTag",
@@ -688,7 +705,8 @@ inline void handleChassisGetSubTree(
                         asyncResp->res.jsonValue["AssetTag"] = property;
                     });
             }
-            else if (interface == replaceableInterface)
+            else if (interface == replaceableInterface &&
+                     isSelected(*asyncResp, {"HotPluggable"}))
             {
                 dbus::utility::getProperty<bool>(
                     connectionName, path, replaceableInterface, "HotPluggable",
@@ -706,7 +724,8 @@ inline void handleChassisGetSubTree(
                         asyncResp->res.jsonValue["HotPluggable"] = property;
                     });
             }
-            else if (interface == revisionInterface)
+            else if (interface == revisionInterface &&
+                     isSelected(*asyncResp, {"Version"}))
             {
                 dbus::utility::getProperty<std::string>(
                     connectionName, path, revisionInterface, "Version",
@@ -723,11 +742,13 @@ inline void handleChassisGetSubTree(
                         asyncResp->res.jsonValue["Version"] = property;
                     });
             }
-            else if (interface == uuidInterface)
+            else if (interface == uuidInterface &&
+                     isSelected(*asyncResp, {"UUID"}))
             {
                 getChassisUUID(asyncResp, connectionName, path);
             }
-            else if (interface == locationCodeInterface)
+            else if (interface == locationCodeInterface &&
+                     isSelected(*asyncResp, {"Location"}))
             {
                 getChassisLocationCode(asyncResp, connectionName, path);
             }
@@ -739,9 +760,15 @@ inline void handleChassisGetSubTree(
             {
                 if constexpr (BMCWEB_REDFISH_ALLOW_DEPRECATED_INDICATORLED)
                 {
-                    getIndicatorLedState(asyncResp);
+                    if (isSelected(*asyncResp, {"IndicatorLED"}))
+                    {
+                        getIndicatorLedState(asyncResp);
+                    }
+                }
+                if (isSelected(*asyncResp, {"LocationIndicatorActive"}))
+                {
+                    getLocationIndicatorActive(asyncResp, objPath);
                 }
-                getLocationIndicatorActive(asyncResp, objPath);
                 break;
             }
         }
@@ -756,14 +783,17 @@ inline void handleChassisGetSubTree(
                                                propertiesList);
             });
 
-        dbus::utility::getAllProperties(
-            *crow::connections::systemBus, connectionName, path,
-            "xyz.openbmc_project.Inventory.Item.Chassis",
-            [asyncResp](
-                const boost::system::error_code&,
-                const dbus::utility::DBusPropertiesMap& propertiesList) {
-                handleChassisProperties(asyncResp, propertiesList);
-            });
+        if (isSelected(*asyncResp, {"ChassisType"}))
+        {
+            dbus::utility::getAllProperties(
+                *crow::connections::systemBus, connectionName, path,
+                "xyz.openbmc_project.Inventory.Item.Chassis",
+                [asyncResp](
+                    const boost::system::error_code&,
+                    const dbus::utility::DBusPropertiesMap& propertiesList) {
+                    handleChassisProperties(asyncResp, propertiesList);
+                });
+        }
 
         return;
     }
@@ -786,6 +816,11 @@ inline void handleChassisGet(
         "/xyz/openbmc_project/inventory", 0, chassisInterfaces,
         std::bind_front(handleChassisGetSubTree, asyncResp, chassisId));
 
+    if (!query_param::isSelected(*asyncResp, {"PhysicalSecurity"}))
+    {
+        return;
+    }
+
     constexpr std::array<std::string_view, 1> interfaces2 = {
         "xyz.openbmc_project.Chassis.Intrusion"};
 
@@ -811,6 +811,20 @@ inline void requestRoutesEventDestination(App& app)
                     mrdJsonArray.emplace_back(std::move(mdr));
                 }
                 jVal["MetricReportDefinitions"] = mrdJsonArray;
+
+                if (userSub.subscriptionType != subscriptionTypeSSE)
+                {
+                    const DeliveryStats& stats = subValue->getDeliveryStats();
+                    nlohmann::json& oem = jVal["Oem"]["OpenBMC"];
+                    oem["@odata.type"] =
+                        "#OpenBMCEventDestination.v1_0_0.EventDestination";
+                    nlohmann::json& delivery = oem["DeliveryStatistics"];
+                    delivery["EventsQueued"] = stats.eventsQueued;
+                    delivery["RequestsSent"] = stats.payloadsSent;
+                    delivery["EventsCoalesced"] = stats.eventsCoalesced;
+                    delivery["EventsDropped"] = stats.eventsDropped;
+                    delivery["MaxPendingEvents"] = stats.maxPendingEvents;
+                }
             });
     BMCWEB_ROUTE(app, "/redfish/v1/EventService/Subscriptions/<str>/")
         // The below privilege is wrong, it should be ConfigureManager OR
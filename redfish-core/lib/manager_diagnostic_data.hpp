@@ -12,6 +12,7 @@
 #include "logging.hpp"
 #include "query.hpp"
 #include "registries/privilege_registry.hpp"
+#include "route_metrics.hpp"
 
 #include <boost/asio/error.hpp>
 #include <boost/beast/http/verb.hpp>
@@ -28,6 +29,7 @@
 #include <ratio>
 #include <source_location>
 #include <string>
+#include <utility>
 
 namespace redfish
 {
@@ -231,6 +233,43 @@ inline void managerGetServiceRootUptime(
         "org.freedesktop.systemd1.Unit", "ActiveEnterTimestampMonotonic",
         std::bind_front(afterGetManagerStartTime, asyncResp));
 }
+inline nlohmann::json::object_t getLatencyJson(
+    const crow::LatencyHistogram& histogram)
+{
+    nlohmann::json::object_t latency;
+    latency["Count"] = histogram.getCount();
+    latency["TotalMicroseconds"] = histogram.getSum();
+    return latency;
+}
+
+// Request counts and timing of each route that has handled a request.  The
+// full latency histograms are available in Prometheus format at /metrics.
+inline void managerGetRouteMetrics(
+    const crow::App& app, const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
+{
+    nlohmann::json::array_t routes;
+    for (const crow::RouteMetricsEntry& entry : app.getRouteMetrics())
+    {
+        const crow::RouteMetrics& metrics = *entry.metrics;
+        nlohmann::json::object_t route;
+        route["Route"] = entry.route;
+        route["Methods"] = entry.methods;
+        route["Requests"] = metrics.requests;
+        route["InFlightRequests"] = metrics.inFlight;
+        route["ResponseBytes"] = metrics.responseBytes;
+        route["Latency"] = getLatencyJson(metrics.latency);
+        route["HandlerTime"] = getLatencyJson(metrics.handlerTime);
+        route["WaitTime"] = getLatencyJson(metrics.waitTime);
+        route["SerializationTime"] = getLatencyJson(metrics.serializationTime);
+        routes.emplace_back(std::move(route));
+    }
+
+    nlohmann::json& oem = asyncResp->res.jsonValue["Oem"]["OpenBMC"];
+    oem["@odata.type"] =
+        "#OpenBMCManagerDiagnosticData.v1_0_0.ManagerDiagnosticData";
+    oem["RouteMetrics"] = std::move(routes);
+}
+
 /**
  * handleManagerDiagnosticData supports ManagerDiagnosticData.
  * It retrieves BMC health information from various DBus resources and returns
@@ -264,6 +303,10 @@ inline void handleManagerDiagnosticDataGet(
     managerGetProcessorStatistics(asyncResp);
     managerGetMemoryStatistics(asyncResp);
     managerGetStorageStatistics(asyncResp);
+    if constexpr (BMCWEB_ROUTE_METRICS)
+    {
+        managerGetRouteMetrics(app, asyncResp);
+    }
 }
 
 inline void requestRoutesManagerDiagnosticData(App& app)
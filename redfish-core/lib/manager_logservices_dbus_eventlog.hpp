@@ -10,6 +10,7 @@
 #include "query.hpp"
 #include "registries/privilege_registry.hpp"
 #include "utils/eventlog_utils.hpp"
+#include "utils/query_param.hpp"
 
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/status.hpp>
@@ -32,7 +33,12 @@ inline void handleManagersDBusEventLogEntryCollection(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const std::string& managerId)
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    query_param::QueryCapabilities capabilities = {
+        .canPushDownFilter = true,
+    };
+    query_param::Query delegatedQuery;
+    if (!redfish::setUpRedfishRouteWithDelegation(app, req, asyncResp,
+                                                  delegatedQuery, capabilities))
     {
         return;
     }
@@ -42,7 +48,8 @@ inline void handleManagersDBusEventLogEntryCollection(
         return;
     }
     eventlog_utils::dBusEventLogEntryCollection(
-        asyncResp, eventlog_utils::LogServiceParentCollection::Managers);
+        asyncResp, delegatedQuery,
+        eventlog_utils::LogServiceParentCollection::Managers);
 }
 
 inline void handleManagersDBusEventLogEntryGet(
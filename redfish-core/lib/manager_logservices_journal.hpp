@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -71,9 +72,10 @@ inline void handleManagersLogServiceJournalGet(
     etag_utils::setEtagOmitDateTimeHandler(asyncResp);
 }
 
+// Reads topEntryCount entries, leaving out those that can't match filter
 inline void readJournalEntries(
     uint64_t topEntryCount, const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    JournalReadState&& readState)
+    JournalReadState&& readState, std::optional<CompiledFilter>&& filter)
 {
     nlohmann::json& logEntry = asyncResp->res.jsonValue["Members"];
     nlohmann::json::array_t* logEntryArray =
@@ -94,28 +96,33 @@ inline void readJournalEntries(
     // control to the io_context to let other operations continue.
     size_t segmentCountRemaining = 10;
 
-    // Reset the unique ID on the first entry
-    for (uint64_t entryCount = logEntryArray->size();
-         entryCount < topEntryCount; entryCount++)
+    // Entries that $filter drops still count towards $top, as paging is done
+    // by sequence number
+    for (uint64_t entryCount = 0; entryCount < topEntryCount; entryCount++)
     {
         if (segmentCountRemaining == 0)
         {
-            boost::asio::post(crow::connections::systemBus->get_io_context(),
-                              [asyncResp, topEntryCount,
-                               readState = std::move(readState)]() mutable {
-                                  readJournalEntries(topEntryCount, asyncResp,
-                                                     std::move(readState));
-                              });
+            boost::asio::post(
+                crow::connections::systemBus->get_io_context(),
+                [asyncResp, remaining = topEntryCount - entryCount,
+                 readState = std::move(readState),
+                 filter = std::move(filter)]() mutable {
+                    readJournalEntries(remaining, asyncResp,
+                                       std::move(readState), std::move(filter));
+                });
             return;
         }
 
-        nlohmann::json::object_t bmcJournalLogEntry;
-        if (!fillBMCJournalLogEntryJson(readState, bmcJournalLogEntry))
+        if (!filter || journalEntryMayMatch(readState, *filter))
         {
-            messages::internalError(asyncResp->res);
-            return;
+            nlohmann::json::object_t bmcJournalLogEntry;
+            if (!fillBMCJournalLogEntryJson(readState, bmcJournalLogEntry))
+            {
+                messages::internalError(asyncResp->res);
+                return;
+            }
+            logEntryArray->emplace_back(std::move(bmcJournalLogEntry));
         }
-        logEntryArray->emplace_back(std::move(bmcJournalLogEntry));
 
         int ret = readState.next();
         if (ret < 0)
@@ -139,6 +146,7 @@ inline void handleManagersJournalLogEntryCollectionGet(
     query_param::QueryCapabilities capabilities = {
         .canDelegateTop = true,
         .canDelegateSkip = true,
+        .canPushDownFilter = true,
     };
     query_param::Query delegatedQuery;
     if (!redfish::setUpRedfishRouteWithDelegation(app, req, asyncResp,
@@ -245,7 +253,12 @@ inline void handleManagersJournalLogEntryCollectionGet(
         }
     }
     BMCWEB_LOG_DEBUG("Index was {}", index);
-    readJournalEntries(top, asyncResp, {std::move(journal)});
+    std::optional<CompiledFilter> filter;
+    if (delegatedQuery.filter)
+    {
+        filter.emplace(*delegatedQuery.filter);
+    }
+    readJournalEntries(top, asyncResp, {std::move(journal)}, std::move(filter));
 }
 
 inline void handleManagersJournalEntriesLogEntryGet(
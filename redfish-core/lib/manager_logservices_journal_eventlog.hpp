@@ -35,6 +35,7 @@ inline void handleManagersLogServiceEventLogLogEntryCollection(
     query_param::QueryCapabilities capabilities = {
         .canDelegateTop = true,
         .canDelegateSkip = true,
+        .canPushDownFilter = true,
     };
     query_param::Query delegatedQuery;
     if (!redfish::setUpRedfishRouteWithDelegation(app, req, asyncResp,
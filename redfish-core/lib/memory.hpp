@@ -20,6 +20,7 @@
 #include "utils/dbus_utils.hpp"
 #include "utils/hex_utils.hpp"
 #include "utils/json_utils.hpp"
+#include "utils/query_param.hpp"
 #include "utils/time_utils.hpp"
 
 #include <asm-generic/errno.h>
@@ -980,7 +981,10 @@ inline void handleMemoryCollectionGet(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const std::string& systemName)
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    query_param::Query delegatedQuery;
+    if (!redfish::setUpRedfishRouteWithDelegation(
+            app, req, asyncResp, delegatedQuery,
+            collection_util::collectionCapabilities))
     {
         return;
     }
@@ -1010,7 +1014,7 @@ inline void handleMemoryCollectionGet(
         asyncResp,
         boost::urls::format("/redfish/v1/Systems/{}/Memory",
                             BMCWEB_REDFISH_SYSTEM_URI_NAME),
-        interfaces, "/xyz/openbmc_project/inventory");
+        interfaces, "/xyz/openbmc_project/inventory", delegatedQuery);
 }
 
 inline void requestRoutesMemory(App& app)
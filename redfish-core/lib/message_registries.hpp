@@ -7,18 +7,23 @@
 #include "async_resp.hpp"
 #include "error_messages.hpp"
 #include "http_request.hpp"
+#include "preserialized_json.hpp"
 #include "query.hpp"
 #include "registries.hpp"
 #include "registries/privilege_registry.hpp"
 
 #include <boost/beast/http/verb.hpp>
+#include <boost/container/flat_map.hpp>
 #include <boost/url/format.hpp>
+#include <nlohmann/json.hpp>
 
 #include <format>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <string>
+#include <string_view>
 #include <utility>
 
 namespace redfish
@@ -128,48 +133,25 @@ inline void requestRoutesMessageRegistryFile(App& app)
             handleMessageRoutesMessageRegistryFileGet, std::ref(app)));
 }
 
-inline void handleMessageRegistryGet(
-    crow::App& app, const crow::Request& req,
-    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
-    const std::string& registry, const std::string& registryMatch)
-
+inline void fillMessageRegistry(nlohmann::json& json,
+                                const std::string& registry,
+                                const registries::Header& header)
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
-    {
-        return;
-    }
-
-    std::optional<registries::RegistryEntryRef> registryEntry =
-        registries::getRegistryFromPrefix(registry);
-    if (!registryEntry)
-    {
-        messages::resourceNotFound(asyncResp->res, "MessageRegistryFile",
-                                   registry);
-        return;
-    }
-
-    const registries::Header& header = registryEntry->get().header;
-    if (registry != registryMatch)
-    {
-        messages::resourceNotFound(asyncResp->res, header.type, registryMatch);
-        return;
-    }
-
-    asyncResp->res.jsonValue["@Redfish.Copyright"] = header.copyright;
-    asyncResp->res.jsonValue["@odata.type"] = header.type;
-    asyncResp->res.jsonValue["Id"] =
+    json["@Redfish.Copyright"] = header.copyright;
+    json["@odata.type"] = header.type;
+    json["Id"] =
         std::format("{}.{}.{}.{}", header.registryPrefix, header.versionMajor,
                     header.versionMinor, header.versionPatch);
-    asyncResp->res.jsonValue["Name"] = header.name;
-    asyncResp->res.jsonValue["Language"] = header.language;
-    asyncResp->res.jsonValue["Description"] = header.description;
-    asyncResp->res.jsonValue["RegistryPrefix"] = header.registryPrefix;
-    asyncResp->res.jsonValue["RegistryVersion"] =
+    json["Name"] = header.name;
+    json["Language"] = header.language;
+    json["Description"] = header.description;
+    json["RegistryPrefix"] = header.registryPrefix;
+    json["RegistryVersion"] =
         std::format("{}.{}.{}", header.versionMajor, header.versionMinor,
                     header.versionPatch);
-    asyncResp->res.jsonValue["OwningEntity"] = header.owningEntity;
+    json["OwningEntity"] = header.owningEntity;
 
-    nlohmann::json& messageObj = asyncResp->res.jsonValue["Messages"];
+    nlohmann::json& messageObj = json["Messages"];
 
     // Go through the Message Registry and populate each Message
     const registries::MessageEntries registryEntries =
@@ -200,6 +182,60 @@ inline void handleMessageRegistryGet(
     }
 }
 
+// The registries are compiled in, so each is serialized on its first request
+// and reused after that
+inline const crow::PreserializedJson& getPreserializedRegistry(
+    const std::string& registry, const registries::Header& header)
+{
+    static boost::container::flat_map<std::string, crow::PreserializedJson,
+                                      std::less<>>
+        serialized;
+    auto it = serialized.find(registry);
+    if (it == serialized.end())
+    {
+        nlohmann::json json;
+        fillMessageRegistry(json, registry, header);
+        it = serialized.emplace(registry, crow::preserializeJson(json)).first;
+    }
+    return it->second;
+}
+
+inline void handleMessageRegistryGet(
+    crow::App& app, const crow::Request& req,
+    const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
+    const std::string& registry, const std::string& registryMatch)
+
+{
+    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    {
+        return;
+    }
+
+    std::optional<registries::RegistryEntryRef> registryEntry =
+        registries::getRegistryFromPrefix(registry);
+    if (!registryEntry)
+    {
+        messages::resourceNotFound(asyncResp->res, "MessageRegistryFile",
+                                   registry);
+        return;
+    }
+
+    const registries::Header& header = registryEntry->get().header;
+    if (registry != registryMatch)
+    {
+        messages::resourceNotFound(asyncResp->res, header.type, registryMatch);
+        return;
+    }
+
+    if (crow::canUsePreserializedJson(req))
+    {
+        crow::writePreserializedJson(
+            req, asyncResp->res, getPreserializedRegistry(registry, header));
+        return;
+    }
+    fillMessageRegistry(asyncResp->res.jsonValue, registry, header);
+}
+
 inline void requestRoutesMessageRegistry(App& app)
 {
     BMCWEB_ROUTE(app, "/redfish/v1/Registries/<str>/<str>/")
@@ -4,8 +4,12 @@
 
 #include "app.hpp"
 #include "async_resp.hpp"
+#include "http_body.hpp"
 #include "http_request.hpp"
+#include "http_response.hpp"
+#include "http_utility.hpp"
 #include "logging.hpp"
+#include "metadata_document.hpp"
 
 #include <tinyxml2.h>
 
@@ -13,13 +17,19 @@
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/verb.hpp>
 
+#include <algorithm>
+#include <array>
 #include <filesystem>
 #include <format>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 namespace redfish
 {
@@ -71,11 +81,113 @@ inline std::string getMetadataPieceForFile(
     return xml;
 }
 
+// Whether the CSDL files are the ones the $metadata document was generated
+// from at build time
+inline bool isPrecomputedSchemaSet(std::vector<std::string>& files)
+{
+    std::ranges::sort(files);
+    return std::ranges::equal(files, metadata::schemaFiles);
+}
+
+inline bool installedSchemasArePrecomputed(
+    const std::filesystem::path& schema)
+{
+    // Adding or removing a schema changes the directory's write time, so the
+    // directory is only listed again after that
+    static std::optional<std::filesystem::file_time_type> checkedWriteTime;
+    static bool precomputed = false;
+
+    std::error_code ec;
+    std::filesystem::file_time_type writeTime =
+        std::filesystem::last_write_time(schema, ec);
+    if (ec)
+    {
+        return false;
+    }
+    if (checkedWriteTime == writeTime)
+    {
+        return precomputed;
+    }
+    auto iter = std::filesystem::directory_iterator(schema, ec);
+    if (ec)
+    {
+        return false;
+    }
+    std::vector<std::string> files;
+    for (const auto& dirEntry : iter)
+    {
+        std::string path = dirEntry.path().filename();
+        if (std::string_view(path).ends_with("_v1.xml"))
+        {
+            files.emplace_back(std::move(path));
+        }
+    }
+    checkedWriteTime = writeTime;
+    precomputed = isPrecomputedSchemaSet(files);
+    return precomputed;
+}
+
+inline void writePrecomputedMetadata(const crow::Request& req,
+                                     crow::Response& res)
+{
+    res.addHeader(boost::beast::http::field::content_type, "application/xml");
+    res.addHeader(boost::beast::http::field::etag, metadata::etag);
+    if (req.getHeaderValue(boost::beast::http::field::if_none_match) ==
+        metadata::etag)
+    {
+        res.result(boost::beast::http::status::not_modified);
+        return;
+    }
+
+    using http_helpers::Encoding;
+    std::array<Encoding, 2> available{Encoding::ZSTD, Encoding::GZIP};
+    std::span<const Encoding> offered(available);
+#ifdef HAVE_ZSTD
+    bool zstdAvailable = !metadata::zstd.empty();
+#else
+    bool zstdAvailable = false;
+#endif
+    if (!zstdAvailable)
+    {
+        // Built without http-zstd, or no zstd compressor was available at
+        // build time
+        offered = offered.subspan(1);
+    }
+    Encoding encoding = http_helpers::getPreferredEncoding(
+        req.getHeaderValue(boost::beast::http::field::accept_encoding),
+        offered);
+    if (encoding == Encoding::ZSTD)
+    {
+        res.write(std::string(metadata::zstd));
+        res.addHeader(boost::beast::http::field::content_encoding, "zstd");
+        res.response.body().compressionType = bmcweb::CompressionType::Zstd;
+        res.response.body().clientCompressionType =
+            bmcweb::CompressionType::Zstd;
+        return;
+    }
+    if (encoding == Encoding::GZIP)
+    {
+        res.write(std::string(metadata::gzip));
+        res.addHeader(boost::beast::http::field::content_encoding, "gzip");
+        res.response.body().compressionType = bmcweb::CompressionType::Gzip;
+        return;
+    }
+    res.write(std::string(metadata::document));
+}
+
 inline void handleMetadataGet(
-    App& /*app*/, const crow::Request& /*req*/,
+    App& /*app*/, const crow::Request& req,
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp)
 {
     std::filesystem::path schema("/usr/share/www/redfish/v1/schema");
+    if (installedSchemasArePrecomputed(schema))
+    {
+        writePrecomputedMetadata(req, asyncResp->res);
+        return;
+    }
+    // Schemas were added or removed since the build, so build the document
+    // from the files
+    BMCWEB_LOG_DEBUG("Installed schemas differ from the build");
     std::error_code ec;
     auto iter = std::filesystem::directory_iterator(schema, ec);
     if (ec)
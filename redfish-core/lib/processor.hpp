@@ -20,6 +20,7 @@
 #include "utils/dbus_utils.hpp"
 #include "utils/json_utils.hpp"
 #include "utils/processor_utils.hpp"
+#include "utils/query_param.hpp"
 
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/verb.hpp>
@@ -1243,7 +1244,10 @@ inline void handleProcessorCollectionGet(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const std::string& systemName)
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    query_param::Query delegatedQuery;
+    if (!redfish::setUpRedfishRouteWithDelegation(
+            app, req, asyncResp, delegatedQuery,
+            collection_util::collectionCapabilities))
     {
         return;
     }
@@ -1277,7 +1281,7 @@ inline void handleProcessorCollectionGet(
         asyncResp,
         boost::urls::format("/redfish/v1/Systems/{}/Processors",
                             BMCWEB_REDFISH_SYSTEM_URI_NAME),
-        processorInterfaces, "/xyz/openbmc_project/inventory");
+        processorInterfaces, "/xyz/openbmc_project/inventory", delegatedQuery);
 }
 
 inline void requestRoutesProcessor(App& app)
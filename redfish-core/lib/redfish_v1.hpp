@@ -9,6 +9,7 @@
 #include "http_response.hpp"
 #include "human_sort.hpp"
 #include "logging.hpp"
+#include "preserialized_json.hpp"
 #include "query.hpp"
 #include "registries/privilege_registry.hpp"
 #include "str_utility.hpp"
@@ -16,13 +17,16 @@
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/verb.hpp>
+#include <boost/container/flat_map.hpp>
 #include <boost/url/format.hpp>
 
 #include <algorithm>
 #include <array>
 #include <filesystem>
 #include <format>
+#include <fstream>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <ranges>
 #include <string>
@@ -200,8 +204,50 @@ inline void jsonSchemaGet(App& app, const crow::Request& req,
     messages::resourceNotFound(asyncResp->res, "JsonSchemaFile", schema);
 }
 
+// Schema files are hashed and compressed on their first request.  Only the
+// compressed form is kept, since the files add up to megabytes.  A file is
+// read again if it changes.
+inline const crow::PreserializedJson* getPreserializedSchemaFile(
+    const std::filesystem::path& filepath)
+{
+    struct CachedFile
+    {
+        std::filesystem::file_time_type writeTime;
+        crow::PreserializedJson file;
+    };
+    static boost::container::flat_map<std::string, CachedFile, std::less<>>
+        cache;
+
+    std::error_code ec;
+    std::filesystem::file_time_type writeTime =
+        std::filesystem::last_write_time(filepath, ec);
+    if (ec)
+    {
+        return nullptr;
+    }
+    auto it = cache.find(filepath.native());
+    if (it != cache.end() && it->second.writeTime == writeTime)
+    {
+        return &it->second.file;
+    }
+
+    std::ifstream stream(filepath, std::ios::binary);
+    if (!stream)
+    {
+        return nullptr;
+    }
+    std::string text{std::istreambuf_iterator<char>(stream),
+                     std::istreambuf_iterator<char>()};
+    CachedFile& cached = cache[filepath.native()];
+    cached.writeTime = writeTime;
+    cached.file.etag =
+        std::format("\"{:08X}\"", std::hash<std::string>{}(text));
+    cached.file.zstd = crow::compressZstd(text);
+    return &cached.file;
+}
+
 inline void jsonSchemaGetFile(
-    const crow::Request& /*req*/,
+    const crow::Request& req,
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const std::string& schema, const std::string& schemaFile)
 {
@@ -228,6 +274,14 @@ inline void jsonSchemaGetFile(
         return;
     }
 
+    const crow::PreserializedJson* cached =
+        getPreserializedSchemaFile(filepath);
+    if (cached != nullptr &&
+        crow::writePreserializedJson(req, asyncResp->res, *cached))
+    {
+        return;
+    }
+
     crow::OpenCode ec = asyncResp->res.openFile(filepath);
     if (ec == crow::OpenCode::FileDoesNotExist)
     {
@@ -256,6 +256,7 @@ class SensorsAsyncResp
 };
 
 using InventoryItem = sensor_utils::InventoryItem;
+using InventoryItems = sensor_utils::InventoryItems;
 
 /**
  * @brief Get objects with connection necessary for sensors
@@ -783,98 +784,6 @@ inline void sortJSONResponse(
     }
 }
 
-/**
- * @brief Finds the inventory item with the specified object path.
- * @param inventoryItems D-Bus inventory items associated with sensors.
- * @param invItemObjPath D-Bus object path of inventory item.
- * @return Inventory item within vector, or nullptr if no match found.
- */
-inline InventoryItem* findInventoryItem(
-    const std::shared_ptr<std::vector<InventoryItem>>& inventoryItems,
-    const std::string& invItemObjPath)
-{
-    for (InventoryItem& inventoryItem : *inventoryItems)
-    {
-        if (inventoryItem.objectPath == invItemObjPath)
-        {
-            return &inventoryItem;
-        }
-    }
-    return nullptr;
-}
-
-/**
- * @brief Finds the inventory item associated with the specified sensor.
- * @param inventoryItems D-Bus inventory items associated with sensors.
- * @param sensorObjPath D-Bus object path of sensor.
- * @return Inventory item within vector, or nullptr if no match found.
- */
-inline InventoryItem* findInventoryItemForSensor(
-    const std::shared_ptr<std::vector<InventoryItem>>& inventoryItems,
-    const std::string& sensorObjPath)
-{
-    for (InventoryItem& inventoryItem : *inventoryItems)
-    {
-        if (inventoryItem.sensors.contains(sensorObjPath))
-        {
-            return &inventoryItem;
-        }
-    }
-    return nullptr;
-}
-
-/**
- * @brief Finds the inventory item associated with the specified led path.
- * @param inventoryItems D-Bus inventory items associated with sensors.
- * @param ledObjPath D-Bus object path of led.
- * @return Inventory item within vector, or nullptr if no match found.
- */
-inline InventoryItem* findInventoryItemForLed(
-    std::vector<InventoryItem>& inventoryItems, const std::string& ledObjPath)
-{
-    for (InventoryItem& inventoryItem : inventoryItems)
-    {
-        if (inventoryItem.ledObjectPath == ledObjPath)
-        {
-            return &inventoryItem;
-        }
-    }
-    return nullptr;
-}
-
-/**
- * @brief Adds inventory item and associated sensor to specified vector.
- *
- * Adds a new InventoryItem to the vector if necessary.  Searches for an
- * existing InventoryItem with the specified object path.  If not found, one is
- * added to the vector.
- *
- * Next, the specified sensor is added to the set of sensors associated with the
- * InventoryItem.
- *
- * @param inventoryItems D-Bus inventory items associated with sensors.
- * @param invItemObjPath D-Bus object path of inventory item.
- * @param sensorObjPath D-Bus object path of sensor
- */
-inline void addInventoryItem(
-    const std::shared_ptr<std::vector<InventoryItem>>& inventoryItems,
-    const std::string& invItemObjPath, const std::string& sensorObjPath)
-{
-    // Look for inventory item in vector
-    InventoryItem* inventoryItem =
-        findInventoryItem(inventoryItems, invItemObjPath);
-
-    // If inventory item doesn't exist in vector, add it
-    if (inventoryItem == nullptr)
-    {
-        inventoryItems->emplace_back(invItemObjPath);
-        inventoryItem = &(inventoryItems->back());
-    }
-
-    // Add sensor to set of sensors associated with inventory item
-    inventoryItem->sensors.emplace(sensorObjPath);
-}
-
 /**
  * @brief Stores D-Bus data in the specified inventory item.
  *
@@ -984,7 +893,7 @@ inline void storeInventoryItemData(
  *
  * Uses the specified connections (services) to obtain D-Bus data for inventory
  * items associated with sensors.  Stores the resulting data in the
- * inventoryItems vector.
+ * inventoryItems index.
  *
  * This data is later used to provide sensor property values in the JSON
  * response.
@@ -1012,7 +921,7 @@ inline void storeInventoryItemData(
 template <typename Callback>
 void getInventoryItemsData(
     const std::shared_ptr<SensorsAsyncResp>& sensorsAsyncResp,
-    const std::shared_ptr<std::vector<InventoryItem>>& inventoryItems,
+    const std::shared_ptr<InventoryItems>& inventoryItems,
     const std::shared_ptr<std::set<std::string>>& invConnections,
     Callback&& callback, size_t invConnectionsIndex = 0)
 {
@@ -1060,7 +969,7 @@ void getInventoryItemsData(
                     // If this object path is one of the specified inventory
                     // items
                     InventoryItem* inventoryItem =
-                        findInventoryItem(inventoryItems, objPath);
+                        inventoryItems->find(objPath);
                     if (inventoryItem != nullptr)
                     {
                         // Store inventory data in InventoryItem
@@ -1102,7 +1011,7 @@ void getInventoryItemsData(
 template <typename Callback>
 void getInventoryItemsConnections(
     const std::shared_ptr<SensorsAsyncResp>& sensorsAsyncResp,
-    const std::shared_ptr<std::vector<InventoryItem>>& inventoryItems,
+    const std::shared_ptr<InventoryItems>& inventoryItems,
     Callback&& callback)
 {
     BMCWEB_LOG_DEBUG("getInventoryItemsConnections enter");
@@ -1145,7 +1054,7 @@ void getInventoryItemsConnections(
             {
                 // Check if object path is one of the specified inventory items
                 const std::string& objPath = object.first;
-                if (findInventoryItem(inventoryItems, objPath) != nullptr)
+                if (inventoryItems->find(objPath) != nullptr)
                 {
                     // Store all connections to inventory item
                     for (const std::pair<std::string, std::vector<std::string>>&
@@ -1163,6 +1072,37 @@ void getInventoryItemsConnections(
     BMCWEB_LOG_DEBUG("getInventoryItemsConnections exit");
 }
 
+/**
+ * @brief Returns the first endpoint of an association object.
+ * @param interfaces Interfaces and properties of the association object.
+ * @return First endpoint, or nullptr if the object has no endpoints.
+ */
+inline const std::string* getFirstAssociationEndpoint(
+    const dbus::utility::DBusInterfacesMap& interfaces)
+{
+    for (const auto& [interface, values] : interfaces)
+    {
+        if (interface != "xyz.openbmc_project.Association")
+        {
+            continue;
+        }
+        for (const auto& [valueName, value] : values)
+        {
+            if (valueName != "endpoints")
+            {
+                continue;
+            }
+            const std::vector<std::string>* endpoints =
+                std::get_if<std::vector<std::string>>(&value);
+            if ((endpoints != nullptr) && !endpoints->empty())
+            {
+                return &endpoints->front();
+            }
+        }
+    }
+    return nullptr;
+}
+
 /**
  * @brief Gets associations from sensors to inventory items.
  *
@@ -1175,7 +1115,7 @@ void getInventoryItemsConnections(
  *
  * The callback must have the following signature:
  *   @code
- *   callback(std::shared_ptr<std::vector<InventoryItem>> inventoryItems)
+ *   callback(std::shared_ptr<InventoryItems> inventoryItems)
  *   @endcode
  *
  * @param sensorsAsyncResp Pointer to object holding response data.
@@ -1209,104 +1149,66 @@ void getInventoryItemAssociations(
                 return;
             }
 
-            // Create vector to hold list of inventory items
-            std::shared_ptr<std::vector<InventoryItem>> inventoryItems =
-                std::make_shared<std::vector<InventoryItem>>();
+            // Create index to hold list of inventory items
+            std::shared_ptr<InventoryItems> inventoryItems =
+                std::make_shared<InventoryItems>();
 
-            // Loop through returned object paths
-            std::string sensorAssocPath;
-            sensorAssocPath.reserve(128); // avoid memory allocations
+            // Loop through returned object paths.  Inventory associations for
+            // a sensor live at <sensor path>/inventory, so strip the suffix
+            // and look the sensor up rather than comparing every sensor name.
+            constexpr std::string_view inventorySuffix = "/inventory";
+            std::string sensorName;
+            sensorName.reserve(128); // avoid memory allocations
             for (const auto& objDictEntry : resp)
             {
                 const std::string& objPath =
                     static_cast<const std::string&>(objDictEntry.first);
+                std::string_view objPathView = objPath;
+                if (!objPathView.ends_with(inventorySuffix))
+                {
+                    continue;
+                }
+                objPathView.remove_suffix(inventorySuffix.size());
+                sensorName = objPathView;
 
                 // If path is inventory association for one of the specified
                 // sensors
-                for (const std::string& sensorName : *sensorNames)
+                if (!sensorNames->contains(sensorName))
                 {
-                    sensorAssocPath = sensorName;
-                    sensorAssocPath += "/inventory";
-                    if (objPath == sensorAssocPath)
-                    {
-                        // Get Association interface for object path
-                        for (const auto& [interface, values] :
-                             objDictEntry.second)
-                        {
-                            if (interface == "xyz.openbmc_project.Association")
-                            {
-                                for (const auto& [valueName, value] : values)
-                                {
-                                    if (valueName == "endpoints")
-                                    {
-                                        const std::vector<std::string>*
-                                            endpoints = std::get_if<
-                                                std::vector<std::string>>(
-                                                &value);
-                                        if ((endpoints != nullptr) &&
-                                            !endpoints->empty())
-                                        {
-                                            // Add inventory item to vector
-                                            const std::string& invItemPath =
-                                                endpoints->front();
-                                            addInventoryItem(inventoryItems,
-                                                             invItemPath,
-                                                             sensorName);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                        break;
-                    }
+                    continue;
+                }
+                const std::string* invItemPath =
+                    getFirstAssociationEndpoint(objDictEntry.second);
+                if (invItemPath != nullptr)
+                {
+                    // Add inventory item to index
+                    inventoryItems->add(*invItemPath, sensorName);
                 }
             }
 
             // Now loop through the returned object paths again, this time to
             // find the leds associated with the inventory items we just found
-            std::string inventoryAssocPath;
-            inventoryAssocPath.reserve(128); // avoid memory allocations
+            constexpr std::string_view ledsSuffix = "/leds";
             for (const auto& objDictEntry : resp)
             {
                 const std::string& objPath =
                     static_cast<const std::string&>(objDictEntry.first);
-
-                for (InventoryItem& inventoryItem : *inventoryItems)
+                std::string_view inventoryPath = objPath;
+                if (!inventoryPath.ends_with(ledsSuffix))
                 {
-                    inventoryAssocPath = inventoryItem.objectPath;
-                    inventoryAssocPath += "/leds";
-                    if (objPath == inventoryAssocPath)
-                    {
-                        for (const auto& [interface, values] :
-                             objDictEntry.second)
-                        {
-                            if (interface == "xyz.openbmc_project.Association")
-                            {
-                                for (const auto& [valueName, value] : values)
-                                {
-                                    if (valueName == "endpoints")
-                                    {
-                                        const std::vector<std::string>*
-                                            endpoints = std::get_if<
-                                                std::vector<std::string>>(
-                                                &value);
-                                        if ((endpoints != nullptr) &&
-                                            !endpoints->empty())
-                                        {
-                                            // Add inventory item to vector
-                                            // Store LED path in inventory item
-                                            const std::string& ledPath =
-                                                endpoints->front();
-                                            inventoryItem.ledObjectPath =
-                                                ledPath;
-                                        }
-                                    }
-                                }
-                            }
-                        }
-
-                        break;
-                    }
+                    continue;
+                }
+                inventoryPath.remove_suffix(ledsSuffix.size());
+                if (inventoryItems->find(inventoryPath) == nullptr)
+                {
+                    continue;
+                }
+                const std::string* ledPath =
+                    getFirstAssociationEndpoint(objDictEntry.second);
+                if (ledPath != nullptr)
+                {
+                    // Store LED path in inventory item
+                    inventoryItems->setLedObjectPath(inventoryPath, *ledPath);
                 }
             }
             callback(inventoryItems);
@@ -1321,7 +1223,7 @@ void getInventoryItemAssociations(
  *
  * Uses the specified connections (services) to obtain D-Bus data for inventory
  * item leds associated with sensors.  Stores the resulting data in the
- * inventoryItems vector.
+ * inventoryItems index.
  *
  * This data is later used to provide sensor property values in the JSON
  * response.
@@ -1348,7 +1250,7 @@ void getInventoryItemAssociations(
 template <typename Callback>
 void getInventoryLedData(
     const std::shared_ptr<SensorsAsyncResp>& sensorsAsyncResp,
-    const std::shared_ptr<std::vector<InventoryItem>>& inventoryItems,
+    const std::shared_ptr<InventoryItems>& inventoryItems,
     const std::shared_ptr<std::map<std::string, std::string>>& ledConnections,
     Callback&& callback, size_t ledConnectionsIndex = 0)
 {
@@ -1388,7 +1290,7 @@ void getInventoryLedData(
                 BMCWEB_LOG_DEBUG("Led state: {}", state);
                 // Find inventory item with this LED object path
                 InventoryItem* inventoryItem =
-                    findInventoryItemForLed(*inventoryItems, ledPath);
+                    inventoryItems->findForLed(ledPath);
                 if (inventoryItem != nullptr)
                 {
                     // Store LED state in InventoryItem
@@ -1453,7 +1355,7 @@ void getInventoryLedData(
 template <typename Callback>
 void getInventoryLeds(
     const std::shared_ptr<SensorsAsyncResp>& sensorsAsyncResp,
-    const std::shared_ptr<std::vector<InventoryItem>>& inventoryItems,
+    const std::shared_ptr<InventoryItems>& inventoryItems,
     Callback&& callback)
 {
     BMCWEB_LOG_DEBUG("getInventoryLeds enter");
@@ -1493,8 +1395,7 @@ void getInventoryLeds(
                 // Check if object path is LED for one of the specified
                 // inventory items
                 const std::string& ledPath = object.first;
-                if (findInventoryItemForLed(*inventoryItems, ledPath) !=
-                    nullptr)
+                if (inventoryItems->findForLed(ledPath) != nullptr)
                 {
                     // Add mapping from ledPath to connection
                     const std::string& connection =
@@ -1517,7 +1418,7 @@ void getInventoryLeds(
  *
  * Uses the specified connections (services) (currently assumes just one) to
  * obtain D-Bus data for Power Supply Attributes. Stores the resulting data in
- * the inventoryItems vector. Only stores data in Power Supply inventoryItems.
+ * the inventoryItems index. Only stores data in Power Supply inventoryItems.
  *
  * This data is later used to provide sensor property values in the JSON
  * response.
@@ -1527,7 +1428,7 @@ void getInventoryLeds(
  *
  * The callback must have the following signature:
  *   @code
- *   callback(std::shared_ptr<std::vector<InventoryItem>> inventoryItems)
+ *   callback(std::shared_ptr<InventoryItems> inventoryItems)
  *   @endcode
  *
  * @param sensorsAsyncResp Pointer to object holding response data.
@@ -1539,7 +1440,7 @@ void getInventoryLeds(
 template <typename Callback>
 void getPowerSupplyAttributesData(
     const std::shared_ptr<SensorsAsyncResp>& sensorsAsyncResp,
-    const std::shared_ptr<std::vector<InventoryItem>>& inventoryItems,
+    const std::shared_ptr<InventoryItems>& inventoryItems,
     const std::map<std::string, std::string>& psAttributesConnections,
     Callback&& callback)
 {
@@ -1614,7 +1515,7 @@ void getPowerSupplyAttributesData(
  *
  * The callback must have the following signature:
  *   @code
- *   callback(std::shared_ptr<std::vector<InventoryItem>> inventoryItems)
+ *   callback(std::shared_ptr<InventoryItems> inventoryItems)
  *   @endcode
  *
  * @param sensorsAsyncResp Pointer to object holding response data.
@@ -1624,7 +1525,7 @@ void getPowerSupplyAttributesData(
 template <typename Callback>
 void getPowerSupplyAttributes(
     const std::shared_ptr<SensorsAsyncResp>& sensorsAsyncResp,
-    const std::shared_ptr<std::vector<InventoryItem>>& inventoryItems,
+    const std::shared_ptr<InventoryItems>& inventoryItems,
     Callback&& callback)
 {
     BMCWEB_LOG_DEBUG("getPowerSupplyAttributes enter");
@@ -1712,7 +1613,7 @@ void getPowerSupplyAttributes(
  *
  * The callback must have the following signature:
  *   @code
- *   callback(std::shared_ptr<std::vector<InventoryItem>> inventoryItems)
+ *   callback(std::shared_ptr<InventoryItems> inventoryItems)
  *   @endcode
  *
  * @param sensorsAsyncResp Pointer to object holding response data.
@@ -1730,8 +1631,7 @@ inline void getInventoryItems(
     auto getInventoryItemAssociationsCb =
         // ast-grep-ignore: long-lambda
         [sensorsAsyncResp, callback = std::forward<Callback>(callback)](
-            const std::shared_ptr<std::vector<InventoryItem>>&
-                inventoryItems) mutable {
+            const std::shared_ptr<InventoryItems>& inventoryItems) mutable {
             BMCWEB_LOG_DEBUG("getInventoryItemAssociationsCb enter");
             auto getInventoryItemsConnectionsCb =
                 // ast-grep-ignore: long-lambda
@@ -1895,7 +1795,7 @@ inline void getSensorData(
     const std::shared_ptr<SensorsAsyncResp>& sensorsAsyncResp,
     const std::shared_ptr<std::set<std::string>>& sensorNames,
     const std::set<std::string>& connections,
-    const std::shared_ptr<std::vector<InventoryItem>>& inventoryItems)
+    const std::shared_ptr<InventoryItems>& inventoryItems)
 {
     BMCWEB_LOG_DEBUG("getSensorData enter");
     // Get managed objects from all services exposing sensors
@@ -1951,7 +1851,7 @@ inline void getSensorData(
 
                     // Find inventory item (if any) associated with sensor
                     InventoryItem* inventoryItem =
-                        findInventoryItemForSensor(inventoryItems, objPath);
+                        inventoryItems->findForSensor(objPath);
 
                     const std::string& sensorSchema =
                         sensorsAsyncResp->chassisSubNode;
@@ -2128,7 +2028,7 @@ inline void processSensorList(
         BMCWEB_LOG_DEBUG("getConnectionCb enter");
         auto getInventoryItemsCb =
             [sensorsAsyncResp, sensorNames, connections](
-                const std::shared_ptr<std::vector<InventoryItem>>&
+                const std::shared_ptr<InventoryItems>&
                     inventoryItems) mutable {
                 BMCWEB_LOG_DEBUG("getInventoryItemsCb enter");
                 // Get sensor data and store results in JSON
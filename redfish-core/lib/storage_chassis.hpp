@@ -10,6 +10,7 @@
 #include "generated/enums/protocol.hpp"
 #include "generated/enums/resource.hpp"
 #include "http_request.hpp"
+#include "human_sort.hpp"
 #include "query.hpp"
 #include "redfish_util.hpp"
 #include "registries/privilege_registry.hpp"
@@ -422,7 +423,7 @@ inline void afterChassisDriveCollectionSubtreeGet(
                     leafNames.push_back(drivePath.filename());
                 }
 
-                std::ranges::sort(leafNames, AlphanumLess<std::string>());
+                humanSort(leafNames);
 
                 for (const auto& leafName : leafNames)
                 {
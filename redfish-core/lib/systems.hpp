@@ -3132,8 +3132,14 @@ inline void processComputerSystemGet(
     asyncResp->res.jsonValue["SerialConsole"]["SSH"]["Port"] = 2200;
     asyncResp->res.jsonValue["SerialConsole"]["SSH"]["HotKeySequenceDisplay"] =
         "Press ~. to exit console";
-    getPortStatusAndPath(std::span{protocolToDBusForSystems},
-                         std::bind_front(afterPortRequest, asyncResp));
+    // Properties that are fetched from D-Bus are only fetched if $select keeps
+    // them
+    using query_param::isSelected;
+    if (isSelected(*asyncResp, {"SerialConsole"}))
+    {
+        getPortStatusAndPath(std::span{protocolToDBusForSystems},
+                             std::bind_front(afterPortRequest, asyncResp));
+    }
 
     if constexpr (BMCWEB_KVM)
     {
@@ -3145,64 +3151,111 @@ inline void processComputerSystemGet(
             nlohmann::json::array_t({"KVMIP"});
     }
 
-    if constexpr (BMCWEB_REDFISH_USE_HARDCODED_SYSTEM_LOCATION_INDICATOR)
+    if (isSelected(*asyncResp, {"LocationIndicatorActive"}))
     {
-        getSystemLocationIndicatorActive(asyncResp);
-    }
-    else
-    {
-        systems_utils::getValidSystemsPath(
-            asyncResp, systemName,
-            [asyncResp,
-             systemName](const std::optional<std::string>& validSystemsPath) {
-                if (validSystemsPath)
-                {
-                    getLocationIndicatorActive(asyncResp, *validSystemsPath);
-                }
-            });
+        if constexpr (BMCWEB_REDFISH_USE_HARDCODED_SYSTEM_LOCATION_INDICATOR)
+        {
+            getSystemLocationIndicatorActive(asyncResp);
+        }
+        else
+        {
+            systems_utils::getValidSystemsPath(
+                asyncResp, systemName,
+                [asyncResp, systemName](
+                    const std::optional<std::string>& validSystemsPath) {
+                    if (validSystemsPath)
+                    {
+                        getLocationIndicatorActive(asyncResp,
+                                                   *validSystemsPath);
+                    }
+                });
+        }
     }
 
     if constexpr (BMCWEB_REDFISH_ALLOW_DEPRECATED_INDICATORLED)
     {
-        getIndicatorLedState(asyncResp);
+        if (isSelected(*asyncResp, {"IndicatorLED"}))
+        {
+            getIndicatorLedState(asyncResp);
+        }
     }
 
     // Currently not supported on multi-host.
     if constexpr (!BMCWEB_EXPERIMENTAL_REDFISH_MULTI_COMPUTER_SYSTEM)
     {
-        getComputerSystem(asyncResp);
-        // Todo: chassis matching could be handled by patch
-        // https://gerrit.openbmc.org/c/openbmc/bmcweb/+/60793
-        getMainChassisId(
-            asyncResp, [](const std::string& chassisId,
-                          const std::shared_ptr<bmcweb::AsyncResp>& aRsp) {
-                nlohmann::json::array_t chassisArray;
-                nlohmann::json& chassis = chassisArray.emplace_back();
-                chassis["@odata.id"] =
-                    boost::urls::format("/redfish/v1/Chassis/{}", chassisId);
-                aRsp->res.jsonValue["Links"]["Chassis"] =
-                    std::move(chassisArray);
-            });
+        if (isSelected(*asyncResp,
+                       {"ProcessorSummary", "MemorySummary", "UUID",
+                        "Manufacturer", "Model", "PartNumber", "SerialNumber",
+                        "SubModel", "AssetTag", "BiosVersion"}))
+        {
+            getComputerSystem(asyncResp);
+        }
+        if (isSelected(*asyncResp, {"Links"}))
+        {
+            // Todo: chassis matching could be handled by patch
+            // https://gerrit.openbmc.org/c/openbmc/bmcweb/+/60793
+            getMainChassisId(
+                asyncResp, [](const std::string& chassisId,
+                              const std::shared_ptr<bmcweb::AsyncResp>& aRsp) {
+                    nlohmann::json::array_t chassisArray;
+                    nlohmann::json& chassis = chassisArray.emplace_back();
+                    chassis["@odata.id"] = boost::urls::format(
+                        "/redfish/v1/Chassis/{}", chassisId);
+                    aRsp->res.jsonValue["Links"]["Chassis"] =
+                        std::move(chassisArray);
+                });
+        }
 
-        pcie_util::getPCIeDeviceList(
-            asyncResp, nlohmann::json::json_pointer("/PCIeDevices"));
-    }
-    getHostState(asyncResp, computerSystemIndex);
-    getBootProperties(asyncResp, computerSystemIndex);
-    getBootProgress(asyncResp, computerSystemIndex);
-    getBootProgressLastStateTime(asyncResp, computerSystemIndex);
-    getHostWatchdogTimer(asyncResp);
-    getPowerRestorePolicy(asyncResp, computerSystemIndex);
-    getStopBootOnFault(asyncResp);
-    getAutomaticRetryPolicy(asyncResp, computerSystemIndex);
-    getLastResetTime(asyncResp, computerSystemIndex);
+        if (isSelected(*asyncResp, {"PCIeDevices", "PCIeDevices@odata.count"}))
+        {
+            pcie_util::getPCIeDeviceList(
+                asyncResp, nlohmann::json::json_pointer("/PCIeDevices"));
+        }
+    }
+    if (isSelected(*asyncResp, {"PowerState", "Status"}))
+    {
+        getHostState(asyncResp, computerSystemIndex);
+    }
+    if (isSelected(*asyncResp, {"Boot"}))
+    {
+        getBootProperties(asyncResp, computerSystemIndex);
+        getStopBootOnFault(asyncResp);
+        getAutomaticRetryPolicy(asyncResp, computerSystemIndex);
+        getTrustedModuleRequiredToBoot(asyncResp, computerSystemIndex);
+    }
+    if (isSelected(*asyncResp, {"BootProgress"}))
+    {
+        getBootProgress(asyncResp, computerSystemIndex);
+        getBootProgressLastStateTime(asyncResp, computerSystemIndex);
+    }
+    if (isSelected(*asyncResp, {"HostWatchdogTimer"}))
+    {
+        getHostWatchdogTimer(asyncResp);
+    }
+    if (isSelected(*asyncResp, {"PowerRestorePolicy"}))
+    {
+        getPowerRestorePolicy(asyncResp, computerSystemIndex);
+    }
+    if (isSelected(*asyncResp, {"LastResetTime"}))
+    {
+        getLastResetTime(asyncResp, computerSystemIndex);
+    }
     if constexpr (BMCWEB_REDFISH_PROVISIONING_FEATURE)
     {
-        getProvisioningStatus(asyncResp);
+        if (isSelected(*asyncResp, {"Oem"}))
+        {
+            getProvisioningStatus(asyncResp);
+        }
+    }
+    if (isSelected(*asyncResp,
+                   {"PowerMode", "PowerMode@Redfish.AllowableValues"}))
+    {
+        getPowerMode(asyncResp);
+    }
+    if (isSelected(*asyncResp, {"IdlePowerSaver"}))
+    {
+        getIdlePowerSaver(asyncResp);
     }
-    getTrustedModuleRequiredToBoot(asyncResp, computerSystemIndex);
-    getPowerMode(asyncResp);
-    getIdlePowerSaver(asyncResp);
 }
 
 inline void handleComputerSystemGet(
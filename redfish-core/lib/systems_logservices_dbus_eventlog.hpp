@@ -12,6 +12,7 @@
 #include "query.hpp"
 #include "registries/privilege_registry.hpp"
 #include "utils/eventlog_utils.hpp"
+#include "utils/query_param.hpp"
 
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/status.hpp>
@@ -33,7 +34,12 @@ inline void handleSystemsDBusEventLogEntryCollection(
     const std::shared_ptr<bmcweb::AsyncResp>& asyncResp,
     const std::string& systemName)
 {
-    if (!redfish::setUpRedfishRoute(app, req, asyncResp))
+    query_param::QueryCapabilities capabilities = {
+        .canPushDownFilter = true,
+    };
+    query_param::Query delegatedQuery;
+    if (!redfish::setUpRedfishRouteWithDelegation(app, req, asyncResp,
+                                                  delegatedQuery, capabilities))
     {
         return;
     }
@@ -51,7 +57,8 @@ inline void handleSystemsDBusEventLogEntryCollection(
         return;
     }
     eventlog_utils::dBusEventLogEntryCollection(
-        asyncResp, eventlog_utils::LogServiceParentCollection::Systems);
+        asyncResp, delegatedQuery,
+        eventlog_utils::LogServiceParentCollection::Systems);
 }
 
 inline void handleSystemsDBusEventLogEntryGet(
@@ -37,6 +37,7 @@ inline void handleSystemsLogServiceEventLogLogEntryCollection(
     query_param::QueryCapabilities capabilities = {
         .canDelegateTop = true,
         .canDelegateSkip = true,
+        .canPushDownFilter = true,
     };
     query_param::Query delegatedQuery;
     if (!redfish::setUpRedfishRouteWithDelegation(app, req, asyncResp,
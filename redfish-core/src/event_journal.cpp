@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "event_journal.hpp"
+
+#include "logging.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace redfish
+{
+
+namespace
+{
+
+// Records are stored as "<id> <json>"
+bool parseRecord(std::string_view line, uint64_t& id, std::string_view& message)
+{
+    size_t space = line.find(' ');
+    if (space == std::string_view::npos)
+    {
+        return false;
+    }
+    const char* end = line.data() + space;
+    auto [ptr, ec] = std::from_chars(line.data(), end, id);
+    if (ec != std::errc() || ptr != end)
+    {
+        return false;
+    }
+    message = line.substr(space + 1);
+    return true;
+}
+
+} // namespace
+
+EventJournal::EventJournal(const std::filesystem::path& dir,
+                           uint64_t maxSize) : maxSegmentSize(maxSize / 2)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec)
+    {
+        BMCWEB_LOG_ERROR("Can't create event journal directory {}: {}",
+                         dir.string(), ec.message());
+    }
+    segments[0].path = dir / "events.0";
+    segments[1].path = dir / "events.1";
+    for (Segment& segment : segments)
+    {
+        load(segment);
+    }
+}
+
+void EventJournal::load(Segment& segment)
+{
+    std::ifstream journalStream(segment.path, std::ios::binary);
+    if (!journalStream.good())
+    {
+        return;
+    }
+
+    std::string line;
+    uint64_t offset = 0;
+    while (std::getline(journalStream, line))
+    {
+        uint64_t id = 0;
+        std::string_view message;
+        // A record without a trailing newline was only partially written
+        if (journalStream.eof() || !parseRecord(line, id, message))
+        {
+            BMCWEB_LOG_WARNING("Dropping corrupt event journal record at {}",
+                               offset);
+            break;
+        }
+        if (!segment.records.empty() && id <= segment.records.back().id)
+        {
+            BMCWEB_LOG_WARNING("Event journal id {} out of order", id);
+            break;
+        }
+        segment.records.emplace_back(Record{id, offset});
+        offset += line.size() + 1;
+    }
+    journalStream.close();
+
+    segment.size = offset;
+    std::error_code ec;
+    if (std::filesystem::file_size(segment.path, ec) != offset && !ec)
+    {
+        std::filesystem::resize_file(segment.path, offset, ec);
+        if (ec)
+        {
+            BMCWEB_LOG_ERROR("Failed to truncate event journal {}: {}",
+                             segment.path.string(), ec.message());
+        }
+    }
+}
+
+uint64_t EventJournal::lastEventId() const
+{
+    for (const Segment& segment : segments | std::views::reverse)
+    {
+        if (!segment.records.empty())
+        {
+            return segment.records.back().id;
+        }
+    }
+    return 0;
+}
+
+bool EventJournal::rotate()
+{
+    std::error_code ec;
+    std::filesystem::remove(segments[0].path, ec);
+    std::filesystem::rename(segments[1].path, segments[0].path, ec);
+    if (ec)
+    {
+        BMCWEB_LOG_ERROR("Failed to rotate event journal: {}", ec.message());
+        return false;
+    }
+    segments[0].records = std::move(segments[1].records);
+    segments[0].size = segments[1].size;
+    segments[1].records.clear();
+    segments[1].size = 0;
+    return true;
+}
+
+bool EventJournal::append(uint64_t eventId, std::string_view message)
+{
+    if (message.find('\n') != std::string_view::npos)
+    {
+        BMCWEB_LOG_ERROR("Event {} can't be journaled, contains newline",
+                         eventId);
+        return false;
+    }
+    if (eventId <= lastEventId())
+    {
+        BMCWEB_LOG_ERROR("Event {} is older than the event journal", eventId);
+        return false;
+    }
+
+    std::string line = std::format("{} {}\n", eventId, message);
+    Segment& active = segments[1];
+    if (!active.records.empty() && active.size + line.size() > maxSegmentSize)
+    {
+        if (!rotate())
+        {
+            return false;
+        }
+    }
+
+    std::ofstream journalStream(active.path, std::ios::binary | std::ios::app);
+    journalStream.write(line.data(), static_cast<std::streamsize>(line.size()));
+    journalStream.flush();
+    if (!journalStream.good())
+    {
+        BMCWEB_LOG_ERROR("Failed to write event journal {}",
+                         active.path.string());
+        return false;
+    }
+    active.records.emplace_back(Record{eventId, active.size});
+    active.size += line.size();
+    return true;
+}
+
+void EventJournal::replaySegment(
+    const Segment& segment, uint64_t offset,
+    const std::function<void(uint64_t, std::string_view)>& callback)
+{
+    if (offset >= segment.size)
+    {
+        return;
+    }
+    std::ifstream journalStream(segment.path, std::ios::binary);
+    if (!journalStream.good())
+    {
+        BMCWEB_LOG_ERROR("Failed to open event journal {}",
+                         segment.path.string());
+        return;
+    }
+    journalStream.seekg(static_cast<std::streamoff>(offset));
+
+    std::string line;
+    while (offset < segment.size && std::getline(journalStream, line))
+    {
+        offset += line.size() + 1;
+        uint64_t id = 0;
+        std::string_view message;
+        if (!parseRecord(line, id, message))
+        {
+            continue;
+        }
+        callback(id, message);
+    }
+}
+
+bool EventJournal::replayAfter(
+    uint64_t eventId,
+    const std::function<void(uint64_t, std::string_view)>& callback) const
+{
+    for (size_t index = 0; index < segments.size(); index++)
+    {
+        const std::vector<Record>& records = segments[index].records;
+        auto record = std::ranges::lower_bound(records, eventId, std::less{},
+                                               &Record::id);
+        if (record == records.end() || record->id != eventId)
+        {
+            continue;
+        }
+        // Skip the last event the client already has
+        record++;
+        if (record != records.end())
+        {
+            replaySegment(segments[index], record->offset, callback);
+        }
+        for (size_t newer = index + 1; newer < segments.size(); newer++)
+        {
+            replaySegment(segments[newer], 0, callback);
+        }
+        return true;
+    }
+    return false;
+}
+
+} // namespace redfish
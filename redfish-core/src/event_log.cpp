@@ -3,6 +3,7 @@
 // SPDX-FileCopyrightText: Copyright 2020 Intel Corporation
 #include "event_log.hpp"
 
+#include "event_logs_object_type.hpp"
 #include "logging.hpp"
 #include "registries.hpp"
 #include "str_utility.hpp"
@@ -184,6 +185,93 @@ int formatEventLogEntry(uint64_t eventId, const std::string& logEntryID,
     return 0;
 }
 
+std::vector<nlohmann::json> formatEventLogEntries(
+    std::span<const EventLogObjectsType> eventRecords)
+{
+    std::vector<nlohmann::json> logEntries;
+    logEntries.reserve(eventRecords.size());
+    for (const EventLogObjectsType& logEntry : eventRecords)
+    {
+        BMCWEB_LOG_DEBUG("Processing logEntry: {}, {} '{}'", logEntry.id,
+                         logEntry.timestamp, logEntry.messageId);
+        std::vector<std::string_view> messageArgsView(
+            logEntry.messageArgs.begin(), logEntry.messageArgs.end());
+
+        nlohmann::json::object_t bmcLogEntry;
+        if (formatEventLogEntry(0, logEntry.id, logEntry.messageId,
+                                messageArgsView, logEntry.timestamp, "",
+                                bmcLogEntry) != 0)
+        {
+            BMCWEB_LOG_WARNING("Read eventLog entry failed");
+            continue;
+        }
+        logEntries.emplace_back(std::move(bmcLogEntry));
+    }
+    return logEntries;
+}
+
+nlohmann::json::object_t formatEventLogPayload(
+    uint64_t& eventId, std::span<const nlohmann::json> logEntries,
+    std::span<const size_t> entryIndexes, const std::string& customText)
+{
+    nlohmann::json::array_t logEntryArray;
+    logEntryArray.reserve(entryIndexes.size());
+    for (size_t index : entryIndexes)
+    {
+        if (index >= logEntries.size())
+        {
+            continue;
+        }
+        nlohmann::json& bmcLogEntry =
+            logEntryArray.emplace_back(logEntries[index]);
+        bmcLogEntry["EventId"] = std::to_string(eventId);
+        bmcLogEntry["Context"] = customText;
+        eventId++;
+    }
+
+    nlohmann::json::object_t msg;
+    msg["@odata.type"] = "#Event.v1_4_0.Event";
+    msg["Id"] = std::to_string(eventId);
+    msg["Name"] = "Event Log";
+    msg["Events"] = std::move(logEntryArray);
+    return msg;
+}
+
+nlohmann::json::object_t mergeEventPayloads(
+    std::span<nlohmann::json::object_t> payloads, uint64_t eventId)
+{
+    nlohmann::json::array_t logEntryArray;
+    for (nlohmann::json::object_t& payload : payloads)
+    {
+        auto events = payload.find("Events");
+        if (events == payload.end())
+        {
+            continue;
+        }
+        nlohmann::json::array_t* eventsArr =
+            events->second.get_ptr<nlohmann::json::array_t*>();
+        if (eventsArr == nullptr)
+        {
+            continue;
+        }
+        for (nlohmann::json& event : *eventsArr)
+        {
+            if (event.is_object() && event.contains("MemberId"))
+            {
+                event["MemberId"] = std::to_string(logEntryArray.size());
+            }
+            logEntryArray.emplace_back(std::move(event));
+        }
+    }
+
+    nlohmann::json::object_t msg;
+    msg["@odata.type"] = "#Event.v1_4_0.Event";
+    msg["Id"] = std::to_string(eventId);
+    msg["Name"] = "Event Log";
+    msg["Events"] = std::move(logEntryArray);
+    return msg;
+}
+
 } // namespace event_log
 
 } // namespace redfish
@@ -8,6 +8,7 @@
 #include "utils/json_utils.hpp"
 #include "utils/time_utils.hpp"
 
+#include <boost/container/small_vector.hpp>
 #include <nlohmann/json.hpp>
 
 #include <algorithm>
@@ -19,7 +20,9 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <variant>
+#include <vector>
 
 namespace redfish
 {
@@ -76,6 +79,9 @@ struct DateTimeString
          "ValidNotAfter",
          "ValidNotBefore"});
 
+    explicit DateTimeString(time_utils::usSinceEpoch usValue) : value(usValue)
+    {}
+
     explicit DateTimeString(std::string_view strvalue)
     {
         std::optional<time_utils::usSinceEpoch> out =
@@ -98,114 +104,6 @@ struct DateTimeString
     }
 };
 
-// Class that can convert an arbitrary AST type into a structured value
-// Pulling from the json pointer when required
-struct ValueVisitor
-{
-    using result_type = std::variant<std::monostate, double, int64_t,
-                                     std::string, DateTimeString>;
-    const nlohmann::json& body;
-    result_type operator()(double n);
-    result_type operator()(int64_t x);
-    result_type operator()(const filter_ast::UnquotedString& x);
-    result_type operator()(const filter_ast::QuotedString& x);
-};
-
-ValueVisitor::result_type ValueVisitor::operator()(double n)
-{
-    return {n};
-}
-
-ValueVisitor::result_type ValueVisitor::operator()(int64_t x)
-{
-    return {x};
-}
-
-ValueVisitor::result_type ValueVisitor::operator()(
-    const filter_ast::QuotedString& x)
-{
-    return {x};
-}
-
-ValueVisitor::result_type ValueVisitor::operator()(
-    const filter_ast::UnquotedString& x)
-{
-    // find key including paths with / in them
-    const nlohmann::json* it =
-        json_util::findNestedKey(static_cast<std::string_view>(x), body);
-    if (it == nullptr)
-    {
-        BMCWEB_LOG_ERROR("Key {} doesn't exist in output, cannot filter",
-                         static_cast<std::string>(x));
-        BMCWEB_LOG_DEBUG(
-            "Output {}",
-            body.dump(-1, ' ', true, nlohmann::json::error_handler_t::replace));
-        return {};
-    }
-
-    const nlohmann::json& entry = *it;
-    const double* dValue = entry.get_ptr<const double*>();
-    if (dValue != nullptr)
-    {
-        return {*dValue};
-    }
-    const int64_t* iValue = entry.get_ptr<const int64_t*>();
-    if (iValue != nullptr)
-    {
-        return {*iValue};
-    }
-    const uint64_t* uValue = entry.get_ptr<const uint64_t*>();
-    if (uValue != nullptr)
-    {
-        // For now all values are coerced to signed
-        if (*uValue > std::numeric_limits<int64_t>::max())
-        {
-            BMCWEB_LOG_WARNING("Parsed uint is outside limits");
-            return {};
-        }
-        return {static_cast<int64_t>(*uValue)};
-    }
-    const std::string* strValue = entry.get_ptr<const std::string*>();
-    if (strValue != nullptr)
-    {
-        if (DateTimeString::isDateTimeKey(x))
-        {
-            return DateTimeString(*strValue);
-        }
-        return {*strValue};
-    }
-
-    BMCWEB_LOG_ERROR(
-        "Type for key {} was {} which does not have a comparison operator",
-        static_cast<std::string>(x), static_cast<int>(entry.type()));
-    return {};
-}
-
-struct ApplyFilter
-{
-    const nlohmann::json& body;
-    const filter_ast::LogicalAnd& filter;
-    using result_type = bool;
-    bool operator()(const filter_ast::LogicalNot& x);
-    bool operator()(const filter_ast::LogicalOr& x);
-    bool operator()(const filter_ast::LogicalAnd& x);
-    bool operator()(const filter_ast::Comparison& x);
-    bool operator()(const filter_ast::BooleanOp& x);
-
-  public:
-    bool matches();
-};
-
-bool ApplyFilter::operator()(const filter_ast::LogicalNot& x)
-{
-    bool subValue = (*this)(x.operand);
-    if (x.isLogicalNot)
-    {
-        return !subValue;
-    }
-    return subValue;
-}
-
 // Helper function to reduce the number of permutations of a single comparison
 // For all possible types.
 bool doDoubleComparison(double left, filter_ast::ComparisonOpEnum comparator,
@@ -291,14 +189,117 @@ bool doStringComparison(std::string_view left,
     }
 }
 
-bool ApplyFilter::operator()(const filter_ast::Comparison& x)
+using Value = std::variant<std::monostate, double, int64_t, std::string_view,
+                           DateTimeString>;
+
+// Converts a property of the member into a structured value.  Sets |missing|
+// when the member doesn't have it.
+Value getKeyValue(const filter_program::Key& key, const nlohmann::json& body,
+                  bool& missing)
 {
-    ValueVisitor numeric(body);
-    std::variant<std::monostate, double, int64_t, std::string, DateTimeString>
-        left = boost::apply_visitor(numeric, x.left);
-    std::variant<std::monostate, double, int64_t, std::string, DateTimeString>
-        right = boost::apply_visitor(numeric, x.right);
+    // find key including paths with / in them
+    const nlohmann::json* it = json_util::findNestedKey(key.name, body);
+    if (it == nullptr)
+    {
+        missing = true;
+        return {};
+    }
 
+    const nlohmann::json& entry = *it;
+    const double* dValue = entry.get_ptr<const double*>();
+    if (dValue != nullptr)
+    {
+        return {*dValue};
+    }
+    const int64_t* iValue = entry.get_ptr<const int64_t*>();
+    if (iValue != nullptr)
+    {
+        return {*iValue};
+    }
+    const uint64_t* uValue = entry.get_ptr<const uint64_t*>();
+    if (uValue != nullptr)
+    {
+        // For now all values are coerced to signed
+        if (*uValue > std::numeric_limits<int64_t>::max())
+        {
+            BMCWEB_LOG_WARNING("Parsed uint is outside limits");
+            return {};
+        }
+        return {static_cast<int64_t>(*uValue)};
+    }
+    const std::string* strValue = entry.get_ptr<const std::string*>();
+    if (strValue != nullptr)
+    {
+        if (key.isDateTime)
+        {
+            return DateTimeString(*strValue);
+        }
+        return {std::string_view(*strValue)};
+    }
+
+    BMCWEB_LOG_ERROR(
+        "Type for key {} was {} which does not have a comparison operator",
+        key.name, static_cast<int>(entry.type()));
+    return {};
+}
+
+// Converts an operand into a structured value, pulling from the member when
+// it's a property
+struct ValueVisitor
+{
+    const nlohmann::json& body;
+    // Whether body only has some of the member's properties
+    bool partial;
+    bool& missing;
+
+    Value operator()(double n) const
+    {
+        return {n};
+    }
+
+    Value operator()(int64_t x) const
+    {
+        return {x};
+    }
+
+    Value operator()(const filter_program::Literal& x) const
+    {
+        return {std::string_view(x.value)};
+    }
+
+    Value operator()(const filter_program::Key& x) const
+    {
+        Value value = getKeyValue(x, body, missing);
+        if (missing && !partial)
+        {
+            BMCWEB_LOG_ERROR("Key {} doesn't exist in output, cannot filter",
+                             x.name);
+            BMCWEB_LOG_DEBUG(
+                "Output {}",
+                body.dump(-1, ' ', true,
+                          nlohmann::json::error_handler_t::replace));
+        }
+        return value;
+    }
+};
+
+// Converts a string compared against a date into a date, using the value
+// parsed at compile time when it's a literal
+DateTimeString toDateTime(const filter_program::Operand& operand,
+                          std::string_view str)
+{
+    const filter_program::Literal* literal =
+        std::get_if<filter_program::Literal>(&operand);
+    if (literal != nullptr && literal->dateUs)
+    {
+        return DateTimeString(time_utils::usSinceEpoch(*literal->dateUs));
+    }
+    return DateTimeString(str);
+}
+
+bool compareValues(const filter_program::Comparison& x, Value& left,
+                   Value& right)
+{
     // Numeric comparisons
     const double* lDoubleValue = std::get_if<double>(&left);
     const double* rDoubleValue = std::get_if<double>(&right);
@@ -336,8 +337,8 @@ bool ApplyFilter::operator()(const filter_ast::Comparison& x)
     }
 
     // String comparisons
-    const std::string* lStrValue = std::get_if<std::string>(&left);
-    const std::string* rStrValue = std::get_if<std::string>(&right);
+    const std::string_view* lStrValue = std::get_if<std::string_view>(&left);
+    const std::string_view* rStrValue = std::get_if<std::string_view>(&right);
 
     const DateTimeString* lDateValue = std::get_if<DateTimeString>(&left);
     const DateTimeString* rDateValue = std::get_if<DateTimeString>(&right);
@@ -346,11 +347,13 @@ bool ApplyFilter::operator()(const filter_ast::Comparison& x)
     // datestring from the string
     if (lDateValue != nullptr && rStrValue != nullptr)
     {
-        rDateValue = &right.emplace<DateTimeString>(std::string(*rStrValue));
+        rDateValue = &right.emplace<DateTimeString>(
+            toDateTime(x.right, *rStrValue));
     }
     if (lStrValue != nullptr && rDateValue != nullptr)
     {
-        lDateValue = &left.emplace<DateTimeString>(std::string(*lStrValue));
+        lDateValue =
+            &left.emplace<DateTimeString>(toDateTime(x.left, *lStrValue));
     }
 
     if (lDateValue != nullptr && rDateValue != nullptr)
@@ -370,43 +373,200 @@ bool ApplyFilter::operator()(const filter_ast::Comparison& x)
     return true;
 }
 
-bool ApplyFilter::operator()(const filter_ast::BooleanOp& x)
+// Three valued logic, so that comparisons on properties that aren't known
+// yet don't decide the result
+enum class Truth : uint8_t
 {
-    return boost::apply_visitor(*this, x);
+    False,
+    True,
+    Unknown,
+};
+
+Truth toTruth(bool value)
+{
+    return value ? Truth::True : Truth::False;
 }
 
-bool ApplyFilter::operator()(const filter_ast::LogicalOr& x)
+// Converts an operand from the AST
+filter_program::Operand compileOperand(const filter_ast::Argument& argument)
 {
-    bool value = (*this)(x.first);
-    for (const filter_ast::LogicalNot& bOp : x.rest)
+    struct Visitor
     {
-        value = value || (*this)(bOp);
+        using result_type = filter_program::Operand;
+        result_type operator()(double n) const
+        {
+            return {n};
+        }
+        result_type operator()(int64_t x) const
+        {
+            return {x};
+        }
+        result_type operator()(const filter_ast::UnquotedString& x) const
+        {
+            return {filter_program::Key{x, DateTimeString::isDateTimeKey(x)}};
+        }
+        result_type operator()(const filter_ast::QuotedString& x) const
+        {
+            filter_program::Literal literal{x, std::nullopt};
+            std::optional<time_utils::usSinceEpoch> date =
+                time_utils::dateStringToEpoch(x);
+            if (date)
+            {
+                literal.dateUs = date->count();
+            }
+            return {std::move(literal)};
+        }
+    };
+    return boost::apply_visitor(Visitor{}, argument);
+}
+
+// Flattens the AST into postfix instructions
+struct Compiler
+{
+    std::vector<filter_program::Comparison>& comparisons;
+    std::vector<filter_program::Instruction>& program;
+
+    using result_type = void;
+
+    void operator()(const filter_ast::Comparison& x)
+    {
+        program.emplace_back(filter_program::OpCode::Compare,
+                             comparisons.size());
+        comparisons.emplace_back(compileOperand(x.left), x.token,
+                                 compileOperand(x.right));
     }
-    return value;
+
+    void operator()(const filter_ast::BooleanOp& x)
+    {
+        boost::apply_visitor(*this, x);
+    }
+
+    void operator()(const filter_ast::LogicalNot& x)
+    {
+        (*this)(x.operand);
+        if (x.isLogicalNot)
+        {
+            program.emplace_back(filter_program::OpCode::Not, 0);
+        }
+    }
+
+    void operator()(const filter_ast::LogicalOr& x)
+    {
+        (*this)(x.first);
+        for (const filter_ast::LogicalNot& bOp : x.rest)
+        {
+            (*this)(bOp);
+        }
+        if (!x.rest.empty())
+        {
+            program.emplace_back(filter_program::OpCode::Or,
+                                 x.rest.size() + 1);
+        }
+    }
+
+    void operator()(const filter_ast::LogicalAnd& x)
+    {
+        (*this)(x.first);
+        for (const filter_ast::LogicalOr& bOp : x.rest)
+        {
+            (*this)(bOp);
+        }
+        if (!x.rest.empty())
+        {
+            program.emplace_back(filter_program::OpCode::And,
+                                 x.rest.size() + 1);
+        }
+    }
+};
+
+} // namespace
+
+CompiledFilter::CompiledFilter(const filter_ast::LogicalAnd& filter)
+{
+    Compiler compiler{comparisons, program};
+    compiler(filter);
 }
 
-bool ApplyFilter::operator()(const filter_ast::LogicalAnd& x)
+bool CompiledFilter::run(const nlohmann::json& member, bool partial) const
 {
-    bool value = (*this)(x.first);
-    for (const filter_ast::LogicalOr& bOp : x.rest)
+    boost::container::small_vector<Truth, 16> stack;
+    for (const filter_program::Instruction& instruction : program)
     {
-        value = value && (*this)(bOp);
+        switch (instruction.op)
+        {
+            case filter_program::OpCode::Compare:
+            {
+                const filter_program::Comparison& comparison =
+                    comparisons[instruction.arg];
+                bool missing = false;
+                ValueVisitor visitor{member, partial, missing};
+                Value left = std::visit(visitor, comparison.left);
+                Value right = std::visit(visitor, comparison.right);
+                if (missing && partial)
+                {
+                    stack.push_back(Truth::Unknown);
+                    break;
+                }
+                stack.push_back(
+                    toTruth(compareValues(comparison, left, right)));
+            }
+            break;
+            case filter_program::OpCode::Not:
+                if (stack.back() != Truth::Unknown)
+                {
+                    stack.back() = toTruth(stack.back() == Truth::False);
+                }
+                break;
+            case filter_program::OpCode::And:
+            case filter_program::OpCode::Or:
+            {
+                // And is decided by any False, Or by any True
+                Truth decides = instruction.op == filter_program::OpCode::And
+                                    ? Truth::False
+                                    : Truth::True;
+                Truth value = instruction.op == filter_program::OpCode::And
+                                  ? Truth::True
+                                  : Truth::False;
+                for (size_t i = stack.size() - instruction.arg;
+                     i < stack.size(); i++)
+                {
+                    if (stack[i] == decides)
+                    {
+                        value = decides;
+                        break;
+                    }
+                    if (stack[i] == Truth::Unknown)
+                    {
+                        value = Truth::Unknown;
+                    }
+                }
+                stack.resize(stack.size() - instruction.arg + 1);
+                stack.back() = value;
+            }
+            break;
+        }
     }
-    return value;
+    if (stack.size() != 1)
+    {
+        BMCWEB_LOG_ERROR("Filter program left {} results", stack.size());
+        return true;
+    }
+    return stack.back() != Truth::False;
 }
 
-bool ApplyFilter::matches()
+bool CompiledFilter::matches(const nlohmann::json& member) const
 {
-    return (*this)(filter);
+    return run(member, false);
 }
 
-} // namespace
+bool CompiledFilter::mayMatch(const nlohmann::json& known) const
+{
+    return run(known, true);
+}
 
-bool memberMatches(const nlohmann::json& member,
-                   const filter_ast::LogicalAnd& filterParam)
+bool memberMatches(const nlohmann::json& member, const CompiledFilter& filter)
 {
-    ApplyFilter filterApplier(member, filterParam);
-    return filterApplier.matches();
+    return filter.matches(member);
 }
 
 // Applies a filter expression to a member array
@@ -434,11 +594,12 @@ bool applyFilterToCollection(nlohmann::json& body,
         return false;
     }
 
+    CompiledFilter filter(filterParam);
     json::array_t::iterator it = memberArr->begin();
     size_t index = 0;
     while (it != memberArr->end())
     {
-        if (!memberMatches(*it, filterParam))
+        if (!filter.matches(*it))
         {
             BMCWEB_LOG_DEBUG("Removing item at index {}", index);
             it = memberArr->erase(it);
@@ -5,8 +5,6 @@
 
 #include "dbus_singleton.hpp"
 #include "event_log.hpp"
-#include "event_logs_object_type.hpp"
-#include "event_matches_filter.hpp"
 #include "event_service_store.hpp"
 #include "filter_expr_executor.hpp"
 #include "heartbeat_messages.hpp"
@@ -30,12 +28,12 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <span>
 #include <string>
-#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -46,7 +44,8 @@ Subscription::Subscription(
     std::shared_ptr<persistent_data::UserSubscription> userSubIn,
     const boost::urls::url_view_base& url, boost::asio::io_context& ioc) :
     userSub{std::move(userSubIn)},
-    policy(std::make_shared<crow::ConnectionPolicy>()), hbTimer(ioc)
+    policy(std::make_shared<crow::ConnectionPolicy>()), hbTimer(ioc),
+    coalescingTimer(ioc)
 {
     userSub->destinationUrl = url;
     client.emplace(ioc, policy);
@@ -56,12 +55,13 @@ Subscription::Subscription(
 
 Subscription::Subscription(crow::sse_socket::Connection& connIn) :
     userSub{std::make_shared<persistent_data::UserSubscription>()},
-    sseConn(&connIn), hbTimer(crow::connections::systemBus->get_io_context())
+    sseConn(&connIn), hbTimer(crow::connections::systemBus->get_io_context()),
+    coalescingTimer(crow::connections::systemBus->get_io_context())
 {}
 
 // callback for subscription sendData
 void Subscription::resHandler(const std::shared_ptr<Subscription>& /*self*/,
-                              const crow::Response& res)
+                              size_t eventCount, const crow::Response& res)
 {
     BMCWEB_LOG_DEBUG("Response handled with return code: {}", res.resultInt());
 
@@ -72,6 +72,17 @@ void Subscription::resHandler(const std::shared_ptr<Subscription>& /*self*/,
         return;
     }
 
+    if (retryRespHandler(res.resultInt()))
+    {
+        stats.eventsDropped += eventCount;
+        BMCWEB_LOG_WARNING(
+            "Subscription {} dropped {} events with return code {}. "
+            "Queued {} sent {} coalesced {} dropped {} max pending {}",
+            userSub->id, eventCount, res.resultInt(), stats.eventsQueued,
+            stats.payloadsSent, stats.eventsCoalesced, stats.eventsDropped,
+            stats.maxPendingEvents);
+    }
+
     if (userSub->retryPolicy != "TerminateAfterRetries")
     {
         return;
@@ -79,6 +90,11 @@ void Subscription::resHandler(const std::shared_ptr<Subscription>& /*self*/,
     if (client->isTerminated())
     {
         hbTimer.cancel();
+        // The destination is gone, so the events still waiting for the
+        // coalescing window can't be delivered either
+        coalescingTimer.cancel();
+        stats.eventsDropped += pendingEvents.size();
+        pendingEvents.clear();
         if (deleter)
         {
             BMCWEB_LOG_INFO("Subscription {} is deleted after MaxRetryAttempts",
@@ -165,6 +181,108 @@ void Subscription::onHbTimeout(const std::weak_ptr<Subscription>& weakSelf,
 }
 
 bool Subscription::sendEventToSubscriber(uint64_t eventId, std::string&& msg)
+{
+    flushPendingEvents();
+    stats.eventsQueued++;
+    return sendPayload(eventId, std::move(msg), 1);
+}
+
+bool Subscription::queueEvent(uint64_t eventId, nlohmann::json::object_t&& msg)
+{
+    if (!coalescesEvents())
+    {
+        std::string strMsg = nlohmann::json(std::move(msg)).dump(
+            2, ' ', true, nlohmann::json::error_handler_t::replace);
+        return sendEventToSubscriber(eventId, std::move(strMsg));
+    }
+
+    persistent_data::EventServiceConfig eventServiceConfig =
+        persistent_data::EventServiceStore::getInstance()
+            .getEventServiceConfig();
+    if (!eventServiceConfig.enabled)
+    {
+        return false;
+    }
+
+    stats.eventsQueued++;
+    pendingEvents.emplace_back(eventId, std::move(msg));
+    stats.maxPendingEvents =
+        std::max(stats.maxPendingEvents, pendingEvents.size());
+
+    if (pendingEvents.size() >= maxPendingEvents)
+    {
+        flushPendingEvents();
+        return true;
+    }
+    if (pendingEvents.size() == 1)
+    {
+        coalescingTimer.expires_after(coalescingWindow);
+        coalescingTimer.async_wait(std::bind_front(
+            &Subscription::onCoalescingTimeout, this, weak_from_this()));
+    }
+    return true;
+}
+
+void Subscription::onCoalescingTimeout(
+    const std::weak_ptr<Subscription>& weakSelf,
+    const boost::system::error_code& ec)
+{
+    if (ec == boost::asio::error::operation_aborted)
+    {
+        BMCWEB_LOG_DEBUG("coalescing timer async_wait is aborted");
+        return;
+    }
+    if (ec)
+    {
+        BMCWEB_LOG_CRITICAL("coalescing timer async_wait failed: {}", ec);
+        return;
+    }
+
+    std::shared_ptr<Subscription> self = weakSelf.lock();
+    if (!self)
+    {
+        BMCWEB_LOG_CRITICAL("onCoalescingTimeout failed on Subscription");
+        return;
+    }
+    flushPendingEvents();
+}
+
+void Subscription::flushPendingEvents()
+{
+    if (pendingEvents.empty())
+    {
+        return;
+    }
+    coalescingTimer.cancel();
+    size_t eventCount = pendingEvents.size();
+    uint64_t lastEventId = pendingEvents.back().first;
+
+    std::vector<nlohmann::json::object_t> payloads;
+    payloads.reserve(eventCount);
+    for (auto& [eventId, msg] : pendingEvents)
+    {
+        payloads.emplace_back(std::move(msg));
+    }
+    pendingEvents.clear();
+
+    nlohmann::json payload;
+    if (eventCount == 1)
+    {
+        payload = std::move(payloads.front());
+    }
+    else
+    {
+        stats.eventsCoalesced += eventCount - 1;
+        payload = event_log::mergeEventPayloads(payloads, lastEventId);
+    }
+    // This is the only time the coalesced events are serialized
+    std::string strMsg =
+        payload.dump(2, ' ', true, nlohmann::json::error_handler_t::replace);
+    sendPayload(lastEventId, std::move(strMsg), eventCount);
+}
+
+bool Subscription::sendPayload(uint64_t eventId, std::string&& msg,
+                               size_t eventCount)
 {
     persistent_data::EventServiceConfig eventServiceConfig =
         persistent_data::EventServiceStore::getInstance()
@@ -176,6 +294,7 @@ bool Subscription::sendEventToSubscriber(uint64_t eventId, std::string&& msg)
 
     if (client)
     {
+        stats.payloadsSent++;
         boost::beast::http::fields httpHeadersCopy(userSub->httpHeaders);
         httpHeadersCopy.set(boost::beast::http::field::content_type,
                             "application/json");
@@ -185,7 +304,7 @@ bool Subscription::sendEventToSubscriber(uint64_t eventId, std::string&& msg)
                 userSub->verifyCertificate),
             httpHeadersCopy, boost::beast::http::verb::post,
             std::bind_front(&Subscription::resHandler, this,
-                            shared_from_this()));
+                            shared_from_this(), eventCount));
         return true;
     }
 
@@ -196,62 +315,24 @@ bool Subscription::sendEventToSubscriber(uint64_t eventId, std::string&& msg)
     return true;
 }
 
-void Subscription::filterAndSendEventLogs(
-    uint64_t eventId, const std::vector<EventLogObjectsType>& eventRecords)
+bool Subscription::eventLogMatchesFilter(const nlohmann::json& logEntry,
+                                         uint64_t eventId) const
 {
-    nlohmann::json::array_t logEntryArray;
-    for (const EventLogObjectsType& logEntry : eventRecords)
+    if (!filter)
     {
-        BMCWEB_LOG_DEBUG("Processing logEntry: {}, {} '{}'", logEntry.id,
-                         logEntry.timestamp, logEntry.messageId);
-        std::vector<std::string_view> messageArgsView(
-            logEntry.messageArgs.begin(), logEntry.messageArgs.end());
-
-        nlohmann::json::object_t bmcLogEntry;
-        if (event_log::formatEventLogEntry(
-                eventId, logEntry.id, logEntry.messageId, messageArgsView,
-                logEntry.timestamp, userSub->customText, bmcLogEntry) != 0)
-        {
-            BMCWEB_LOG_WARNING("Read eventLog entry failed");
-            continue;
-        }
-
-        if (!eventMatchesFilter(*userSub, bmcLogEntry, ""))
-        {
-            nlohmann::json jsonEntry = bmcLogEntry;
-            std::string strEntry = jsonEntry.dump(
-                -1, ' ', true, nlohmann::json::error_handler_t::replace);
-            BMCWEB_LOG_DEBUG("Event {} did not match the filter", strEntry);
-            continue;
-        }
-
-        if (filter)
-        {
-            if (!memberMatches(bmcLogEntry, *filter))
-            {
-                BMCWEB_LOG_DEBUG("Filter didn't match");
-                continue;
-            }
-        }
-
-        logEntryArray.emplace_back(std::move(bmcLogEntry));
-        eventId++;
+        return true;
     }
-
-    if (logEntryArray.empty())
+    // The entry is shared between subscribers, so it doesn't have the
+    // EventId and Context this subscriber would receive yet
+    nlohmann::json entry = logEntry;
+    entry["EventId"] = std::to_string(eventId);
+    entry["Context"] = userSub->customText;
+    if (!memberMatches(entry, *filter))
     {
-        BMCWEB_LOG_DEBUG("No log entries available to be transferred.");
-        return;
+        BMCWEB_LOG_DEBUG("Filter didn't match");
+        return false;
     }
-
-    nlohmann::json msg;
-    msg["@odata.type"] = "#Event.v1_4_0.Event";
-    msg["Id"] = std::to_string(eventId);
-    msg["Name"] = "Event Log";
-    msg["Events"] = std::move(logEntryArray);
-    std::string strMsg =
-        msg.dump(2, ' ', true, nlohmann::json::error_handler_t::replace);
-    sendEventToSubscriber(eventId, std::move(strMsg));
+    return true;
 }
 
 void Subscription::filterAndSendReports(uint64_t eventId,
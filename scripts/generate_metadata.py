@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+
+# Script to generate the Redfish $metadata document at build time
+# Reads the CSDL files that are installed, builds the document that
+# handleMetadataGet() would otherwise build on every request, and writes it,
+# a gzip and (when zstd is enabled and a compressor is available) a zstd
+# variant, and its ETag to a generated .hpp file.
+
+import argparse
+import gzip
+import hashlib
+import os
+import shutil
+import subprocess
+import xml.etree.ElementTree as ET
+
+# Odata string types
+EDMX = "{http://docs.oasis-open.org/odata/ns/edmx}"
+EDM = "{http://docs.oasis-open.org/odata/ns/edm}"
+
+WARNING = """/****************************************************************
+ *                 READ THIS WARNING FIRST
+ * This is an auto-generated header which contains the Redfish
+ * $metadata document.
+ * DO NOT modify this file.  It is generated at build time by
+ * scripts/generate_metadata.py from the installed CSDL files.
+ ***************************************************************/"""
+
+
+def find_csdl_files(paths):
+    files = {}
+    for path in paths:
+        if os.path.isdir(path):
+            for filename in os.listdir(path):
+                if filename.endswith("_v1.xml"):
+                    files[filename] = os.path.join(path, filename)
+        else:
+            files[os.path.basename(path)] = path
+    return dict(sorted(files.items()))
+
+
+def metadata_piece(filename, path):
+    xml = f'    <edmx:Reference Uri="/redfish/v1/schema/{filename}">\n'
+    root = ET.parse(path).getroot()
+    for data_services in root.findall(EDMX + "DataServices"):
+        for schema in data_services.findall(EDM + "Schema"):
+            namespace = schema.get("Namespace")
+            alias = ""
+            if namespace.startswith("RedfishExtensions"):
+                alias = ' Alias="Redfish"'
+            xml += f'        <edmx:Include Namespace="{namespace}"{alias}/>\n'
+    xml += "    </edmx:Reference>\n"
+    return xml
+
+
+def build_document(files):
+    xml = '<?xml version="1.0" encoding="UTF-8"?>\n'
+    xml += (
+        '<edmx:Edmx xmlns:edmx="http://docs.oasis-open.org/odata/ns/edmx"'
+        ' Version="4.0">\n'
+    )
+    for filename, path in files.items():
+        xml += metadata_piece(filename, path)
+    xml += "    <edmx:DataServices>\n"
+    xml += (
+        '        <Schema xmlns="http://docs.oasis-open.org/odata/ns/edm"'
+        ' Namespace="Service">\n'
+    )
+    xml += (
+        '            <EntityContainer Name="Service"'
+        ' Extends="ServiceRoot.v1_0_0.ServiceContainer"/>\n'
+    )
+    xml += "        </Schema>\n"
+    xml += "    </edmx:DataServices>\n"
+    xml += "</edmx:Edmx>\n"
+    return xml.encode()
+
+
+def compress_zstd(data):
+    try:
+        from compression import zstd
+
+        return zstd.compress(data, level=19)
+    except ImportError:
+        pass
+    try:
+        import zstandard
+
+        return zstandard.ZstdCompressor(level=19).compress(data)
+    except ImportError:
+        pass
+    program = shutil.which("zstd")
+    if program is None:
+        return b""
+    return subprocess.run(
+        [program, "-19", "-q", "-c"], input=data, capture_output=True, check=True
+    ).stdout
+
+
+def cpp_bytes(name, data):
+    # Character arrays, since string literals past 64KiB trip
+    # -Woverlength-strings
+    out = f"constexpr std::array<char, {len(data)}> {name}Data{{\n"
+    for start in range(0, len(data), 12):
+        chunk = " ".join(
+            f"'\\x{byte:02x}'," for byte in data[start : start + 12]
+        )
+        out += f"    {chunk}\n"
+    return out + "};\n"
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--output", required=True)
+    parser.add_argument("--depfile", required=True)
+    parser.add_argument(
+        "--no-zstd",
+        action="store_true",
+        help="Leave the zstd variant empty, for builds without http-zstd",
+    )
+    parser.add_argument("csdl", nargs="+", help="CSDL files or directories")
+    args = parser.parse_args()
+
+    files = find_csdl_files(args.csdl)
+    document = build_document(files)
+    gzipped = gzip.compress(document, compresslevel=9, mtime=0)
+    zstd_compressed = b"" if args.no_zstd else compress_zstd(document)
+    etag = hashlib.sha256(document).hexdigest()[:32]
+
+    with open(args.output, "w") as hpp:
+        hpp.write("// SPDX-License-Identifier: Apache-2.0\n")
+        hpp.write("// SPDX-FileCopyrightText: Copyright OpenBMC Authors\n")
+        hpp.write("#pragma once\n")
+        hpp.write(WARNING)
+        hpp.write("\n\n#include <array>\n#include <string_view>\n\n")
+        hpp.write("namespace redfish::metadata\n{\n\n")
+        hpp.write(
+            "// Names of the CSDL files the document references, sorted\n"
+        )
+        hpp.write(
+            f"constexpr std::array<std::string_view, {len(files)}> "
+            "schemaFiles{\n"
+        )
+        for filename in files:
+            hpp.write(f'    "{filename}",\n')
+        hpp.write("};\n\n")
+        hpp.write(f'constexpr std::string_view etag = "\\"{etag}\\"";\n\n')
+        hpp.write(cpp_bytes("document", document))
+        hpp.write(cpp_bytes("gzip", gzipped))
+        hpp.write(cpp_bytes("zstd", zstd_compressed))
+        hpp.write("\n")
+        for name in ("document", "gzip", "zstd"):
+            hpp.write(
+                f"constexpr std::string_view {name}({name}Data.data(), "
+                f"{name}Data.size());\n"
+            )
+        hpp.write("\n} // namespace redfish::metadata\n")
+
+    with open(args.depfile, "w") as depfile:
+        depfile.write(f"{args.output}:")
+        for path in files.values():
+            depfile.write(f" {path}")
+        depfile.write("\n")
+
+
+if __name__ == "__main__":
+    main()
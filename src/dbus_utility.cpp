@@ -3,8 +3,11 @@
 
 #include "dbus_utility.hpp"
 
+#include "bmcweb_config.h"
+
 #include "boost_formatters.hpp"
 #include "dbus_singleton.hpp"
+#include "dbus_trace.hpp"
 #include "logging.hpp"
 
 #include <boost/system/errc.hpp>
@@ -16,6 +19,7 @@
 #include <array>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <regex>
 #include <span>
 #include <string>
@@ -47,6 +51,20 @@ void getAllProperties(const std::string& service, const std::string& objectPath,
                       std::function<void(const boost::system::error_code&,
                                          const DBusPropertiesMap&)>&& callback)
 {
+    if constexpr (BMCWEB_DBUS_TRACING)
+    {
+        const std::shared_ptr<bmcweb::DbusTrace>& trace =
+            bmcweb::currentDbusTrace();
+        if (trace != nullptr)
+        {
+            sdbusplus::asio::getAllProperties(
+                *crow::connections::systemBus, service, objectPath, interface,
+                bmcweb::traceDbusCall(trace, service, objectPath,
+                                      "org.freedesktop.DBus.Properties",
+                                      "GetAll", std::move(callback)));
+            return;
+        }
+    }
     sdbusplus::asio::getAllProperties(*crow::connections::systemBus, service,
                                       objectPath, interface,
                                       std::move(callback));
@@ -7,6 +7,7 @@
 #include "app.hpp"
 #include "dbus_monitor.hpp"
 #include "dbus_singleton.hpp"
+#include "dbus_trace_routes.hpp"
 #include "event_service_manager.hpp"
 #include "google_service_root.hpp"
 #include "hostname_monitor.hpp"
@@ -19,6 +20,7 @@
 #include "obmc_console.hpp"
 #include "openbmc_dbus_rest.hpp"
 #include "persistent_data.hpp"
+#include "prometheus_metrics.hpp"
 #include "redfish.hpp"
 #include "redfish_aggregator.hpp"
 #include "user_monitor.hpp"
@@ -32,6 +34,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -97,11 +100,15 @@ int runWebserver()
         }
     }
 
+    // Declared after systemBus, so it is destroyed first
+    std::optional<crow::openbmc_mapper::IntrospectionCacheMonitor>
+        introspectionCacheMonitor;
     if constexpr (BMCWEB_REST)
     {
         crow::dbus_monitor::requestRoutes(app);
         crow::image_upload::requestRoutes(app);
         crow::openbmc_mapper::requestRoutes(app);
+        introspectionCacheMonitor.emplace(*systemBus);
     }
 
     if constexpr (BMCWEB_HOST_SERIAL_SOCKET)
@@ -123,6 +130,16 @@ int runWebserver()
 
     crow::login_routes::requestRoutes(app);
 
+    if constexpr (BMCWEB_ROUTE_METRICS)
+    {
+        crow::prometheus_metrics::requestRoutes(app);
+    }
+
+    if constexpr (BMCWEB_DBUS_TRACING)
+    {
+        crow::dbus_trace::requestRoutes(app);
+    }
+
     if constexpr (!BMCWEB_INSECURE_DISABLE_SSL)
     {
         BMCWEB_LOG_INFO("Start Hostname Monitor Service...");
@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "http/admission_control.hpp"
+#include "io_context_singleton.hpp"
+
+#include <boost/asio/ip/address.hpp>
+#include <boost/beast/http/verb.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace crow
+{
+namespace
+{
+
+using boost::beast::http::verb;
+
+RequestQueue::StartHandler record(std::vector<int>& started, int id)
+{
+    return [&started, id]() { started.push_back(id); };
+}
+
+TEST(ConnectionAdmission, LimitsConnectionsPerIp)
+{
+    ConnectionAdmission admission(7, 0, 2);
+    boost::asio::ip::address client =
+        boost::asio::ip::make_address("192.168.1.10");
+    boost::asio::ip::address other =
+        boost::asio::ip::make_address("192.168.1.11");
+    EXPECT_EQ(admission.admit(client), Admission::Admitted);
+    EXPECT_EQ(admission.admit(client), Admission::Admitted);
+    EXPECT_EQ(admission.admit(client), Admission::Rejected);
+    EXPECT_EQ(admission.admit(other), Admission::Admitted);
+    EXPECT_EQ(admission.connections(), 3U);
+
+    admission.release(client, false);
+    EXPECT_EQ(admission.admit(client), Admission::Admitted);
+
+    // Local clients such as the KVM and console proxies aren't limited
+    boost::asio::ip::address loopback = boost::asio::ip::make_address("::1");
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(admission.admit(loopback), Admission::Admitted);
+    }
+
+    // The total limit applies to everyone
+    EXPECT_EQ(admission.admit(loopback), Admission::Rejected);
+}
+
+TEST(ConnectionAdmission, ReservesSlotsForAuthenticatedClients)
+{
+    ConnectionAdmission admission(4, 2, 4);
+    boost::asio::ip::address client =
+        boost::asio::ip::make_address("10.0.0.1");
+    EXPECT_EQ(admission.admit(client), Admission::Admitted);
+    EXPECT_EQ(admission.admit(client), Admission::Admitted);
+    EXPECT_EQ(admission.admit(client), Admission::MustAuthenticate);
+    admission.authenticated();
+    // Unauthenticated clients still hold all the unreserved slots
+    EXPECT_EQ(admission.admit(client), Admission::MustAuthenticate);
+    EXPECT_EQ(admission.admit(client), Admission::Rejected);
+
+    admission.release(client, false);
+    admission.release(client, false);
+    EXPECT_EQ(admission.connections(), 2U);
+    EXPECT_EQ(admission.admit(client), Admission::Admitted);
+    EXPECT_EQ(admission.admit(client), Admission::MustAuthenticate);
+}
+
+TEST(RequestPriority, ClassifiesRequests)
+{
+    EXPECT_EQ(getRequestPriority(
+                  verb::post, "/redfish/v1/Systems/system/Actions/"
+                              "ComputerSystem.Reset"),
+              RequestPriority::Control);
+    EXPECT_EQ(getRequestPriority(verb::post,
+                                 "/redfish/v1/SessionService/Sessions"),
+              RequestPriority::Control);
+    EXPECT_EQ(getRequestPriority(verb::post, "/login"),
+              RequestPriority::Control);
+    EXPECT_EQ(getRequestPriority(verb::patch, "/redfish/v1/Managers/bmc"),
+              RequestPriority::Modify);
+    EXPECT_EQ(getRequestPriority(verb::delete_,
+                                 "/redfish/v1/SessionService/Sessions/abc"),
+              RequestPriority::Modify);
+    EXPECT_EQ(getRequestPriority(
+                  verb::get, "/redfish/v1/Systems/system/LogServices/"
+                             "EventLog/Entries"),
+              RequestPriority::Read);
+    EXPECT_EQ(getRequestPriority(verb::get, "/redfish/v1/Systems/system/"
+                                            "Actions/ComputerSystem.Reset"),
+              RequestPriority::Read);
+}
+
+TEST(RequestPriority, RecognizesLogins)
+{
+    EXPECT_TRUE(
+        isLoginRequest(verb::post, "/redfish/v1/SessionService/Sessions"));
+    EXPECT_TRUE(
+        isLoginRequest(verb::post, "/redfish/v1/SessionService/Sessions/"));
+    EXPECT_TRUE(isLoginRequest(verb::post, "/login"));
+    // The query string isn't part of the path
+    EXPECT_TRUE(isLoginRequest(verb::post, "/login?x"));
+    EXPECT_TRUE(isLoginRequest(
+        verb::post, "/redfish/v1/SessionService/Sessions?$select=Id"));
+
+    // Other control requests aren't logins
+    EXPECT_FALSE(isLoginRequest(
+        verb::post,
+        "/redfish/v1/Systems/system/Actions/ComputerSystem.Reset"));
+    EXPECT_FALSE(isLoginRequest(verb::get, "/login"));
+    EXPECT_FALSE(isLoginRequest(verb::post, "/login/other"));
+    EXPECT_FALSE(isLoginRequest(verb::post, "/loginx"));
+}
+
+TEST(RequestQueue, StartsWaitingRequestsInPriorityOrder)
+{
+    RequestQueue queue(2);
+    std::vector<int> started;
+    queue.enqueue(RequestPriority::Read, record(started, 1));
+    queue.enqueue(RequestPriority::Read, record(started, 2));
+    EXPECT_EQ(queue.activeRequests(), 2U);
+
+    queue.enqueue(RequestPriority::Read, record(started, 3));
+    queue.enqueue(RequestPriority::Modify, record(started, 4));
+    queue.enqueue(RequestPriority::Control, record(started, 5));
+    EXPECT_EQ(queue.waitingRequests(), 3U);
+    EXPECT_EQ(started, (std::vector<int>{1, 2}));
+
+    // Waiting requests start from the event loop, not from release()
+    queue.release();
+    EXPECT_EQ(started.size(), 2U);
+    getIoContext().restart();
+    getIoContext().run();
+    EXPECT_EQ(started, (std::vector<int>{1, 2, 5}));
+
+    queue.release();
+    queue.release();
+    getIoContext().restart();
+    getIoContext().run();
+    EXPECT_EQ(started, (std::vector<int>{1, 2, 5, 4, 3}));
+    EXPECT_EQ(queue.waitingRequests(), 0U);
+    EXPECT_EQ(queue.activeRequests(), 2U);
+}
+
+TEST(RequestQueue, NewRequestsDontOvertakeWaitingOnes)
+{
+    RequestQueue queue(1);
+    std::vector<int> started;
+    queue.enqueue(RequestPriority::Read, record(started, 1));
+    queue.enqueue(RequestPriority::Read, record(started, 2));
+    queue.release();
+
+    // A slot is free, but a request is already waiting for it
+    queue.enqueue(RequestPriority::Read, record(started, 3));
+    EXPECT_EQ(started, (std::vector<int>{1}));
+    getIoContext().restart();
+    getIoContext().run();
+    EXPECT_EQ(started, (std::vector<int>{1, 2}));
+}
+
+} // namespace
+} // namespace crow
@@ -9,11 +9,15 @@
 #include <boost/beast/core/buffers_to_string.hpp>
 #include <boost/beast/core/file_base.hpp>
 #include <boost/beast/core/file_posix.hpp>
+#include <boost/beast/http/field.hpp>
 #include <boost/beast/http/serializer.hpp>
 #include <boost/beast/http/status.hpp>
+#include <nlohmann/json.hpp>
 
+#include <cstddef>
 #include <cstdio>
 #include <filesystem>
+#include <format>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -218,5 +222,113 @@ TEST(HttpResponse, ZstdHandleEncodingDoesNotCloseFileFd)
     EXPECT_EQ(getData(res.response), data);
 }
 
+nlohmann::json makeLargeCollection()
+{
+    nlohmann::json json;
+    json["@odata.id"] = "/redfish/v1/Systems/system/LogServices/EventLog";
+    nlohmann::json::array_t members;
+    for (size_t i = 0; i < 2000; i++)
+    {
+        nlohmann::json::object_t entry;
+        entry["@odata.id"] = std::format(
+            "/redfish/v1/Systems/system/LogServices/EventLog/Entries/{}", i);
+        entry["Id"] = std::to_string(i);
+        entry["Message"] = "The resource has been created successfully.";
+        entry["Severity"] = "OK";
+        members.emplace_back(std::move(entry));
+    }
+    json["Members@odata.count"] = members.size();
+    json["Members"] = std::move(members);
+    return json;
+}
+
+TEST(HttpResponse, EtagMatchesSerializedBody)
+{
+    Response res;
+    res.jsonValue = makeLargeCollection();
+    std::string etag = res.getCurrentEtag();
+    EXPECT_EQ(etag, getSerializedJsonEtag(serializeJsonBody(res.jsonValue)));
+
+    completeResponseFields("application/json", "", res);
+    EXPECT_EQ(res.getHeaderValue(boost::beast::http::field::etag), etag);
+    EXPECT_EQ(res.result(), boost::beast::http::status::ok);
+    EXPECT_EQ(getSerializedJsonEtag(*res.body()), etag);
+}
+
+TEST(HttpResponse, EtagNotModifiedDropsBody)
+{
+    std::string etag;
+    {
+        Response res;
+        res.jsonValue = makeLargeCollection();
+        etag = res.getCurrentEtag();
+    }
+
+    Response res;
+    res.jsonValue = makeLargeCollection();
+    res.setExpectedEtag(etag);
+    completeResponseFields("application/json", "", res);
+    EXPECT_EQ(res.result(), boost::beast::http::status::not_modified);
+    EXPECT_EQ(res.getHeaderValue(boost::beast::http::field::etag), etag);
+    EXPECT_TRUE(res.body()->empty());
+    EXPECT_TRUE(res.jsonValue.is_null());
+}
+
+TEST(HttpResponse, CborEtagMatchesCborBody)
+{
+    Response res;
+    res.jsonValue = makeLargeCollection();
+    std::string cbor;
+    nlohmann::json::to_cbor(res.jsonValue, cbor);
+    std::string etag = getSerializedJsonEtag(cbor);
+
+    completeResponseFields("application/cbor", "", res);
+    EXPECT_EQ(res.result(), boost::beast::http::status::ok);
+    EXPECT_EQ(res.getHeaderValue(boost::beast::http::field::etag), etag);
+    EXPECT_EQ(*res.body(), cbor);
+
+    Response notModified;
+    notModified.jsonValue = makeLargeCollection();
+    notModified.setExpectedEtag(etag);
+    completeResponseFields("application/cbor", "", notModified);
+    EXPECT_EQ(notModified.result(), boost::beast::http::status::not_modified);
+    EXPECT_TRUE(notModified.body()->empty());
+}
+
+TEST(HttpResponse, EtagOverrideIsKept)
+{
+    Response res;
+    res.jsonValue = makeLargeCollection();
+    res.setCurrentOverrideEtag("\"1234\"");
+    res.setExpectedEtag("\"1234\"");
+    completeResponseFields("application/json", "", res);
+    EXPECT_EQ(res.result(), boost::beast::http::status::not_modified);
+    EXPECT_EQ(res.getHeaderValue(boost::beast::http::field::etag),
+              "\"1234\"");
+}
+
+TEST(HttpResponse, JsonObjectKeyOrder)
+{
+    // Insertion ordered objects would make the body depend on the order that
+    // a handler's callbacks happened to run in
+    nlohmann::ordered_json orderedA;
+    orderedA["PowerState"] = "On";
+    orderedA["BiosVersion"] = "1.0";
+    nlohmann::ordered_json orderedB;
+    orderedB["BiosVersion"] = "1.0";
+    orderedB["PowerState"] = "On";
+    EXPECT_NE(orderedA.dump(), orderedB.dump());
+
+    Response resA;
+    resA.jsonValue["PowerState"] = "On";
+    resA.jsonValue["BiosVersion"] = "1.0";
+    Response resB;
+    resB.jsonValue["BiosVersion"] = "1.0";
+    resB.jsonValue["PowerState"] = "On";
+    EXPECT_EQ(serializeJsonBody(resA.jsonValue),
+              serializeJsonBody(resB.jsonValue));
+    EXPECT_EQ(resA.getCurrentEtag(), resB.getCurrentEtag());
+}
+
 } // namespace
 } // namespace crow
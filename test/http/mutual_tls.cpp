@@ -477,4 +477,135 @@ TEST(GetUPNFromCert, FirstUPNInvalidSecondValid)
     std::string upn = getUPNFromCert(x509, "hostname.domain.com");
     EXPECT_THAT(upn, "second");
 }
+
+// Sets up certificate auth with the username taken from the common name, and
+// returns the server side of a handshake with a client certificate for "user"
+std::optional<OpenSSLSSL> commonNameHandshake()
+{
+    persistent_data::SessionStore::getInstance().getAuthMethodsConfig().tls =
+        true;
+    persistent_data::SessionStore::getInstance()
+        .getAuthMethodsConfig()
+        .mTLSCommonNameParsingMode =
+        persistent_data::MTLSCommonNameParseMode::CommonName;
+
+    OpenSSLX509 x509;
+    x509.setSubjectName("user");
+    x509.addExt(NID_key_usage, "digitalSignature, keyAgreement");
+    x509.addExt(NID_ext_key_usage, "clientAuth");
+
+    std::optional<OpenSSLSSL> serverSsl;
+    mtlsHandshake(&x509, serverSsl);
+    return serverSsl;
+}
+
+TEST(MutualTLS, ReconnectReusesSession)
+{
+    std::optional<OpenSSLSSL> serverSsl = commonNameHandshake();
+    ASSERT_TRUE(serverSsl);
+    if (!serverSsl)
+    {
+        return;
+    }
+
+    boost::asio::ip::address ip = boost::asio::ip::make_address("10.0.0.1");
+    std::shared_ptr<persistent_data::UserSession> session =
+        verifyMtlsUser(ip, *serverSsl);
+    ASSERT_THAT(session, NotNull());
+    EXPECT_EQ(verifyMtlsUser(ip, *serverSsl), session);
+
+    // The same certificate from somewhere else gets its own session
+    boost::asio::ip::address otherIp =
+        boost::asio::ip::make_address("10.0.0.2");
+    persistent_data::SessionStore& store =
+        persistent_data::SessionStore::getInstance();
+    store.needWrite = false;
+    std::shared_ptr<persistent_data::UserSession> otherSession =
+        verifyMtlsUser(otherIp, *serverSsl);
+    ASSERT_THAT(otherSession, NotNull());
+    EXPECT_NE(otherSession, session);
+    EXPECT_EQ(otherSession->username, "user");
+
+    // and the session from the old address is removed rather than left to
+    // time out, without writing the persistent data
+    EXPECT_EQ(store.getSessionByUid(session->uniqueId), nullptr);
+    EXPECT_EQ(store.getSessionByUid(otherSession->uniqueId), otherSession);
+    EXPECT_FALSE(store.needsWrite());
+}
+
+TEST(MutualTLS, RemovedSessionIsNotReused)
+{
+    std::optional<OpenSSLSSL> serverSsl = commonNameHandshake();
+    ASSERT_TRUE(serverSsl);
+    if (!serverSsl)
+    {
+        return;
+    }
+
+    boost::asio::ip::address ip;
+    std::shared_ptr<persistent_data::UserSession> session =
+        verifyMtlsUser(ip, *serverSsl);
+    ASSERT_THAT(session, NotNull());
+    persistent_data::SessionStore::getInstance().removeSession(session);
+
+    std::shared_ptr<persistent_data::UserSession> newSession =
+        verifyMtlsUser(ip, *serverSsl);
+    ASSERT_THAT(newSession, NotNull());
+    EXPECT_NE(newSession, session);
+    EXPECT_EQ(newSession->username, "user");
+}
+
+TEST(MutualTLS, ExpiredSessionIsNotWritten)
+{
+    std::optional<OpenSSLSSL> serverSsl = commonNameHandshake();
+    ASSERT_TRUE(serverSsl);
+    if (!serverSsl)
+    {
+        return;
+    }
+
+    boost::asio::ip::address ip;
+    std::shared_ptr<persistent_data::UserSession> session =
+        verifyMtlsUser(ip, *serverSsl);
+    ASSERT_THAT(session, NotNull());
+    persistent_data::SessionStore& store =
+        persistent_data::SessionStore::getInstance();
+    std::shared_ptr<persistent_data::UserSession> cookieSession =
+        store.generateUserSession("user", ip, std::nullopt,
+                                  persistent_data::SessionType::Session);
+    ASSERT_THAT(cookieSession, NotNull());
+
+    session->lastUpdated -= store.timeoutInSeconds;
+    store.lastTimeoutUpdate = {};
+    store.needWrite = false;
+    store.applySessionTimeouts();
+    EXPECT_EQ(store.getSessionByUid(session->uniqueId), nullptr);
+    EXPECT_FALSE(store.needsWrite());
+
+    // Sessions that are persisted still need writing when they expire
+    cookieSession->lastUpdated -= store.timeoutInSeconds;
+    store.lastTimeoutUpdate = {};
+    store.applySessionTimeouts();
+    EXPECT_EQ(store.getSessionByUid(cookieSession->uniqueId), nullptr);
+    EXPECT_TRUE(store.needsWrite());
+}
+
+TEST(MutualTLS, ParseModeChangeRevalidatesUser)
+{
+    std::optional<OpenSSLSSL> serverSsl = commonNameHandshake();
+    ASSERT_TRUE(serverSsl);
+    if (!serverSsl)
+    {
+        return;
+    }
+
+    boost::asio::ip::address ip;
+    ASSERT_THAT(verifyMtlsUser(ip, *serverSsl), NotNull());
+
+    persistent_data::SessionStore::getInstance()
+        .getAuthMethodsConfig()
+        .mTLSCommonNameParsingMode =
+        persistent_data::MTLSCommonNameParseMode::Invalid;
+    EXPECT_THAT(verifyMtlsUser(ip, *serverSsl), IsNull());
+}
 } // namespace
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "http/complete_response_fields.hpp"
+#include "http/http_request.hpp"
+#include "http/http_response.hpp"
+#include "http/preserialized_json.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/status.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <nlohmann/json.hpp>
+
+#include <string_view>
+#include <system_error>
+
+#include <gtest/gtest.h>
+
+namespace crow
+{
+namespace
+{
+
+using boost::beast::http::field;
+
+constexpr std::string_view registryUrl = "/redfish/v1/Registries/Base/Base";
+
+nlohmann::json makeDocument()
+{
+    nlohmann::json json;
+    json["@odata.type"] = "#MessageRegistry.v1_6_2.MessageRegistry";
+    json["Id"] = "Base.1.19.0";
+    json["Messages"]["Success"]["Message"] = "The request completed.";
+    json["Messages"]["Success"]["NumberOfArgs"] = 0;
+    return json;
+}
+
+TEST(PreserializedJson, MatchesJsonValueResponse)
+{
+    nlohmann::json json = makeDocument();
+    PreserializedJson doc = preserializeJson(json);
+
+    Response res;
+    res.jsonValue = json;
+    completeResponseFields("application/json", "", res);
+    EXPECT_EQ(doc.json, *res.body());
+    EXPECT_EQ(doc.etag, res.getHeaderValue(field::etag));
+}
+
+TEST(PreserializedJson, CanUsePreserializedJson)
+{
+    std::error_code ec;
+    Request req{{boost::beast::http::verb::get, registryUrl, 11}, ec};
+    EXPECT_TRUE(canUsePreserializedJson(req));
+    req.addHeader(field::accept, "application/json");
+    EXPECT_TRUE(canUsePreserializedJson(req));
+
+    Request html{{boost::beast::http::verb::get, registryUrl, 11}, ec};
+    html.addHeader(field::accept, "text/html");
+    EXPECT_FALSE(canUsePreserializedJson(html));
+
+    Request query{{boost::beast::http::verb::get,
+                   "/redfish/v1/Registries/Base/Base?$select=Id", 11},
+                  ec};
+    EXPECT_FALSE(canUsePreserializedJson(query));
+}
+
+TEST(PreserializedJson, WritesDocumentOrNotModified)
+{
+    PreserializedJson doc = preserializeJson(makeDocument());
+
+    std::error_code ec;
+    Request req{{boost::beast::http::verb::get, registryUrl, 11}, ec};
+    Response res;
+    EXPECT_TRUE(writePreserializedJson(req, res, doc));
+    EXPECT_EQ(*res.body(), doc.json);
+    EXPECT_EQ(res.getHeaderValue(field::etag), doc.etag);
+    EXPECT_EQ(res.getHeaderValue(field::content_type), "application/json");
+
+    req.addHeader(field::if_none_match, doc.etag);
+    Response notModified;
+    EXPECT_TRUE(writePreserializedJson(req, notModified, doc));
+    EXPECT_EQ(notModified.result(), boost::beast::http::status::not_modified);
+    EXPECT_TRUE(notModified.body()->empty());
+}
+
+TEST(PreserializedJson, LeavesBodyWhenOnlyCompressedIsKept)
+{
+    PreserializedJson doc;
+    doc.etag = "\"0123ABCD\"";
+    doc.zstd = "compressed";
+
+    std::error_code ec;
+    Request req{{boost::beast::http::verb::get,
+                 "/redfish/v1/JsonSchemas/Chassis/Chassis.v1_25_0.json", 11},
+                ec};
+    Response res;
+    EXPECT_FALSE(writePreserializedJson(req, res, doc));
+    EXPECT_EQ(res.getHeaderValue(field::etag), doc.etag);
+    EXPECT_TRUE(res.body()->empty());
+
+    req.addHeader(field::accept_encoding, "zstd");
+    Response zstd;
+    EXPECT_TRUE(writePreserializedJson(req, zstd, doc));
+    EXPECT_EQ(*zstd.body(), "compressed");
+    EXPECT_EQ(zstd.getHeaderValue(field::content_encoding), "zstd");
+}
+
+} // namespace
+} // namespace crow
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "http/route_metrics.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace crow
+{
+namespace
+{
+
+using ::testing::HasSubstr;
+
+TEST(LatencyHistogram, RecordsIntoBuckets)
+{
+    LatencyHistogram histogram;
+    histogram.record(std::chrono::microseconds(10));
+    histogram.record(std::chrono::microseconds(500));
+    histogram.record(std::chrono::microseconds(501));
+    histogram.record(std::chrono::seconds(60));
+    histogram.record(std::chrono::microseconds(-5));
+
+    EXPECT_EQ(histogram.getCount(), 5U);
+    EXPECT_EQ(histogram.getSum(), 60001011U);
+    EXPECT_EQ(histogram.getBuckets()[0], 3U);
+    EXPECT_EQ(histogram.getBuckets()[1], 1U);
+    EXPECT_EQ(histogram.getBuckets().back(), 1U);
+}
+
+TEST(RouteTimer, RecordsFinishedRequest)
+{
+    RouteMetrics metrics;
+    {
+        RouteTimer timer(metrics);
+        EXPECT_EQ(metrics.inFlight, 1U);
+        timer.handlerStarted();
+        timer.handlerReturned();
+        timer.serializationStarted();
+        timer.finish(1234);
+        EXPECT_EQ(metrics.inFlight, 0U);
+        // Finishing again, or destroying the timer, doesn't count it twice
+        timer.finish(1);
+    }
+    EXPECT_EQ(metrics.requests, 1U);
+    EXPECT_EQ(metrics.responseBytes, 1234U);
+    EXPECT_EQ(metrics.latency.getCount(), 1U);
+    EXPECT_EQ(metrics.handlerTime.getCount(), 1U);
+    EXPECT_EQ(metrics.waitTime.getCount(), 1U);
+    EXPECT_EQ(metrics.serializationTime.getCount(), 1U);
+}
+
+TEST(RouteTimer, RecordsUnfinishedRequestOnDestruction)
+{
+    RouteMetrics metrics;
+    {
+        RouteTimer timer(metrics);
+    }
+    EXPECT_EQ(metrics.inFlight, 0U);
+    EXPECT_EQ(metrics.requests, 1U);
+    EXPECT_EQ(metrics.responseBytes, 0U);
+}
+
+TEST(RouteMetrics, FormatsPrometheusText)
+{
+    RouteMetrics metrics;
+    metrics.requests = 2;
+    metrics.responseBytes = 300;
+    metrics.latency.record(std::chrono::microseconds(700));
+    metrics.latency.record(std::chrono::milliseconds(20));
+
+    std::vector<RouteMetricsEntry> entries(1);
+    entries[0].route = "/redfish/v1/Systems/<str>/";
+    entries[0].methods = "GET";
+    entries[0].metrics = &metrics;
+    std::string text = formatPrometheusMetrics(entries);
+
+    const std::string labels =
+        "{route=\"/redfish/v1/Systems/<str>/\",method=\"GET\"";
+    EXPECT_THAT(text, HasSubstr("# TYPE bmcweb_route_requests_total counter\n"
+                                "bmcweb_route_requests_total" +
+                                labels + "} 2\n"));
+    EXPECT_THAT(text,
+                HasSubstr("bmcweb_route_response_bytes_total" + labels +
+                          "} 300\n"));
+    EXPECT_THAT(text, HasSubstr("# TYPE bmcweb_route_latency_seconds "
+                                "histogram\n"));
+    EXPECT_THAT(text, HasSubstr("bmcweb_route_latency_seconds_bucket" +
+                                labels + ",le=\"0.0005\"} 0\n"));
+    EXPECT_THAT(text, HasSubstr("bmcweb_route_latency_seconds_bucket" +
+                                labels + ",le=\"0.001\"} 1\n"));
+    EXPECT_THAT(text, HasSubstr("bmcweb_route_latency_seconds_bucket" +
+                                labels + ",le=\"0.025\"} 2\n"));
+    EXPECT_THAT(text, HasSubstr("bmcweb_route_latency_seconds_bucket" +
+                                labels + ",le=\"+Inf\"} 2\n"));
+    EXPECT_THAT(text, HasSubstr("bmcweb_route_latency_seconds_sum" + labels +
+                                "} 0.0207\n"));
+    EXPECT_THAT(text, HasSubstr("bmcweb_route_latency_seconds_count" +
+                                labels + "} 2\n"));
+}
+
+TEST(RouteMetrics, EscapesLabels)
+{
+    RouteMetrics metrics;
+    std::vector<RouteMetricsEntry> entries(1);
+    entries[0].route = "/a\"b\\";
+    entries[0].methods = "GET,POST";
+    entries[0].metrics = &metrics;
+    EXPECT_THAT(formatPrometheusMetrics(entries),
+                HasSubstr("{route=\"/a\\\"b\\\\\",method=\"GET,POST\"}"));
+}
+
+} // namespace
+} // namespace crow
@@ -7,10 +7,14 @@
 
 #include <boost/beast/http/verb.hpp>
 
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -154,5 +158,126 @@ TEST(Router, 405)
     }
     EXPECT_TRUE(called);
 }
+
+struct RedfishRoute
+{
+    std::string_view rule;
+    std::string_view url;
+    std::string_view allow;
+};
+
+// A cross section of the Redfish tree, with the patterns and verb split of
+// the real handlers
+constexpr std::array<RedfishRoute, 24> redfishRoutes{{
+    {"/redfish/", "/redfish/", "GET"},
+    {"/redfish/v1/", "/redfish/v1/", "GET"},
+    {"/redfish/v1/$metadata/", "/redfish/v1/$metadata/", "GET"},
+    {"/redfish/v1/AccountService/", "/redfish/v1/AccountService/",
+     "GET, PATCH"},
+    {"/redfish/v1/AccountService/Accounts/",
+     "/redfish/v1/AccountService/Accounts/", "GET, POST"},
+    {"/redfish/v1/AccountService/Accounts/<str>/",
+     "/redfish/v1/AccountService/Accounts/root/", "DELETE, GET, PATCH"},
+    {"/redfish/v1/Chassis/", "/redfish/v1/Chassis/", "GET"},
+    {"/redfish/v1/Chassis/<str>/", "/redfish/v1/Chassis/chassis/",
+     "GET, PATCH"},
+    {"/redfish/v1/Chassis/<str>/Sensors/",
+     "/redfish/v1/Chassis/chassis/Sensors/", "GET"},
+    {"/redfish/v1/Chassis/<str>/Sensors/<str>/",
+     "/redfish/v1/Chassis/chassis/Sensors/temperature_cpu0/", "GET"},
+    {"/redfish/v1/Chassis/<str>/Thermal/",
+     "/redfish/v1/Chassis/chassis/Thermal/", "GET, PATCH"},
+    {"/redfish/v1/Managers/<str>/", "/redfish/v1/Managers/bmc/",
+     "GET, PATCH"},
+    {"/redfish/v1/Managers/<str>/Actions/Manager.Reset/",
+     "/redfish/v1/Managers/bmc/Actions/Manager.Reset/", "POST"},
+    {"/redfish/v1/Managers/<str>/LogServices/<str>/Entries/<str>/",
+     "/redfish/v1/Managers/bmc/LogServices/Journal/Entries/1234/",
+     "DELETE, GET"},
+    {"/redfish/v1/SessionService/Sessions/",
+     "/redfish/v1/SessionService/Sessions/", "GET, POST"},
+    {"/redfish/v1/SessionService/Sessions/<str>/",
+     "/redfish/v1/SessionService/Sessions/abcdef/", "DELETE, GET"},
+    {"/redfish/v1/Systems/", "/redfish/v1/Systems/", "GET"},
+    {"/redfish/v1/Systems/<str>/", "/redfish/v1/Systems/system/",
+     "GET, PATCH"},
+    {"/redfish/v1/Systems/<str>/Actions/ComputerSystem.Reset/",
+     "/redfish/v1/Systems/system/Actions/ComputerSystem.Reset/", "POST"},
+    {"/redfish/v1/Systems/<str>/LogServices/EventLog/Entries/",
+     "/redfish/v1/Systems/system/LogServices/EventLog/Entries/", "GET"},
+    {"/redfish/v1/Systems/<str>/LogServices/EventLog/Entries/<str>/",
+     "/redfish/v1/Systems/system/LogServices/EventLog/Entries/12/",
+     "DELETE, GET, PATCH"},
+    {"/redfish/v1/Systems/<str>/Processors/<str>/",
+     "/redfish/v1/Systems/system/Processors/cpu0/", "GET"},
+    {"/redfish/v1/UpdateService/FirmwareInventory/<str>/",
+     "/redfish/v1/UpdateService/FirmwareInventory/bmc_active/", "GET"},
+    {"/redfish/v1/JsonSchemas/<str>/",
+     "/redfish/v1/JsonSchemas/ComputerSystem/", "GET"},
+}};
+
+// A cross section of the Redfish routes, with a rule per verb like the real
+// handlers
+TEST(Router, RedfishRouteSet)
+{
+    auto nullCallback =
+        [](const Request&, const std::shared_ptr<bmcweb::AsyncResp>&) {};
+
+    Router router;
+    std::error_code ec;
+
+    using boost::beast::http::verb;
+    for (const RedfishRoute& route : redfishRoutes)
+    {
+        std::string rule(route.rule);
+        // Like the real handlers, each verb has its own rule
+        for (std::pair<std::string_view, verb> method :
+             {std::pair{"DELETE", verb::delete_}, std::pair{"GET", verb::get},
+              std::pair{"PATCH", verb::patch}, std::pair{"POST", verb::post}})
+        {
+            if (route.allow.find(method.first) != std::string_view::npos)
+            {
+                router.newRuleDynamic(rule).methods(method.second)(
+                    nullCallback);
+            }
+        }
+    }
+    router.validate();
+
+    std::vector<Request> requests;
+    requests.reserve(redfishRoutes.size() * 2);
+    for (const RedfishRoute& route : redfishRoutes)
+    {
+        requests.emplace_back(Request::Body{verb::get, route.url, 11}, ec);
+        // Without the trailing slash
+        requests.emplace_back(
+            Request::Body{verb::get, route.url.substr(0, route.url.size() - 1),
+                          11},
+            ec);
+    }
+
+    for (size_t i = 0; i < redfishRoutes.size(); i++)
+    {
+        for (size_t j = 0; j < 2; j++)
+        {
+            const Request& req = requests[(i * 2) + j];
+            Router::FindRouteResponse found = router.findRoute(req);
+            EXPECT_EQ(found.allowHeader, redfishRoutes[i].allow)
+                << req.target();
+            if (redfishRoutes[i].allow.find("GET") == std::string_view::npos)
+            {
+                EXPECT_EQ(found.route.rule, nullptr);
+                continue;
+            }
+            ASSERT_NE(found.route.rule, nullptr) << req.target();
+            EXPECT_EQ(found.route.rule->rule, redfishRoutes[i].rule);
+        }
+    }
+
+    Request missing{{verb::get, "/redfish/v1/Systems/system/Missing/", 11},
+                    ec};
+    EXPECT_EQ(router.findRoute(missing).route.rule, nullptr);
+    EXPECT_EQ(router.findRoute(missing).allowHeader, "");
+}
 } // namespace
 } // namespace crow
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "dbus_trace.hpp"
+
+#include <boost/system/errc.hpp>
+#include <boost/system/error_code.hpp>
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace bmcweb
+{
+namespace
+{
+
+using ::testing::StartsWith;
+
+TEST(DbusTrace, RecordsCallsAndSummary)
+{
+    DbusTrace trace("GET", "/redfish/v1/Systems/system");
+    size_t first = trace.startCall("xyz.openbmc_project.ObjectMapper",
+                                   "/xyz/openbmc_project/object_mapper",
+                                   "xyz.openbmc_project.ObjectMapper",
+                                   "GetSubTree");
+    size_t second = trace.startCall("xyz.openbmc_project.State.Host",
+                                    "/xyz/openbmc_project/state/host0",
+                                    "org.freedesktop.DBus.Properties", "Get");
+    trace.finishCall(first, false, 100);
+    trace.finishCall(second, true, 0);
+    trace.complete();
+
+    ASSERT_EQ(trace.getCalls().size(), 2U);
+    EXPECT_TRUE(trace.getCalls()[0].replied);
+    EXPECT_EQ(trace.getCalls()[0].replyBytes, 100U);
+    EXPECT_TRUE(trace.getCalls()[1].error);
+    EXPECT_THAT(trace.getServerTiming(), StartsWith("dbus;dur="));
+    EXPECT_THAT(trace.getServerTiming(),
+                ::testing::EndsWith(
+                    ";desc=\"2 calls, 1 errors, 100 reply bytes\""));
+}
+
+TEST(DbusTrace, CountsCallsPastLimit)
+{
+    DbusTrace trace("GET", "/");
+    for (size_t i = 0; i < DbusTrace::maxCalls + 2; i++)
+    {
+        size_t call = trace.startCall("a.b", "/", "a.b", "C");
+        trace.finishCall(call, false, 1);
+    }
+    EXPECT_EQ(trace.getCalls().size(), DbusTrace::maxCalls);
+    EXPECT_EQ(trace.getCallCount(), DbusTrace::maxCalls + 2);
+}
+
+TEST(DbusTrace, IgnoresCallsAfterComplete)
+{
+    DbusTrace trace("GET", "/");
+    size_t call = trace.startCall("a.b", "/", "a.b", "C");
+    trace.complete();
+    std::string timing = trace.getServerTiming();
+
+    trace.finishCall(call, true, 100);
+    trace.finishCall(trace.startCall("a.b", "/", "a.b", "D"), false, 1);
+    ASSERT_EQ(trace.getCalls().size(), 1U);
+    EXPECT_FALSE(trace.getCalls()[0].replied);
+    EXPECT_FALSE(trace.getCalls()[0].error);
+    EXPECT_EQ(trace.getCallCount(), 1U);
+    EXPECT_EQ(trace.getServerTiming(), timing);
+}
+
+struct ObjectPath
+{
+    std::string str;
+};
+
+TEST(DbusTrace, EstimatesReplySize)
+{
+    EXPECT_EQ(estimateDbusSize(boost::system::error_code()), 0U);
+    EXPECT_EQ(estimateDbusSize(uint32_t{4}), 4U);
+    EXPECT_EQ(estimateDbusSize(std::string("abc")), 3U);
+    EXPECT_EQ(estimateDbusSize(ObjectPath{"/xyz"}), 4U);
+
+    std::vector<std::pair<std::string, std::variant<std::string, int64_t>>>
+        properties{{"Name", std::string("cpu0")}, {"Value", int64_t{5}}};
+    EXPECT_EQ(estimateDbusSize(properties), 4U + 4U + 5U + 8U);
+    EXPECT_EQ(estimateDbusSize(std::tuple<bool, double>(true, 1.0)),
+              sizeof(bool) + sizeof(double));
+}
+
+TEST(DbusTrace, WrapsReplyHandler)
+{
+    auto trace = std::make_shared<DbusTrace>("GET", "/redfish/v1");
+    bool called = false;
+    auto handler = traceDbusCall(
+        trace, "a.b", "/a/b", "a.b.C", "List",
+        [&called, trace](const boost::system::error_code& ec,
+                         const std::vector<std::string>& values) {
+            called = true;
+            EXPECT_FALSE(ec);
+            EXPECT_EQ(values.size(), 2U);
+            // The reply runs with the request's trace set
+            EXPECT_EQ(currentDbusTrace(), trace);
+        });
+    EXPECT_EQ(currentDbusTrace(), nullptr);
+
+    handler(boost::system::error_code(),
+            std::vector<std::string>{"ab", "cde"});
+    EXPECT_TRUE(called);
+    EXPECT_EQ(currentDbusTrace(), nullptr);
+    ASSERT_EQ(trace->getCalls().size(), 1U);
+    EXPECT_EQ(trace->getCalls()[0].method, "List");
+    EXPECT_EQ(trace->getCalls()[0].replyBytes, 5U);
+    EXPECT_FALSE(trace->getCalls()[0].error);
+
+    auto failing = traceDbusCall(trace, "a.b", "/a/b", "a.b.C", "Fail",
+                                 [](const boost::system::error_code&) {});
+    failing(boost::system::errc::make_error_code(
+        boost::system::errc::io_error));
+    EXPECT_TRUE(trace->getCalls()[1].error);
+}
+
+TEST(DbusTrace, ScopesNest)
+{
+    auto outer = std::make_shared<DbusTrace>("GET", "/a");
+    auto inner = std::make_shared<DbusTrace>("GET", "/b");
+    {
+        ScopedDbusTrace outerScope(outer);
+        {
+            ScopedDbusTrace innerScope(inner);
+            EXPECT_EQ(currentDbusTrace(), inner);
+        }
+        EXPECT_EQ(currentDbusTrace(), outer);
+    }
+    EXPECT_EQ(currentDbusTrace(), nullptr);
+}
+
+TEST(DbusTraceLog, FormatsChromeTrace)
+{
+    DbusTraceLog log;
+    for (size_t i = 0; i < DbusTraceLog::maxTraces + 1; i++)
+    {
+        auto trace = std::make_shared<DbusTrace>("GET", "/redfish/v1");
+        size_t call = trace->startCall("a.b", "/a/b", "a.b.C", "Get");
+        trace->finishCall(call, false, 8);
+        trace->complete();
+        log.add(std::move(trace));
+    }
+
+    nlohmann::json trace = log.getChromeTrace();
+    const nlohmann::json& events = trace["traceEvents"];
+    // Only the most recent traces are kept, one request and one call each
+    ASSERT_EQ(events.size(), DbusTraceLog::maxTraces * 2);
+    EXPECT_EQ(events[0]["name"], "GET /redfish/v1");
+    EXPECT_EQ(events[0]["cat"], "request");
+    EXPECT_EQ(events[0]["ph"], "X");
+    EXPECT_EQ(events[0]["tid"], 1);
+    EXPECT_EQ(events[1]["name"], "a.b.C.Get");
+    EXPECT_EQ(events[1]["cat"], "dbus");
+    EXPECT_EQ(events[1]["args"]["path"], "/a/b");
+    EXPECT_EQ(events[1]["args"]["replyBytes"], 8);
+    EXPECT_EQ(events.back()["tid"], DbusTraceLog::maxTraces);
+}
+
+} // namespace
+} // namespace bmcweb
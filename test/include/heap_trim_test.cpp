@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "heap_trim.hpp"
+
+#include <boost/asio/io_context.hpp>
+
+#include <chrono>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+namespace bmcweb
+{
+namespace
+{
+
+size_t trimCount = 0;
+
+bool countTrim()
+{
+    trimCount++;
+    return true;
+}
+
+class HeapTrimmerTest : public ::testing::Test
+{
+  protected:
+    HeapTrimmerTest()
+    {
+        trimCount = 0;
+    }
+
+    boost::asio::io_context io;
+    HeapTrimmer trimmer{io, std::chrono::milliseconds(1), countTrim};
+};
+
+TEST_F(HeapTrimmerTest, NoTrimWithoutResponses)
+{
+    io.run();
+    EXPECT_EQ(trimCount, 0);
+}
+
+TEST_F(HeapTrimmerTest, TrimsOnceIdle)
+{
+    trimmer.responseCompleted();
+    EXPECT_EQ(trimCount, 0);
+    io.run();
+    EXPECT_EQ(trimCount, 1);
+}
+
+TEST_F(HeapTrimmerTest, ResponseRestartsIdleTimer)
+{
+    // Each response cancels the wait started by the one before it, so a
+    // burst of responses only trims once
+    trimmer.responseCompleted();
+    trimmer.responseCompleted();
+    trimmer.responseCompleted();
+    io.run();
+    EXPECT_EQ(trimCount, 1);
+}
+
+TEST_F(HeapTrimmerTest, TrimsAgainAfterNextBurst)
+{
+    trimmer.responseCompleted();
+    io.run();
+    EXPECT_EQ(trimCount, 1);
+
+    io.restart();
+    trimmer.responseCompleted();
+    trimmer.responseCompleted();
+    io.run();
+    EXPECT_EQ(trimCount, 2);
+}
+
+TEST_F(HeapTrimmerTest, DestroyedBeforeIdle)
+{
+    {
+        HeapTrimmer shortLived(io, std::chrono::milliseconds(1), countTrim);
+        shortLived.responseCompleted();
+    }
+    io.run();
+    EXPECT_EQ(trimCount, 0);
+}
+
+} // namespace
+} // namespace bmcweb
@@ -2,8 +2,14 @@
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #include "human_sort.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <random>
 #include <set>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -52,4 +58,69 @@ TEST(AlphaNum, LessTest)
         "Alpha 10", "Alpha 2"};
     EXPECT_THAT(sorted, ElementsAreArray({"Alpha 2", "Alpha 10"}));
 }
+
+TEST(HumanSortKey, MatchesAlphanumComp)
+{
+    std::vector<std::string_view> strings{
+        "",
+        "a",
+        "9",
+        "1",
+        "01",
+        "2",
+        "a1",
+        "a2",
+        "a1a2",
+        "a1a3",
+        "134",
+        "122",
+        "aa",
+        "Alpha 2",
+        "Alpha 2A",
+        "Alpha 2 B",
+        "99999999999",
+        "\xff",
+        "dimm10_cpu1_channel3_slot2_rank0",
+        "dimm10_cpu1_channel3_slot2_rank1",
+        "dimm10_cpu1_channel3_slot10_rank0",
+    };
+    for (std::string_view left : strings)
+    {
+        for (std::string_view right : strings)
+        {
+            int expected = alphanumComp(left, right);
+            int actual = HumanSortKey(left).compare(HumanSortKey(right));
+            EXPECT_EQ(expected < 0, actual < 0) << left << " " << right;
+            EXPECT_EQ(expected == 0, actual == 0) << left << " " << right;
+        }
+    }
+}
+
+TEST(HumanSort, SortsByProjection)
+{
+    std::vector<std::pair<int, std::string>> values{
+        {0, "Alpha 10"}, {1, "Alpha 2"}, {2, "Alpha 1"}};
+    humanSort(values, &std::pair<int, std::string>::second);
+    ASSERT_EQ(values.size(), 3);
+    EXPECT_EQ(values[0].first, 2);
+    EXPECT_EQ(values[1].first, 1);
+    EXPECT_EQ(values[2].first, 0);
+}
+
+TEST(HumanSort, LargeCollectionMatchesAlphanumLess)
+{
+    std::vector<std::string> names;
+    for (size_t i = 0; i < 10000; i++)
+    {
+        names.emplace_back(
+            std::format("cpu{}_dimm{}_slot{}", i % 8, i / 8 % 32, i));
+    }
+    std::ranges::shuffle(names, std::mt19937(42));
+
+    std::vector<std::string> expected = names;
+    std::ranges::sort(expected, AlphanumLess<std::string>());
+
+    humanSort(names);
+    EXPECT_EQ(names, expected);
+}
 } // namespace
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "event_journal.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace redfish
+{
+namespace
+{
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+class EventJournalTest : public ::testing::Test
+{
+  protected:
+    EventJournalTest() :
+        dir(std::filesystem::temp_directory_path() /
+            std::format("bmcweb_event_journal_{}",
+                        ::testing::UnitTest::GetInstance()
+                            ->current_test_info()
+                            ->name()))
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    ~EventJournalTest() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    EventJournalTest(const EventJournalTest&) = delete;
+    EventJournalTest(EventJournalTest&&) = delete;
+    EventJournalTest& operator=(const EventJournalTest&) = delete;
+    EventJournalTest& operator=(EventJournalTest&&) = delete;
+
+    static std::vector<std::pair<uint64_t, std::string>> replay(
+        const EventJournal& journal, uint64_t lastEventId, bool& found)
+    {
+        std::vector<std::pair<uint64_t, std::string>> events;
+        found = journal.replayAfter(
+            lastEventId, [&events](uint64_t id, std::string_view message) {
+                events.emplace_back(id, message);
+            });
+        return events;
+    }
+
+    std::filesystem::path dir;
+};
+
+TEST_F(EventJournalTest, ResumeAfterRestart)
+{
+    {
+        EventJournal journal(dir, 4096);
+        EXPECT_EQ(journal.lastEventId(), 0U);
+        EXPECT_TRUE(journal.append(1, R"({"Id":"1"})"));
+        EXPECT_TRUE(journal.append(2, R"({"Id":"2"})"));
+        EXPECT_TRUE(journal.append(3, R"({"Id":"3"})"));
+        // Ids must increase
+        EXPECT_FALSE(journal.append(3, R"({"Id":"3"})"));
+        EXPECT_FALSE(journal.append(4, "{\n}"));
+    }
+
+    EventJournal journal(dir, 4096);
+    EXPECT_EQ(journal.lastEventId(), 3U);
+
+    bool found = false;
+    EXPECT_THAT(replay(journal, 1, found),
+                ElementsAre(Pair(2, R"({"Id":"2"})"), Pair(3, R"({"Id":"3"})")));
+    EXPECT_TRUE(found);
+
+    EXPECT_THAT(replay(journal, 3, found), ElementsAre());
+    EXPECT_TRUE(found);
+
+    replay(journal, 42, found);
+    EXPECT_FALSE(found);
+}
+
+TEST_F(EventJournalTest, BoundedSize)
+{
+    constexpr uint64_t maxSize = 1024;
+    EventJournal journal(dir, maxSize);
+    for (uint64_t id = 1; id <= 200; id++)
+    {
+        EXPECT_TRUE(journal.append(id, std::format(R"({{"Id":"{}"}})", id)));
+    }
+    EXPECT_EQ(journal.lastEventId(), 200U);
+
+    uint64_t totalSize = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir))
+    {
+        totalSize += entry.file_size();
+    }
+    EXPECT_LE(totalSize, maxSize);
+
+    // The oldest events have been dropped
+    bool found = true;
+    replay(journal, 1, found);
+    EXPECT_FALSE(found);
+
+    std::vector<std::pair<uint64_t, std::string>> events =
+        replay(journal, 190, found);
+    EXPECT_TRUE(found);
+    ASSERT_EQ(events.size(), 10U);
+    EXPECT_EQ(events.front().first, 191U);
+    EXPECT_EQ(events.back().second, R"({"Id":"200"})");
+}
+
+TEST_F(EventJournalTest, PartialRecordDropped)
+{
+    {
+        EventJournal journal(dir, 4096);
+        EXPECT_TRUE(journal.append(1, R"({"Id":"1"})"));
+    }
+    {
+        // Simulate a crash part way through a write
+        std::ofstream partial(dir / "events.1", std::ios::app);
+        partial << R"(2 {"Id":)";
+    }
+
+    EventJournal journal(dir, 4096);
+    EXPECT_EQ(journal.lastEventId(), 1U);
+    EXPECT_TRUE(journal.append(2, R"({"Id":"2"})"));
+
+    bool found = false;
+    EXPECT_THAT(replay(journal, 1, found),
+                ElementsAre(Pair(2, R"({"Id":"2"})")));
+    EXPECT_TRUE(found);
+}
+
+} // namespace
+} // namespace redfish
@@ -1,4 +1,5 @@
 #include "event_log.hpp"
+#include "event_logs_object_type.hpp"
 
 #include <nlohmann/json.hpp>
 
@@ -187,5 +188,74 @@ TEST(RedfishEventLog, FormatEventLogEntryFail)
     ASSERT_EQ(status, -1);
 }
 
+TEST(RedfishEventLog, FormatEventLogEntriesSkipsInvalid)
+{
+    std::vector<EventLogObjectsType> eventRecords(2);
+    eventRecords[0].id = "1";
+    eventRecords[0].timestamp = "my-timestamp";
+    eventRecords[0].messageId = "OpenBMC.0.1.PowerSupplyFanFailed";
+    eventRecords[0].messageArgs = {"PSU 1", "FAN 2"};
+    eventRecords[1].id = "malformed";
+
+    std::vector<nlohmann::json> logEntries =
+        formatEventLogEntries(eventRecords);
+    ASSERT_EQ(logEntries.size(), 1);
+    EXPECT_EQ(logEntries[0]["MessageId"], "OpenBMC.0.5.PowerSupplyFanFailed");
+    EXPECT_EQ(logEntries[0]["Context"], "");
+}
+
+TEST(RedfishEventLog, FormatEventLogPayload)
+{
+    std::vector<nlohmann::json> logEntries = {
+        {{"MessageId", "OpenBMC.0.5.A"}, {"EventId", "0"}, {"Context", ""}},
+        {{"MessageId", "OpenBMC.0.5.B"}, {"EventId", "0"}, {"Context", ""}},
+        {{"MessageId", "OpenBMC.0.5.C"}, {"EventId", "0"}, {"Context", ""}},
+    };
+    std::vector<size_t> entryIndexes = {0, 2};
+
+    uint64_t eventId = 10;
+    nlohmann::json msg =
+        formatEventLogPayload(eventId, logEntries, entryIndexes, "myContext");
+    EXPECT_EQ(eventId, 12U);
+
+    EXPECT_EQ(msg["@odata.type"], "#Event.v1_4_0.Event");
+    EXPECT_EQ(msg["Id"], "12");
+    EXPECT_EQ(msg["Name"], "Event Log");
+    ASSERT_EQ(msg["Events"].size(), 2);
+    EXPECT_EQ(msg["Events"][0]["MessageId"], "OpenBMC.0.5.A");
+    EXPECT_EQ(msg["Events"][0]["EventId"], "10");
+    EXPECT_EQ(msg["Events"][0]["Context"], "myContext");
+    EXPECT_EQ(msg["Events"][1]["MessageId"], "OpenBMC.0.5.C");
+    EXPECT_EQ(msg["Events"][1]["EventId"], "11");
+
+    // The shared entries are left untouched
+    EXPECT_EQ(logEntries[0]["EventId"], "0");
+    EXPECT_EQ(logEntries[0]["Context"], "");
+}
+
+TEST(RedfishEventLog, MergeEventPayloads)
+{
+    std::vector<nlohmann::json::object_t> payloads(3);
+    payloads[0]["Id"] = "1";
+    payloads[0]["Events"] = nlohmann::json::array_t{
+        {{"MessageId", "A"}, {"MemberId", "0"}}};
+    payloads[1]["Id"] = "2";
+    payloads[2]["Id"] = "3";
+    payloads[2]["Events"] = nlohmann::json::array_t{
+        {{"MessageId", "B"}, {"MemberId", "0"}}, {{"MessageId", "C"}}};
+
+    nlohmann::json msg = mergeEventPayloads(payloads, 3);
+    EXPECT_EQ(msg["@odata.type"], "#Event.v1_4_0.Event");
+    EXPECT_EQ(msg["Id"], "3");
+    EXPECT_EQ(msg["Name"], "Event Log");
+    ASSERT_EQ(msg["Events"].size(), 3);
+    EXPECT_EQ(msg["Events"][0]["MessageId"], "A");
+    EXPECT_EQ(msg["Events"][0]["MemberId"], "0");
+    EXPECT_EQ(msg["Events"][1]["MessageId"], "B");
+    EXPECT_EQ(msg["Events"][1]["MemberId"], "1");
+    EXPECT_EQ(msg["Events"][2]["MessageId"], "C");
+    EXPECT_FALSE(msg["Events"][2].contains("MemberId"));
+}
+
 } // namespace
 } // namespace redfish::event_log
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "event_matches_filter.hpp"
+#include "event_service_store.hpp"
+#include "event_subscription_index.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <format>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace redfish
+{
+namespace
+{
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(EventSubscriptionIndex, NoFilters)
+{
+    EventSubscriptionIndex<int> index;
+    persistent_data::UserSubscription sub;
+    index.add("2", sub, 2);
+    index.add("1", sub, 1);
+
+    nlohmann::json::object_t event;
+    EXPECT_THAT(index.getCandidates(event, "Event"), ElementsAre(1, 2));
+
+    index.remove("1");
+    EXPECT_THAT(index.getCandidates(event, "Event"), ElementsAre(2));
+}
+
+TEST(EventSubscriptionIndex, RegistryPrefixes)
+{
+    EventSubscriptionIndex<int> index;
+    persistent_data::UserSubscription openbmc;
+    openbmc.registryPrefixes.emplace_back("OpenBMC");
+    index.add("1", openbmc, 1);
+    persistent_data::UserSubscription task;
+    task.registryPrefixes.emplace_back("Task");
+    index.add("2", task, 2);
+
+    nlohmann::json::object_t event;
+    event["MessageId"] = "OpenBMC.0.1.PostComplete";
+    EXPECT_THAT(index.getCandidates(event, ""), ElementsAre(1));
+
+    event["MessageId"] = "Base.1.0.Success";
+    EXPECT_THAT(index.getCandidates(event, ""), IsEmpty());
+
+    // Subscriptions without RegistryPrefixes are merged in by id
+    persistent_data::UserSubscription any;
+    index.add("0", any, 0);
+    index.add("3", any, 3);
+    event["MessageId"] = "OpenBMC.0.1.PostComplete";
+    EXPECT_THAT(index.getCandidates(event, ""), ElementsAre(0, 1, 3));
+
+    index.remove("1");
+    EXPECT_THAT(index.getCandidates(event, ""), ElementsAre(0, 3));
+}
+
+TEST(EventSubscriptionIndex, MostSelectiveFilter)
+{
+    EventSubscriptionIndex<int> index;
+    persistent_data::UserSubscription origin;
+    origin.originResources.emplace_back("/redfish/v1/Chassis/chassis");
+    index.add("2", origin, 2);
+    persistent_data::UserSubscription msgId;
+    msgId.registryMsgIds.emplace_back("OpenBMC.PostComplete");
+    index.add("1", msgId, 1);
+    persistent_data::UserSubscription any;
+    index.add("3", any, 3);
+
+    nlohmann::json::object_t event;
+    event["MessageId"] = "OpenBMC.0.1.PostComplete";
+    event["OriginOfCondition"] = "/redfish/v1/Chassis/chassis";
+
+    // Candidates are a superset of the subscriptions that match, merged in
+    // id order
+    std::vector<int> candidates = index.getCandidates(event, "");
+    EXPECT_THAT(candidates, ElementsAre(1, 2, 3));
+
+    event["OriginOfCondition"] = "/redfish/v1/Chassis/other";
+    candidates = index.getCandidates(event, "");
+    EXPECT_THAT(candidates, ElementsAre(1, 3));
+    EXPECT_TRUE(eventMatchesFilter(msgId, event, ""));
+}
+
+TEST(EventSubscriptionIndex, ManySubscribers)
+{
+    // Dispatch cost is proportional to the number of subscriptions that can
+    // match, not the total number of subscriptions
+    constexpr size_t numSubscriptions = 5000;
+    EventSubscriptionIndex<size_t> index;
+    std::vector<persistent_data::UserSubscription> subs(numSubscriptions);
+    for (size_t i = 0; i < numSubscriptions; i++)
+    {
+        subs[i].originResources.emplace_back(
+            std::format("/redfish/v1/Chassis/chassis{}", i));
+        index.add(std::format("{:05}", i), subs[i], i);
+    }
+
+    for (size_t i = 0; i < numSubscriptions; i += 499)
+    {
+        nlohmann::json::object_t event;
+        event["OriginOfCondition"] =
+            std::format("/redfish/v1/Chassis/chassis{}", i);
+        std::vector<size_t> candidates = index.getCandidates(event, "");
+        EXPECT_THAT(candidates, ElementsAre(i));
+        EXPECT_TRUE(eventMatchesFilter(subs[i], event, ""));
+    }
+}
+
+} // namespace
+} // namespace redfish
@@ -268,4 +268,54 @@ TEST(FilterParser, NestedProperty)
     filterFalse("Oem/OEM/ErrorId ne 'SWITCH_EC_STRAP_MISMATCH'", members);
 }
 
+static bool mayMatch(std::string_view filterExpr, const nlohmann::json& known)
+{
+    std::optional<filter_ast::LogicalAnd> ast = parseFilter(filterExpr);
+    EXPECT_TRUE(ast);
+    if (!ast)
+    {
+        return true;
+    }
+    return CompiledFilter(*ast).mayMatch(known);
+}
+
+TEST(CompiledFilter, MayMatchOnKnownProperties)
+{
+    nlohmann::json known;
+    known["Severity"] = "Critical";
+    known["Created"] = "2021-11-30T22:41:35+00:00";
+
+    EXPECT_TRUE(mayMatch("Severity eq 'Critical'", known));
+    EXPECT_FALSE(mayMatch("Severity eq 'OK'", known));
+    EXPECT_FALSE(mayMatch("not (Severity eq 'Critical')", known));
+    EXPECT_TRUE(mayMatch("Created gt '2021-11-30T00:00:00+00:00'", known));
+    EXPECT_FALSE(mayMatch("Created lt '2021-11-30T00:00:00+00:00'", known));
+
+    // Properties that aren't known can't rule a member out
+    EXPECT_TRUE(mayMatch("Message eq 'foo'", known));
+    EXPECT_TRUE(mayMatch("not (Message eq 'foo')", known));
+    EXPECT_TRUE(mayMatch("Severity eq 'Critical' and Message eq 'foo'", known));
+    EXPECT_FALSE(mayMatch("Severity eq 'OK' and Message eq 'foo'", known));
+    EXPECT_TRUE(mayMatch("Severity eq 'OK' or Message eq 'foo'", known));
+    EXPECT_TRUE(mayMatch("Severity eq 'Critical' or Message eq 'foo'", known));
+}
+
+TEST(CompiledFilter, MatchesSameAsCollectionFilter)
+{
+    const nlohmann::json member =
+        R"({"Severity": "Warning", "Id": 5, "Reading": 3.5})"_json;
+    std::optional<filter_ast::LogicalAnd> ast =
+        parseFilter("(Severity eq 'OK' or Id gt 4) and Reading lt 4.0");
+    ASSERT_TRUE(ast);
+    CompiledFilter filter(*ast);
+    EXPECT_TRUE(filter.matches(member));
+    EXPECT_TRUE(memberMatches(member, filter));
+
+    ast = parseFilter("Severity eq 'OK' or Id gt 5");
+    ASSERT_TRUE(ast);
+    filter = CompiledFilter(*ast);
+    EXPECT_FALSE(filter.matches(member));
+    EXPECT_FALSE(memberMatches(member, filter));
+}
+
 } // namespace redfish
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright OpenBMC Authors
+#include "event_service_store.hpp"
+#include "filter_expr_parser_ast.hpp"
+#include "filter_expr_printer.hpp"
+#include "subscription.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/url/url.hpp>
+#include <nlohmann/json.hpp>
+
+#include <memory>
+#include <optional>
+
+#include <gtest/gtest.h>
+
+namespace redfish
+{
+namespace
+{
+
+TEST(Subscription, EventLogFilterSeesEventIdAndContext)
+{
+    boost::asio::io_context io;
+    auto userSub = std::make_shared<persistent_data::UserSubscription>();
+    userSub->customText = "rack1";
+    auto sub = std::make_shared<Subscription>(
+        userSub, boost::urls::url("https://192.168.1.1/events"), io);
+
+    nlohmann::json logEntry;
+    logEntry["MessageId"] = "OpenBMC.0.1.PowerButtonPressed";
+
+    EXPECT_TRUE(sub->eventLogMatchesFilter(logEntry, 5));
+
+    std::optional<filter_ast::LogicalAnd> ast =
+        parseFilter("Context eq 'rack1'");
+    ASSERT_TRUE(ast);
+    sub->filter.emplace(*ast);
+    EXPECT_TRUE(sub->eventLogMatchesFilter(logEntry, 5));
+    userSub->customText = "rack2";
+    EXPECT_FALSE(sub->eventLogMatchesFilter(logEntry, 5));
+
+    ast = parseFilter("EventId eq '5'");
+    ASSERT_TRUE(ast);
+    sub->filter.emplace(*ast);
+    EXPECT_TRUE(sub->eventLogMatchesFilter(logEntry, 5));
+    EXPECT_FALSE(sub->eventLogMatchesFilter(logEntry, 6));
+
+    // The shared entry isn't changed
+    EXPECT_FALSE(logEntry.contains("EventId"));
+    EXPECT_FALSE(logEntry.contains("Context"));
+}
+
+TEST(Subscription, DeliveryStatsCountSentEvents)
+{
+    boost::asio::io_context io;
+    auto userSub = std::make_shared<persistent_data::UserSubscription>();
+    auto sub = std::make_shared<Subscription>(
+        userSub, boost::urls::url("https://192.168.1.1/events"), io);
+
+    EXPECT_EQ(sub->getDeliveryStats().eventsQueued, 0U);
+    EXPECT_EQ(sub->getDeliveryStats().payloadsSent, 0U);
+
+    EXPECT_TRUE(sub->sendEventToSubscriber(1, "{}"));
+    EXPECT_TRUE(sub->sendEventToSubscriber(2, "{}"));
+    EXPECT_EQ(sub->getDeliveryStats().eventsQueued, 2U);
+    EXPECT_EQ(sub->getDeliveryStats().payloadsSent, 2U);
+    EXPECT_EQ(sub->getDeliveryStats().eventsDropped, 0U);
+}
+
+} // namespace
+} // namespace redfish
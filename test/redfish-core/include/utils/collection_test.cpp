@@ -8,7 +8,10 @@
 #include <boost/url/url.hpp>
 #include <nlohmann/json.hpp>
 
+#include <cstddef>
+#include <format>
 #include <memory>
+#include <optional>
 
 #include <gtest/gtest.h>
 
@@ -158,5 +161,72 @@ TEST(CollectionUtil, HandleCollectionMembersSkipsObjectsWithEmptyLeaf)
     EXPECT_EQ(asyncResp->res.jsonValue["Members@odata.count"], 1);
 }
 
+TEST(CollectionUtil, HandleCollectionMembersPageBuildsOnlyWindow)
+{
+    auto asyncResp = std::make_shared<bmcweb::AsyncResp>();
+    dbus::utility::MapperGetSubTreePathsResponse objects;
+    for (size_t i = 12; i > 0; i--)
+    {
+        objects.emplace_back(
+            std::format("/xyz/openbmc_project/inventory/dimm{}", i));
+    }
+
+    handleCollectionMembersPage(
+        asyncResp, boost::urls::url("/redfish/v1/Systems/system/Memory"),
+        nlohmann::json::json_pointer("/Members"), 8, 3, {}, objects);
+
+    const nlohmann::json& members = asyncResp->res.jsonValue["Members"];
+    ASSERT_TRUE(members.is_array());
+    ASSERT_EQ(members.size(), 3);
+    EXPECT_EQ(members[0]["@odata.id"],
+              "/redfish/v1/Systems/system/Memory/dimm9");
+    EXPECT_EQ(members[1]["@odata.id"],
+              "/redfish/v1/Systems/system/Memory/dimm10");
+    EXPECT_EQ(members[2]["@odata.id"],
+              "/redfish/v1/Systems/system/Memory/dimm11");
+    EXPECT_EQ(asyncResp->res.jsonValue["Members@odata.count"], 12);
+}
+
+TEST(CollectionUtil, HandleCollectionMembersPageSkipPastEnd)
+{
+    auto asyncResp = std::make_shared<bmcweb::AsyncResp>();
+    dbus::utility::MapperGetSubTreePathsResponse objects = {
+        "/xyz/openbmc_project/inventory/dimm0",
+        "/xyz/openbmc_project/inventory/dimm1",
+    };
+
+    handleCollectionMembersPage(
+        asyncResp, boost::urls::url("/redfish/v1/Systems/system/Memory"),
+        nlohmann::json::json_pointer("/Members"), 5, std::nullopt, {},
+        objects);
+
+    const nlohmann::json& members = asyncResp->res.jsonValue["Members"];
+    ASSERT_TRUE(members.is_array());
+    EXPECT_TRUE(members.empty());
+    EXPECT_EQ(asyncResp->res.jsonValue["Members@odata.count"], 2);
+}
+
+TEST(CollectionUtil, HandleCollectionMembersPageSortsInExistingMembers)
+{
+    auto asyncResp = std::make_shared<bmcweb::AsyncResp>();
+    asyncResp->res.jsonValue["Members"] = nlohmann::json::array(
+        {{{"@odata.id", "/redfish/v1/Systems/system/Memory/dimm1"}}});
+    dbus::utility::MapperGetSubTreePathsResponse objects = {
+        "/xyz/openbmc_project/inventory/dimm2",
+        "/xyz/openbmc_project/inventory/dimm0",
+    };
+
+    handleCollectionMembersPage(
+        asyncResp, boost::urls::url("/redfish/v1/Systems/system/Memory"),
+        nlohmann::json::json_pointer("/Members"), 1, 1, {}, objects);
+
+    const nlohmann::json& members = asyncResp->res.jsonValue["Members"];
+    ASSERT_TRUE(members.is_array());
+    ASSERT_EQ(members.size(), 1);
+    EXPECT_EQ(members[0]["@odata.id"],
+              "/redfish/v1/Systems/system/Memory/dimm1");
+    EXPECT_EQ(asyncResp->res.jsonValue["Members@odata.count"], 3);
+}
+
 } // namespace
 } // namespace redfish::collection_util
@@ -2,6 +2,7 @@
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #include "bmcweb_config.h"
 
+#include "async_resp.hpp"
 #include "http_response.hpp"
 #include "utils/query_param.hpp"
 
@@ -11,6 +12,7 @@
 #include <boost/url/url_view.hpp>
 #include <nlohmann/json.hpp>
 
+#include <memory>
 #include <optional>
 #include <span>
 #include <string>
@@ -126,6 +128,23 @@ TEST(Delegate, SkipPositive)
     EXPECT_EQ(query.skip, 0);
 }
 
+TEST(Delegate, FilterPushedDownIsKept)
+{
+    Query query;
+    ASSERT_TRUE(getFilterParam("Severity eq 'OK'", query));
+    Query delegated = delegate(QueryCapabilities{}, query);
+    EXPECT_FALSE(delegated.filter);
+    EXPECT_TRUE(query.filter);
+
+    QueryCapabilities capabilities{
+        .canPushDownFilter = true,
+    };
+    delegated = delegate(capabilities, query);
+    EXPECT_TRUE(delegated.filter);
+    // The response is still filtered after the handler
+    EXPECT_TRUE(query.filter);
+}
+
 TEST(FormatQueryForExpand, NoSubQueryWhenQueryIsEmpty)
 {
     EXPECT_EQ(formatQueryForExpand(Query{}), "");
@@ -230,6 +249,29 @@ TEST(GetSelectParam, TrieNodesRespectAllProperties)
     EXPECT_TRUE(query.selectTrie.root.find("bar")->isSelected());
 }
 
+TEST(IsSelected, EverythingIsSelectedWithoutSelect)
+{
+    bmcweb::AsyncResp asyncResp;
+    EXPECT_TRUE(isSelected(asyncResp, {"Status"}));
+    EXPECT_TRUE(isSelected(asyncResp, {"Boot", "BootProgress"}));
+}
+
+TEST(IsSelected, OnlySelectedTopLevelPropertiesAreSelected)
+{
+    Query query;
+    ASSERT_TRUE(getSelectParam("Status,Boot/BootSourceOverrideTarget", query));
+    bmcweb::AsyncResp asyncResp;
+    asyncResp.selectTrie =
+        std::make_shared<SelectTrieNode>(query.selectTrie.root);
+
+    EXPECT_TRUE(isSelected(asyncResp, {"Status"}));
+    EXPECT_TRUE(isSelected(asyncResp, {"PowerState", "Status"}));
+    EXPECT_TRUE(isSelected(asyncResp, {"Boot"}));
+    EXPECT_FALSE(isSelected(asyncResp, {"PowerState"}));
+    EXPECT_FALSE(isSelected(asyncResp, {"BootProgress", "LastResetTime"}));
+    EXPECT_FALSE(isSelected(asyncResp, {"BootSourceOverrideTarget"}));
+}
+
 SelectTrie getTrie(std::span<std::string_view> properties)
 {
     SelectTrie trie;
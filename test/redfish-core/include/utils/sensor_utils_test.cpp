@@ -9,6 +9,7 @@
 #include "utils/sensor_utils.hpp"
 
 #include <cmath>
+#include <format>
 #include <functional>
 #include <optional>
 #include <string>
@@ -744,5 +745,74 @@ TEST(GetFanPercent, Fail)
     percentValue.reset();
 }
 
+TEST(InventoryItems, AddAndFind)
+{
+    InventoryItems items;
+    items.add("/xyz/openbmc_project/inventory/system/chassis/psu0",
+              "/xyz/openbmc_project/sensors/power/psu0_input");
+    items.add("/xyz/openbmc_project/inventory/system/chassis/psu0",
+              "/xyz/openbmc_project/sensors/power/psu0_output");
+    items.add("/xyz/openbmc_project/inventory/system/chassis/psu1",
+              "/xyz/openbmc_project/sensors/power/psu1_input");
+    ASSERT_EQ(items.size(), 2U);
+
+    InventoryItem* psu0 =
+        items.find("/xyz/openbmc_project/inventory/system/chassis/psu0");
+    ASSERT_NE(psu0, nullptr);
+    EXPECT_EQ(psu0->name, "psu0");
+    EXPECT_EQ(psu0->sensors.size(), 2U);
+    EXPECT_EQ(
+        items.findForSensor("/xyz/openbmc_project/sensors/power/psu0_output"),
+        psu0);
+    EXPECT_EQ(items.findForSensor("/xyz/openbmc_project/sensors/power/foo"),
+              nullptr);
+    EXPECT_EQ(items.find("/xyz/openbmc_project/inventory/system/chassis"),
+              nullptr);
+
+    items.setLedObjectPath("/xyz/openbmc_project/inventory/system/chassis/psu0",
+                           "/xyz/openbmc_project/led/physical/psu0");
+    EXPECT_EQ(psu0->ledObjectPath, "/xyz/openbmc_project/led/physical/psu0");
+    EXPECT_EQ(items.findForLed("/xyz/openbmc_project/led/physical/psu0"),
+              psu0);
+    EXPECT_EQ(items.findForLed("/xyz/openbmc_project/led/physical/psu1"),
+              nullptr);
+
+    // Unknown inventory items are ignored
+    items.setLedObjectPath("/xyz/openbmc_project/inventory/system/chassis/psu2",
+                           "/xyz/openbmc_project/led/physical/psu2");
+    EXPECT_EQ(items.findForLed("/xyz/openbmc_project/led/physical/psu2"),
+              nullptr);
+}
+
+TEST(InventoryItems, LargeChassis)
+{
+    // Synthetic chassis with 1000 sensors spread over 100 inventory items
+    constexpr size_t numSensors = 1000;
+    constexpr size_t sensorsPerItem = 10;
+    InventoryItems items;
+    for (size_t i = 0; i < numSensors; i++)
+    {
+        std::string invPath = std::format(
+            "/xyz/openbmc_project/inventory/system/chassis/item{}",
+            i / sensorsPerItem);
+        std::string sensorPath =
+            std::format("/xyz/openbmc_project/sensors/temperature/t{}", i);
+        items.add(invPath, sensorPath);
+        items.setLedObjectPath(
+            invPath, std::format("/xyz/openbmc_project/led/physical/led{}",
+                                 i / sensorsPerItem));
+    }
+    ASSERT_EQ(items.size(), numSensors / sensorsPerItem);
+
+    for (size_t i = 0; i < numSensors; i++)
+    {
+        InventoryItem* item = items.findForSensor(
+            std::format("/xyz/openbmc_project/sensors/temperature/t{}", i));
+        ASSERT_NE(item, nullptr);
+        EXPECT_EQ(item->name, std::format("item{}", i / sensorsPerItem));
+        EXPECT_EQ(items.findForLed(item->ledObjectPath), item);
+    }
+}
+
 } // namespace
 } // namespace redfish::sensor_utils
@@ -1,11 +1,21 @@
 // SPDX-License-Identifier: Apache-2.0
 // SPDX-FileCopyrightText: Copyright OpenBMC Authors
 #include "duplicatable_file_handle.hpp"
+#include "http_request.hpp"
+#include "http_response.hpp"
 #include "metadata.hpp"
+#include "metadata_document.hpp"
+
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/status.hpp>
+#include <boost/beast/http/verb.hpp>
 
 #include <filesystem>
 #include <format>
+#include <string>
 #include <string_view>
+#include <system_error>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -51,5 +61,82 @@ TEST(MetadataGet, GetOneFile)
     EXPECT_EQ(getMetadataPieceForFile("DoesNotExist_v1.xml"), "");
 }
 
+TEST(MetadataGet, PrecomputedSchemaSet)
+{
+    std::vector<std::string> files(metadata::schemaFiles.rbegin(),
+                                   metadata::schemaFiles.rend());
+    EXPECT_TRUE(isPrecomputedSchemaSet(files));
+
+    // An OEM schema added after the build
+    files.emplace_back("OemAddedLater_v1.xml");
+    EXPECT_FALSE(isPrecomputedSchemaSet(files));
+
+    files.pop_back();
+    files.pop_back();
+    EXPECT_FALSE(isPrecomputedSchemaSet(files));
+}
+
+TEST(MetadataGet, PrecomputedDocument)
+{
+    EXPECT_TRUE(metadata::document.starts_with("<?xml"));
+    EXPECT_TRUE(metadata::document.ends_with("</edmx:Edmx>\n"));
+    for (std::string_view file : metadata::schemaFiles)
+    {
+        EXPECT_NE(metadata::document.find(std::format(
+                      "<edmx:Reference Uri=\"/redfish/v1/schema/{}\">", file)),
+                  std::string_view::npos);
+    }
+    EXPECT_TRUE(metadata::gzip.starts_with("\x1f\x8b"));
+}
+
+TEST(MetadataGet, WritePrecomputedMetadata)
+{
+    std::error_code ec;
+    crow::Request req{{boost::beast::http::verb::get, "/redfish/v1/$metadata",
+                       11},
+                      ec};
+    req.addHeader(boost::beast::http::field::accept_encoding, "gzip");
+
+    crow::Response res;
+    writePrecomputedMetadata(req, res);
+    EXPECT_EQ(res.getHeaderValue(boost::beast::http::field::etag),
+              metadata::etag);
+    EXPECT_EQ(res.getHeaderValue(boost::beast::http::field::content_encoding),
+              "gzip");
+    EXPECT_EQ(*res.body(), metadata::gzip);
+
+    req.addHeader(boost::beast::http::field::if_none_match, metadata::etag);
+    crow::Response notModified;
+    writePrecomputedMetadata(req, notModified);
+    EXPECT_EQ(notModified.result(), boost::beast::http::status::not_modified);
+    EXPECT_TRUE(notModified.body()->empty());
+}
+
+TEST(MetadataGet, WritePrecomputedMetadataZstd)
+{
+    std::error_code ec;
+    crow::Request req{{boost::beast::http::verb::get, "/redfish/v1/$metadata",
+                       11},
+                      ec};
+    req.addHeader(boost::beast::http::field::accept_encoding, "zstd, gzip");
+
+    crow::Response res;
+    writePrecomputedMetadata(req, res);
+#ifdef HAVE_ZSTD
+    if (!metadata::zstd.empty())
+    {
+        EXPECT_EQ(
+            res.getHeaderValue(boost::beast::http::field::content_encoding),
+            "zstd");
+        EXPECT_EQ(*res.body(), metadata::zstd);
+        return;
+    }
+#endif
+    // zstd is only offered when bmcweb can handle it
+    EXPECT_EQ(res.getHeaderValue(boost::beast::http::field::content_encoding),
+              "gzip");
+    EXPECT_EQ(*res.body(), metadata::gzip);
+}
+
 } // namespace
 } // namespace redfish